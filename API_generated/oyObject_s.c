@@ -108,7 +108,7 @@ oyObject_NewWithAllocators  ( oyAlloc_f         allocateFunc,
     return o;
 #endif
 
-  o->id_ = oy_object_id_++;
+  o->id_ = oyAtomicInc_m( &oy_object_id_ ) - 1;
   o->type_ = oyOBJECT_OBJECT_S;
   o->version_ = oyVersion(0);
   o->hash_ptr_ = 0;
@@ -442,7 +442,12 @@ int          oyObject_Lock             ( oyObject_s        object,
       return 0;
 
     if(!object->lock_)
-      object->lock_ = oyStruct_LockCreateFunc_( object->parent_ );
+    {
+      /* two threads might create a lock at the same time, one wins */
+      oyPointer lock = oyStruct_LockCreateFunc_( object->parent_ );
+      if(!oyAtomicCasPtr_m( &object->lock_, 0, lock ))
+        oyLockReleaseFunc_( lock, marker, line );
+    }
 
     oyLockFunc_( object->lock_, marker, line );
   }
@@ -538,8 +543,12 @@ int            oyObject_GetRefCount  ( oyObject_s          obj )
  *  @memberof oyObject_s
  *  @brief   decrease the ref counter and return the above zero ref value
  *
- *  @version Oyranos: 0.1.8
- *  @date    2008/02/07
+ *  The counter is changed atomically without taking the object lock.
+ *  Only the caller which brings the counter to zero gets a zero return
+ *  and owns the object for destruction.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @date    2011/11/02
  *  @since   2008/02/07 (Oyranos: 0.1.8)
  */
 int          oyObject_UnRef          ( oyObject_s          obj )
@@ -553,22 +562,27 @@ int          oyObject_UnRef          ( oyObject_s          obj )
 
   if(error <= 0)
   {
+#if !defined(OY_HAVE_ATOMIC_INT)
     oyObject_Lock( s, __FILE__, __LINE__ );
+#endif
 
-    if(s->ref_ < 0)
-      ref = 0;
+    ref = oyAtomicDec_m( &s->ref_ );
 
-    if(error <= 0 && --s->ref_ > 0)
-      ref = s->ref_;
+#if !defined(OY_HAVE_ATOMIC_INT)
+    oyObject_UnLock( s, __FILE__, __LINE__ );
+#endif
 
 #   ifndef DEBUG_OBJECT
-    if(s->ref_ < -1)
+    if(ref < -1)
 #   else
     if(s->id_ == 247)
 #   endif
       WARNc3_S( "%s ID: %d refs: %d",
                 oyStructTypeToText( s->parent_types_[s->parent_types_[0]] ),
-                s->id_, s->ref_ )
+                s->id_, ref )
+
+    if(ref < 0)
+      ref = 0;
 
     if((uintptr_t)obj->parent_types_ < (uintptr_t)oyOBJECT_MAX)
     {
@@ -576,15 +590,6 @@ int          oyObject_UnRef          ( oyObject_s          obj )
                 oyStruct_GetInfo(obj,0) );
       return -1;
     }
-
-    if(obj->parent_types_[obj->parent_types_[0]] == oyOBJECT_NAMED_COLOURS_S)
-    {
-      int e_a = error;
-      error = pow(e_a,2.1);
-      error = e_a;
-    }
-
-    oyObject_UnLock( s, __FILE__, __LINE__ );
   }
 
   return ref;
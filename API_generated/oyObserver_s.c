@@ -145,9 +145,9 @@ OYAPI int  OYEXPORT
  *  @param[in]     signal_data         advanced informations
  *  @return                            0 - not matching; 1 - match, skip others
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2009/10/26 (Oyranos: 0.1.10)
- *  @date    2010/04/07
+ *  @date    2011/11/28
  */
 OYAPI int  OYEXPORT
            oyObserver_SignalSend     ( oyObserver_s      * observer,
@@ -156,14 +156,25 @@ OYAPI int  OYEXPORT
 {
   oyObserver_s * s = observer;
   int result = 0;
+  uint32_t flags = oyObserverFlagsGet();
 
   oyCheckType__m( oyOBJECT_OBSERVER_S, return 0 )
 
      /* global signal disabling */
-  if(!oyToSignalBlock_m( oyObserverFlagsGet() ) &&
+  if(!oyToSignalBlock_m( flags ) &&
      /* local signal disabling */
      !observer->disable_ref )
-    result = observer->signal( observer, signal_type, signal_data );
+  {
+    if(oyToSignalCount_m( flags ))
+    {
+      double clck = oyClock();
+      result = observer->signal( observer, signal_type, signal_data );
+      /* whole micro seconds, to be summed up atomically */
+      oyObserverCount_m( time, (long)(oyClock() - clck + 0.5) );
+      oyObserverCount_m( sent, 1 );
+    } else
+      result = observer->signal( observer, signal_type, signal_data );
+  }
 
   return result;
 }
@@ -301,15 +312,18 @@ OYAPI int  OYEXPORT
  *  @memberof oyObserver_s
  *  @brief   send a signal to all ovservers of a model
  *
+ *  Inside oyObserverBatchBegin() and oyObserverBatchEnd() the signals are
+ *  held back and sent only once per observer and signal type.
+ *
  *  @param[in]     model               the model
  *  @param[in]     signal_type         the basic signal type to emit
  *  @param[in,out] signal_data         the advanced signal information
  *  @return                            0 - no handler found; 1 - handler found;
  *                                     < 0 error or issue
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2009/10/27 (Oyranos: 0.1.10)
- *  @date    2009/10/27
+ *  @date    2011/11/28
  */
 OYAPI int  OYEXPORT
            oyStruct_ObserverSignal   ( oyStruct_s        * model,
@@ -325,6 +339,9 @@ OYAPI int  OYEXPORT
   if(oyToSignalBlock_m( oyObserverFlagsGet() ))
     return 0;
 
+  if(oyToSignalCount_m( oyObserverFlagsGet() ))
+    oyObserverCount_m( signals, 1 );
+
   if(!error)
     o = oyOptions_Find( model->oy_->handles_,
                         OY_SIGNAL_OBSERVERS );
@@ -353,7 +370,8 @@ OYAPI int  OYEXPORT
                     oyStruct_GetText( obs->observer, oyNAME_NAME, 1),
                     oyObject_GetId(   obs->observer->oy_) );
           }
-          t_err = oyObserver_SignalSend( obs, signal_type, signal_data );
+          if(!oyObserverBatchAdd_( obs, signal_type, signal_data ))
+            t_err = oyObserver_SignalSend( obs, signal_type, signal_data );
           ++result;
         }
         else
@@ -787,4 +805,70 @@ OYAPI int  OYEXPORT
   oy_observer_flags = flags;
   return 0;
 }
+
+/** Function oyObserverBatchBegin
+ *  @memberof oyObserver_s
+ *  @brief   hold back signals of the calling thread
+ *
+ *  Signals from oyStruct_ObserverSignal() are collected until the outermost
+ *  oyObserverBatchEnd(). A signal to the same observer with the same model
+ *  and signal type is sent only once. Use this around many changes to
+ *  observed objects, like setting up a graph.
+ *
+ *  @verbatim
+    oyObserverBatchBegin();
+    oyOptions_SetFromText( &opts, ... ); // many changes
+    oyObserverBatchEnd();                // the observers are signalled here
+    @endverbatim
+ *
+ *  @return                            the batch depth
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/28 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+OYAPI int  OYEXPORT
+           oyObserverBatchBegin      ( void )
+{
+  return oyObserverBatchBegin_();
+}
+
+/** Function oyObserverBatchEnd
+ *  @memberof oyObserver_s
+ *  @brief   send the held back signals
+ *
+ *  Closing the outermost batch sends the collected signals. Signals caused
+ *  by the observers meanwhile are coalesced and sent as well.
+ *
+ *  @return                            the remaining batch depth
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/28 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+OYAPI int  OYEXPORT
+           oyObserverBatchEnd        ( void )
+{
+  return oyObserverBatchEnd_();
+}
+
+/** Function oyObserverCountsGet
+ *  @memberof oyObserver_s
+ *  @brief   get the signal counters for profiling
+ *
+ *  The counters are filled while OY_SIGNAL_COUNT is set with
+ *  oyObserverFlagsSet().
+ *
+ *  @param[out]    counts              the process wide counters
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/28 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+OYAPI void OYEXPORT
+           oyObserverCountsGet       ( oyObserverCounts_s* counts )
+{
+  if(counts)
+    *counts = oy_observer_counts_;
+}
 /* } oyObserver_s object specific functions */
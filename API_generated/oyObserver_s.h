@@ -32,6 +32,8 @@
 
 #define OY_SIGNAL_BLOCK                0x01 /**< do not send new signals */
 #define oyToSignalBlock_m(r)           ((r)&1)
+#define OY_SIGNAL_COUNT                0x02 /**< fill oyObserverCounts_s */
+#define oyToSignalCount_m(r)           (((r) >> 1)&1)
 #define OY_SIGNAL_OBSERVERS OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL OY_SLASH OY_TYPE_STD OY_SLASH "oyStructList_s/observers"
 /*  The models list of a observing object is just a clone of the oyObserver_s
  *  object added to the model. */
@@ -70,6 +72,19 @@ typedef  int      (*oyObserver_Signal_f) (
                                        oySIGNAL_e          signal_type,
                                        oyStruct_s        * signal_data );
 
+/** @brief   signal counters, filled while OY_SIGNAL_COUNT is set
+ *  @ingroup objects_generic
+ *
+ *  @see oyObserverFlagsSet() oyObserverCountsGet()
+ */
+typedef struct {
+  long                 signals;        /**< oyStruct_ObserverSignal() calls */
+  long                 queued;         /**< held back inside a batch */
+  long                 coalesced;      /**< dropped as duplicate in a batch */
+  long                 sent;           /**< oyObserver_SignalSend() calls */
+  long                 time;           /**< micro seconds spent in sending */
+} oyObserverCounts_s;
+
 
 /* Include "Observer.dox" { */
 /** @struct   oyObserver_s
@@ -172,6 +187,12 @@ OYAPI uint32_t OYEXPORT
            oyObserverFlagsGet        ( void );
 OYAPI int  OYEXPORT
            oyObserverFlagsSet        ( uint32_t            flags );
+OYAPI int  OYEXPORT
+           oyObserverBatchBegin      ( void );
+OYAPI int  OYEXPORT
+           oyObserverBatchEnd        ( void );
+OYAPI void OYEXPORT
+           oyObserverCountsGet       ( oyObserverCounts_s* counts );
 /* } oyObserver_s object specific functions */
 
 #ifdef __cplusplus
@@ -37,4 +37,20 @@ int        oyStruct_ObserverRemove_  ( oyStructList_s    * list,
                                        oyStruct_s        * obj,
                                        int                 observer,
                                        oyObserver_Signal_f signalFunc );
+int        oyObserverBatchAdd_       ( oyObserver_s      * obs,
+                                       oySIGNAL_e          signal_type,
+                                       oyStruct_s        * signal_data );
+int        oyObserverBatchBegin_     ( void );
+int        oyObserverBatchEnd_       ( void );
+
+extern oyObserverCounts_s oy_observer_counts_;
+/* all counters are integers for atomic updates; without GCC atomics
+ * concurrent senders may lose counts */
+#if defined(__GNUC__)
+#define oyObserverCount_m( counter, n ) \
+  __sync_add_and_fetch( &oy_observer_counts_.counter, n )
+#else
+#define oyObserverCount_m( counter, n ) oy_observer_counts_.counter += n
+#endif
+
 #endif /* OY_OBSERVER_S__H */
@@ -484,8 +484,6 @@ int            oyOption_SetFromDouble( oyOption_s        * obj,
   {
     if(s->value && 0 /*flags & OY_CLEAR*/)
     {
-      oyDeAlloc_f deallocateFunc = s->oy_->deallocateFunc_;
-
       if(s->value_type == oyVAL_DOUBLE && s->value)
         if(s->value->dbl == floating_point)
           return error;
@@ -495,14 +493,12 @@ int            oyOption_SetFromDouble( oyOption_s        * obj,
            s->value->dbl_list[1 + pos] == floating_point)
           return error;
 
-      oyValueRelease( &s->value, s->value_type, deallocateFunc );
+      oyOption_ValueRelease_( s );
     }
 
     if(!s->value)
     {
-      oyAllocHelper_m_( s->value, oyValue_u, 1,
-                        s->oy_->allocateFunc_,
-                        error = 1 );
+      oyOption_ValueNew_( s );
       if(pos == 0 &&
          s->value_type != oyVAL_DOUBLE_LIST)
         s->value_type = oyVAL_DOUBLE;
@@ -613,14 +609,15 @@ int            oyOption_Clear        ( oyOption_s        * obj )
 
   if(s->oy_->deallocateFunc_)
   {
-    oyDeAlloc_f deallocateFunc = s->oy_->deallocateFunc_;
-
-    oyValueRelease( &s->value, s->value_type, deallocateFunc );
+    oyOption_ValueRelease_( s );
 
     s->value_type = 0;
 
     if(s->registration)
-      deallocateFunc( s->registration );
+    {
+      oyAtomicInc_m( &oy_option_registrations_ );
+      oyStringInternRelease_( s->registration );
+    }
     s->registration = 0;
   }
 
@@ -646,8 +643,6 @@ int            oyOption_SetFromData  ( oyOption_s        * option,
                                        oyPointer           ptr,
                                        size_t              size )
 {
-  oyAlloc_f allocateFunc_ = oyAllocateFunc_;
-  oyDeAlloc_f deallocateFunc_ = oyDeAllocateFunc_;
   int error = !option;
   oyOption_s_ * s = (oyOption_s_*)option;
 
@@ -658,12 +653,6 @@ int            oyOption_SetFromData  ( oyOption_s        * option,
 
   if(error <= 0)
   {
-    if(s->oy_)
-    {
-      allocateFunc_ = s->oy_->allocateFunc_;
-      deallocateFunc_ = s->oy_->deallocateFunc_;
-    }
-
     if((s->value && s->value_type == oyVAL_STRUCT &&
          (((s->value->oy_struct->type_ == oyOBJECT_BLOB_S &&
            ((oyBlob_s_*)(s->value->oy_struct))->ptr == ptr)) ||
@@ -671,12 +660,8 @@ int            oyOption_SetFromData  ( oyOption_s        * option,
            oyPointer_GetPointer((oyPointer_s*)(s->value->oy_struct)) == ptr))))
       return error;
 
-    oyValueClear( s->value, s->value_type, deallocateFunc_ );
-    if(!s->value)
-      s->value = allocateFunc_(sizeof(oyValue_u));
-    error = !s->value;
-    if(!error)
-      memset( s->value, 0, sizeof(oyValue_u) );
+    oyOption_ValueRelease_( s );
+    oyOption_ValueNew_( s );
   }
 
   if(error <= 0)
@@ -792,8 +777,15 @@ int            oyOption_SetRegistration (
   oyCheckType__m( oyOBJECT_OPTION_S, return 1 )
 
   if(registration)
-    s->registration = oyStringCopy_( registration,
-                                     s->oy_->allocateFunc_ );
+  {
+    /* run time generated keys are freed with their last option */
+    registration = oyStringInternCopy_( registration );
+    /* invalidate oyOptions_s indices; a new option is not yet listed */
+    if(s->registration && s->registration != registration)
+      oyAtomicInc_m( &oy_option_registrations_ );
+    oyStringInternRelease_( s->registration );
+    s->registration = registration;
+  }
 
   return error;
 }
@@ -65,11 +65,15 @@ void oyOption_Release__Members( oyOption_s_ * option )
      * E.g.: deallocateFunc( option->member );
      */
 
+    /* a released option is in no list, skip the change count */
+    oyStringInternRelease_( option->registration );
+    option->registration = 0;
     oyOption_Clear( (oyOption_s*) option );
   }
 }
 
 static int oy_option_id_ = 0;
+uint32_t oy_option_registrations_ = 0;
 
 /** Function    oyOption_Init__Members
  *  @memberof   oyOption_s
@@ -134,10 +138,9 @@ int oyOption_Copy__Members( oyOption_s_ * dst, oyOption_s_ * src)
    error = oyOption_Clear( (oyOption_s*)dst );
    oyStruct_EnableSignalSend( (oyStruct_s*)dst );
 
-   dst->registration = oyStringCopy_( src->registration, allocateFunc_ );
+   dst->registration = oyStringInternCopy_( src->registration );
    dst->value_type = src->value_type;
-   dst->value = allocateFunc_(sizeof(oyValue_u));
-   memset(dst->value, 0, sizeof(oyValue_u));
+   oyOption_ValueNew_( dst );
    oyValueCopy( dst->value, src->value, dst->value_type,
                 allocateFunc_, deallocateFunc_ );
    dst->source = src->source;
@@ -451,8 +454,6 @@ int            oyOption_SetFromText_ ( oyOption_s_       * obj,
 
     if(obj->value)
     {
-      oyDeAlloc_f deallocateFunc = obj->oy_->deallocateFunc_;
-
       if( text )
       {
         int j = 0;
@@ -472,11 +473,10 @@ int            oyOption_SetFromText_ ( oyOption_s_       * obj,
         }
 
       }
-      oyValueRelease( &obj->value, obj->value_type, deallocateFunc );
+      oyOption_ValueRelease_( obj );
     }
 
-    obj->value = obj->oy_->allocateFunc_(sizeof(oyValue_u));
-    memset( obj->value, 0, sizeof(oyValue_u) );
+    oyOption_ValueNew_( obj );
 
     if(oyToStringList_m(flags))
     {
@@ -661,8 +661,6 @@ int            oyOption_SetFromInt_  ( oyOption_s_       * obj,
   {
     if(s->value && 0 /*flags & OY_CLEAR*/)
     {
-      oyDeAlloc_f deallocateFunc = s->oy_->deallocateFunc_;
-
       if(s->value_type == oyVAL_INT && obj->value)
         if(s->value->int32 == integer)
           return error;
@@ -672,14 +670,12 @@ int            oyOption_SetFromInt_  ( oyOption_s_       * obj,
            s->value->int32_list[1 + pos] == integer)
           return error;
 
-      oyValueRelease( &s->value, s->value_type, deallocateFunc );
+      oyOption_ValueRelease_( s );
     }
 
     if(!s->value)
     {
-      oyAllocHelper_m_( s->value, oyValue_u, 1,
-                        s->oy_->allocateFunc_,
-                        error = 1 );
+      oyOption_ValueNew_( s );
       if(pos == 0 &&
          s->value_type != oyVAL_INT_LIST)
         s->value_type = oyVAL_INT;
@@ -752,17 +748,10 @@ int            oyOption_StructMoveIn_( oyOption_s_       * option,
 
   if(error <= 0)
   {
-    if(option->value)
-    {
-      oyDeAlloc_f deallocateFunc = option->oy_->deallocateFunc_;
-
-      oyValueRelease( &option->value, option->value_type, deallocateFunc );
-
-      option->value_type = 0;
-    }
+    oyOption_ValueRelease_( option );
+    option->value_type = 0;
 
-    oyAllocHelper_m_( option->value, oyValue_u, 1, option->oy_->allocateFunc_,
-                      error = 1 );
+    oyOption_ValueNew_( option );
   }
 
   if(error <= 0)
@@ -775,5 +764,48 @@ int            oyOption_StructMoveIn_( oyOption_s_       * option,
   return error;
 }
 
+/** @internal
+ *  Function oyOption_ValueNew_
+ *  @memberof oyOption_s
+ *  @brief   provide a empty value
+ *
+ *  The value lives inside the option and needs no extra allocation.
+ *
+ *  @param         option              the option
+ *  @return                            the cleared value
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/08 (Oyranos: 0.3.2)
+ *  @date    2011/11/08
+ */
+oyValue_u *    oyOption_ValueNew_    ( oyOption_s_       * option )
+{
+  memset( &option->value_inline_, 0, sizeof(oyValue_u) );
+  option->value = &option->value_inline_;
+
+  return option->value;
+}
+
+/** @internal
+ *  Function oyOption_ValueRelease_
+ *  @memberof oyOption_s
+ *  @brief   release the value content
+ *
+ *  @param         option              the option
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/08 (Oyranos: 0.3.2)
+ *  @date    2011/11/08
+ */
+void           oyOption_ValueRelease_( oyOption_s_       * option )
+{
+  if(!option->value)
+    return;
+
+  oyValueClear( option->value, option->value_type,
+                option->oy_->deallocateFunc_ );
+  option->value = 0;
+}
+
 /* } Include "Option.private_methods_definitions.c" */
 
@@ -30,6 +30,9 @@
 
 typedef struct oyOption_s_ oyOption_s_;
 /* Include "Option.private.h" { */
+/** @internal
+ *  counts registration changes of options, which might be listed already */
+extern uint32_t oy_option_registrations_;
 
 /* } Include "Option.private.h" */
 
@@ -53,10 +56,11 @@ oyObject_s           oy_;            /**< @private features name and hash */
 
 /* Include "Option.members.h" { */
   uint32_t             id;             /**< id to map to events and widgets */
-  char               * registration;   /**< full key path name to store configuration, e.g. "shared/oyranos.org/imaging/scale/x", see as well @ref registration @see oyOPTIONATTRIBUTE_e */
+  const char         * registration;   /**< full key path name to store configuration, e.g. "shared/oyranos.org/imaging/scale/x", see as well @ref registration @see oyOPTIONATTRIBUTE_e; a counted reference from oyStringInternCopy_() */
   int                  version[3];     /**< as for oyCMMapi4_s::version */
   oyVALUETYPE_e        value_type;     /**< the type in value */
   oyValue_u          * value;          /**< the actual value */
+  oyValue_u            value_inline_;  /**< @private storage for value */
   oyOPTIONSOURCE_e     source;         /**< the source of this value */
   uint32_t             flags;          /**< | oyOPTIONATTRIBUTE_e */
 
@@ -92,6 +96,8 @@ int            oyOption_SetFromInt_  ( oyOption_s_       * obj,
                                        uint32_t            flags );
 int            oyOption_StructMoveIn_( oyOption_s_       * option,
                                        oyStruct_s       ** s );
+oyValue_u *    oyOption_ValueNew_    ( oyOption_s_       * option );
+void           oyOption_ValueRelease_( oyOption_s_       * option );
 
 /* } Include "Option.private_methods_declarations.h" */
 
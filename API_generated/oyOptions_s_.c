@@ -28,6 +28,9 @@
 #include "oyranos_object_internal.h"
 
 
+#include <limits.h>
+#include "oyOption_s_.h"
+#include "oyStructList_s_.h"
   
 
 
@@ -229,19 +232,287 @@ int oyOptions_Release_( oyOptions_s_ **options )
 /* Include "Options.private_methods_definitions.c" { */
 int            oyOptions_Init__Members(oyOptions_s_      * s )
 {
+  s->index_ = 0;
   return 0;
 }
 int            oyOptions_Copy__Members(oyOptions_s_      * dest,
                                        oyOptions_s_      * src )
 {
+  /* the index is rebuilt on demand */
   return 0;
 }
 int            oyOptions_Release__Members (
                                        oyOptions_s_      * s )
 {
+  oyOptionsIndex_s_ * index = s->index_;
+
+  if(index)
+  {
+    if(index->entries)
+      oyDeAllocateFunc_( index->entries );
+    if(index->buckets)
+      oyDeAllocateFunc_( index->buckets );
+    oyDeAllocateFunc_( index );
+    s->index_ = 0;
+  }
+
+  return 0;
+}
+
+/* combine a interned token address with its level */
+#define oyOptionsIndexHash_m_( id, level, buckets_n ) \
+  (((((uint32_t)((size_t)(id) >> 3)) ^ ((uint32_t)(level) * 0x9e3779b9u)) \
+    * 2654435761u >> 7) & ((buckets_n) - 1))
+
+/* append a entry and keep the load factor of the buckets below one */
+static int     oyOptionsIndexAdd_    ( oyOptionsIndex_s_ * index,
+                                       const char        * id,
+                                       int                 level,
+                                       int                 pos )
+{
+  oyOptionsIndexEntry_s_ * e;
+  int i, h;
+
+  if(index->entries_n >= index->entries_reserved)
+  {
+    int n = index->entries_reserved ? index->entries_reserved * 2 : 64;
+    e = oyAllocateFunc_( sizeof(oyOptionsIndexEntry_s_) * n );
+    if(!e)
+      return 1;
+    if(index->entries_n)
+      memcpy( e, index->entries,
+              sizeof(oyOptionsIndexEntry_s_) * index->entries_n );
+    if(index->entries)
+      oyDeAllocateFunc_( index->entries );
+    index->entries = e;
+    index->entries_reserved = n;
+  }
+
+  if(index->entries_n >= index->buckets_n)
+  {
+    int n = index->buckets_n ? index->buckets_n * 2 : 64;
+    int * b = oyAllocateFunc_( sizeof(int) * n );
+    if(!b)
+      return 1;
+    if(index->buckets)
+      oyDeAllocateFunc_( index->buckets );
+    index->buckets = b;
+    index->buckets_n = n;
+    for(i = 0; i < n; ++i)
+      b[i] = -1;
+    for(i = 0; i < index->entries_n; ++i)
+    {
+      e = &index->entries[i];
+      h = oyOptionsIndexHash_m_( e->id, e->level, n );
+      e->next = b[h];
+      b[h] = i;
+    }
+  }
+
+  e = &index->entries[index->entries_n];
+  e->id = id;
+  e->level = level;
+  e->pos = pos;
+  h = oyOptionsIndexHash_m_( id, level, index->buckets_n );
+  e->next = index->buckets[h];
+  index->buckets[h] = index->entries_n++;
+
   return 0;
 }
 
+/* hash all registration tokens of a listed option */
+static int     oyOptionsIndexAddOption_( oyOptionsIndex_s_ * index,
+                                       oyStruct_s        * obj,
+                                       int                 pos )
+{
+  oyOption_s_ * o = (oyOption_s_*) obj;
+  const oyRegistrationPattern_s_ * reg = 0;
+  int error = 0, release = 0, i, j, last;
+
+  /* other objects are skipped by oyOptions_Find() */
+  if(!o || o->type_ != oyOBJECT_OPTION_S)
+    return 0;
+
+  if(o->registration)
+    reg = oyRegistrationPatternGet_( o->registration, &release );
+
+  /* uncached tokens are not interned; such options are always compared */
+  if(!reg || !reg->cached)
+  {
+    if(release && reg)
+      oyDeAllocateFunc_( (oyPointer)reg );
+    return oyOptionsIndexAdd_( index, oyStringIntern_( "" ),
+                               OY_OPTIONS_INDEX_UNSET_, pos );
+  }
+
+  last = reg->levels_n - 1;
+  for(i = 0; i < reg->levels_n && !error; ++i)
+    for(j = reg->levels[i]; j < reg->levels[i + 1] && !error; ++j)
+    {
+      error = oyOptionsIndexAdd_( index, reg->tokens[j].id, i, pos );
+      if(!error && i == last)
+        error = oyOptionsIndexAdd_( index, reg->tokens[j].id,
+                                    OY_OPTIONS_INDEX_KEY_, pos );
+    }
+
+  if(reg->levels_n < index->levels_min)
+    index->levels_min = reg->levels_n;
+
+  if(release)
+    oyDeAllocateFunc_( (oyPointer)reg );
+
+  return error;
+}
+
+/* bring the index in sync with the list; appended options are just added */
+static int     oyOptionsIndexUpdate_ ( oyOptions_s_      * s )
+{
+  oyStructList_s_ * list = (oyStructList_s_*) s->list_;
+  oyOptionsIndex_s_ * index = s->index_;
+  uint32_t registrations = oyAtomicGet_m( &oy_option_registrations_ );
+  int error = !list, i;
+
+  if(!error && !index)
+  {
+    index = oyAllocateFunc_( sizeof(oyOptionsIndex_s_) );
+    error = !index;
+    if(!error)
+    {
+      memset( index, 0, sizeof(oyOptionsIndex_s_) );
+      s->index_ = index;
+    }
+  }
+
+  if(error)
+    return error;
+
+  if(index->list != (oyStructList_s*)list ||
+     index->order != list->order_ ||
+     index->registrations != registrations ||
+     index->n > list->n_)
+  {
+    index->list = (oyStructList_s*)list;
+    index->order = list->order_;
+    index->registrations = registrations;
+    index->n = 0;
+    index->levels_min = INT_MAX;
+    index->entries_n = 0;
+    for(i = 0; i < index->buckets_n; ++i)
+      index->buckets[i] = -1;
+  }
+
+  for(i = index->n; i < list->n_ && !error; ++i)
+    error = oyOptionsIndexAddOption_( index, list->ptr_[i], i );
+
+  if(error)
+    /* start over next time */
+    index->list = 0;
+  else
+    index->n = list->n_;
+
+  return error;
+}
+
+/** @internal
+ *  Function oyOptions_IndexFind_
+ *  @memberof oyOptions_s
+ *  @brief   look up the first option matching a registration pattern
+ *
+ *  A option can only match, if it holds the first required token of the
+ *  pattern, or a empty token, at the same level. Only those options are
+ *  looked up in the index and compared with oyFilterRegistrationMatch().
+ *  The caller must hold the lock of oyOptions_s_::list_.
+ *
+ *  @param         s                   the options
+ *  @param         registration        registration or key
+ *  @return                            list position of the first match,
+ *                                     -1 for no match,
+ *                                     -2 for a pattern to scan for
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/10 (Oyranos: 0.3.2)
+ *  @date    2011/11/10
+ */
+int            oyOptions_IndexFind_  ( oyOptions_s_      * s,
+                                       const char        * registration )
+{
+  oyStructList_s_ * list = (oyStructList_s_*) s->list_;
+  oyOptionsIndex_s_ * index;
+  const oyRegistrationPattern_s_ * pat;
+  const oyRegistrationToken_s_ * pt;
+  oyOptionsIndexEntry_s_ * e;
+  oyOption_s_ * o;
+  const char * id = 0, * ids[3];
+  int levels[3], release = 0, level = 0, pos = -1, i, j, k;
+
+  if(oyOptionsIndexUpdate_( s ))
+    return -2;
+  index = s->index_;
+
+  pat = oyRegistrationPatternGet_( registration, &release );
+  if(!pat)
+    return -2;
+  /* uncached token ids can not be looked up by pointer */
+  if(!pat->cached)
+  {
+    oyDeAllocateFunc_( (oyPointer)pat );
+    return -2;
+  }
+
+  /* a key is compared to the last level of each registration */
+  if(pat->levels_n == 1)
+    level = OY_OPTIONS_INDEX_KEY_;
+
+  /* search the most specific level with a required token */
+  for(i = 0; i < pat->levels_n && i < index->levels_min; ++i)
+  {
+    for(j = pat->levels[i]; j < pat->levels[i + 1]; ++j)
+    {
+      pt = &pat->tokens[j];
+      if(pt->type == '+' && pt->id[0])
+      {
+        id = pt->id;
+        if(level != OY_OPTIONS_INDEX_KEY_)
+          level = i;
+        break;
+      }
+    }
+
+    /* a unmatched '_' or '-' token at the level end skips further levels */
+    if(pat->tokens[pat->levels[i + 1] - 1].type != '+')
+      break;
+  }
+
+  if(release)
+    oyDeAllocateFunc_( (oyPointer)pat );
+
+  if(!id)
+    return -2;
+
+  ids[0] = id;                     levels[0] = level;
+  ids[1] = oyStringIntern_( "" );  levels[1] = level;
+  ids[2] = ids[1];                 levels[2] = OY_OPTIONS_INDEX_UNSET_;
+
+  for(k = 0; k < 3 && index->buckets_n; ++k)
+  {
+    i = index->buckets[oyOptionsIndexHash_m_( ids[k], levels[k],
+                                              index->buckets_n )];
+    for( ; i >= 0; i = e->next)
+    {
+      e = &index->entries[i];
+      if(e->id != ids[k] || e->level != levels[k] ||
+         (pos >= 0 && e->pos >= pos))
+        continue;
+
+      o = (oyOption_s_*) list->ptr_[e->pos];
+      if(o && o->type_ == oyOBJECT_OPTION_S &&
+         oyFilterRegistrationMatch( o->registration, registration, 0 ))
+        pos = e->pos;
+    }
+  }
+
+  return pos;
+}
 
 /**
  *  @internal
@@ -291,7 +562,7 @@ void           oyOptions_ParseXML_   ( oyOptions_s_      * s,
       }
 
       if(tmp)
-        o = (oyOption_s*)oyOption_FromRegistration( tmp, 0 );
+        o = (oyOption_s*)oyOption_FromRegistration( tmp, s->oy_ );
 
       if(!o)
         goto clean_stage;
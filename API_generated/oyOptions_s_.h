@@ -37,6 +37,39 @@
 
 typedef struct oyOptions_s_ oyOptions_s_;
 /* Include "Options.private.h" { */
+/** @internal
+ *  a registration token of a listed option */
+typedef struct {
+  const char         * id;             /**< interned token without prefix */
+  int                  level;          /**< registration level or one of -1 for the key level, -2 for a option without registration */
+  int                  pos;            /**< position in oyOptions_s_::list_ */
+  int                  next;           /**< next entry in the bucket or -1 */
+} oyOptionsIndexEntry_s_;
+
+/** @internal
+ *  token index over the options of a oyOptions_s_
+ *
+ *  Each option is hashed with all tokens of its registration levels and
+ *  with the tokens of its last level as key. A empty token matches every
+ *  pattern and is hashed as empty string. Entries are appended in list
+ *  order and dropped, as soon as already listed positions or registrations
+ *  change.
+ */
+typedef struct {
+  uint32_t             order;          /**< oyStructList_s_::order_ at build time */
+  uint32_t             registrations;  /**< oy_option_registrations_ at build time */
+  oyStructList_s     * list;           /**< the indexed list */
+  int                  n;              /**< indexed list positions */
+  int                  levels_min;     /**< least levels of indexed registrations */
+  oyOptionsIndexEntry_s_ * entries;    /**< the entries */
+  int                  entries_n;      /**< used entries */
+  int                  entries_reserved; /**< allocated entries */
+  int                * buckets;        /**< first entry in each bucket or -1 */
+  int                  buckets_n;      /**< a power of two */
+} oyOptionsIndex_s_;
+
+#define OY_OPTIONS_INDEX_KEY_ -1
+#define OY_OPTIONS_INDEX_UNSET_ -2
 
 /* } Include "Options.private.h" */
 
@@ -59,6 +92,11 @@ oyObject_s           oy_;            /**< @private features name and hash */
 
   oyStructList_s     * list_;          /**< the list data */
 
+/* Include "Options.members.h" { */
+  oyOptionsIndex_s_  * index_;         /**< @private key index of list_, guarded by the list_ lock */
+
+/* } Include "Options.members.h" */
+
 };
 
 
@@ -102,6 +140,8 @@ void           oyOptions_ParseXML_   ( oyOptions_s_      * s,
                                        int               * texts_n,
                                        xmlDocPtr           doc,
                                        xmlNodePtr          cur );
+int            oyOptions_IndexFind_  ( oyOptions_s_      * s,
+                                       const char        * registration );
 
 /* } Include "Options.private_methods_declarations.h" */
 
@@ -150,6 +150,8 @@ int              oyStructList_MoveIn ( oyStructList_s    * list,
           s->ptr_[i] = *ptr;
           set = 1;
         }
+      if(set)
+        oyStructList_OrderChanged_m_( s );
     }
 
   if(error <= 0 && !set)
@@ -181,6 +183,8 @@ int              oyStructList_MoveIn ( oyStructList_s    * list,
     /* position the new */
     if(pos < 0 || pos >= s->n_)
       pos = s->n_;
+    else
+      oyStructList_OrderChanged_m_( s );
 
     /* sort the old to the new */
     {
@@ -208,7 +212,7 @@ int              oyStructList_MoveIn ( oyStructList_s    * list,
       {
         if(real_copy)
         {
-          if(s->ptr_)
+          if(s->ptr_ && s->ptr_ != s->ptr_inline_)
             oyDeAllocateFunc_(s->ptr_);
           s->ptr_ = tmp;
         }
@@ -317,6 +321,7 @@ int            oyStructList_ReleaseAt( oyStructList_s    * list,
                               sizeof(oyStruct_s*) * (s->n_ - pos - 1));
 
           --s->n_;
+          oyStructList_OrderChanged_m_( s );
       }
   }
 
@@ -592,6 +597,7 @@ int              oyStructList_Sort   ( oyStructList_s    * list,
 
     /* move back the sorted data */
     error = !memmove( s->ptr_, ptr, n * sizeof(oyPointer) );
+    oyStructList_OrderChanged_m_( s );
     if(!error)
       error = !memmove( rank_list, rank_copy, n * sizeof(int32_t) );
   }
@@ -30,6 +30,18 @@
 
 typedef struct oyStructList_s_ oyStructList_s_;
 /* Include "StructList.private.h" { */
+/** @internal
+ *  number of pointers a oyStructList_s holds without a extra allocation */
+#define OY_STRUCT_LIST_INLINE_N_ 8
+
+/** @internal
+ *  source of oyStructList_s_::order_ stamps, unique over all lists */
+extern uint32_t oy_struct_list_order_;
+/** @internal
+ *  mark the positions of already listed pointers as changed; appending
+ *  keeps the stamp, so dependent indices need only to be extended */
+#define oyStructList_OrderChanged_m_( s ) \
+  (s)->order_ = oyAtomicInc_m( &oy_struct_list_order_ )
 
 /* } Include "StructList.private.h" */
 
@@ -57,6 +69,8 @@ int                  n_;             /**< @private the number of visible pointer
 int                  n_reserved_;    /**< @private the number of allocated pointers */
 char               * list_name;      /**< name of list */
 oyOBJECT_e           parent_type_;   /**< @private parents struct type */
+oyStruct_s         * ptr_inline_[OY_STRUCT_LIST_INLINE_N_]; /**< @private storage of short lists */
+uint32_t             order_;         /**< @private stamp of the last change of the listed positions */
 
 /* } Include "StructList.members.h" */
 
@@ -163,16 +163,79 @@ void       oyUnLockDummy_              ( oyPointer         look,
                                          const char      * marker,
                                          int               line ) {;}
 
-oyStruct_LockCreate_f   oyStruct_LockCreateFunc_ = oyStruct_LockCreateDummy_;
-oyLockRelease_f         oyLockReleaseFunc_ = oyLockReleaseDummy_;
-oyLock_f                oyLockFunc_        = oyLockDummy_;
-oyUnLock_f              oyUnLockFunc_      = oyUnLockDummy_;
+#if defined(HAVE_POSIX)
+#include <pthread.h>
+
+/* built in recursive locks, used as long as no other functions are set */
+oyPointer  oyStruct_LockCreatePthread_ ( oyStruct_s      * obj )
+{
+  pthread_mutex_t * mutex = (pthread_mutex_t*)
+                                 oyAllocateFunc_( sizeof(pthread_mutex_t) );
+  pthread_mutexattr_t attr;
+
+  if(!mutex)
+    return 0;
+
+  pthread_mutexattr_init( &attr );
+  pthread_mutexattr_settype( &attr, PTHREAD_MUTEX_RECURSIVE );
+  pthread_mutex_init( mutex, &attr );
+  pthread_mutexattr_destroy( &attr );
+
+  return mutex;
+}
+void       oyLockReleasePthread_       ( oyPointer         lock,
+                                         const char      * marker,
+                                         int               line )
+{
+  if(lock)
+  {
+    pthread_mutex_destroy( (pthread_mutex_t*) lock );
+    oyDeAllocateFunc_( lock );
+  }
+}
+void       oyLockPthread_              ( oyPointer         lock,
+                                         const char      * marker,
+                                         int               line )
+{
+  if(lock)
+    pthread_mutex_lock( (pthread_mutex_t*) lock );
+}
+void       oyUnLockPthread_            ( oyPointer         lock,
+                                         const char      * marker,
+                                         int               line )
+{
+  if(lock)
+    pthread_mutex_unlock( (pthread_mutex_t*) lock );
+}
+
+#define oyStruct_LockCreateDefault_ oyStruct_LockCreatePthread_
+#define oyLockReleaseDefault_       oyLockReleasePthread_
+#define oyLockDefault_              oyLockPthread_
+#define oyUnLockDefault_            oyUnLockPthread_
+#else
+#define oyStruct_LockCreateDefault_ oyStruct_LockCreateDummy_
+#define oyLockReleaseDefault_       oyLockReleaseDummy_
+#define oyLockDefault_              oyLockDummy_
+#define oyUnLockDefault_            oyUnLockDummy_
+#endif
+
+oyStruct_LockCreate_f   oyStruct_LockCreateFunc_ = oyStruct_LockCreateDefault_;
+oyLockRelease_f         oyLockReleaseFunc_ = oyLockReleaseDefault_;
+oyLock_f                oyLockFunc_        = oyLockDefault_;
+oyUnLock_f              oyUnLockFunc_      = oyUnLockDefault_;
 
 /** Function: oyThreadLockingSet
  *  @brief set locking functions for threaded applications
  *
- *  @since Oyranos: version 0.1.8      
- *  @date  14 january 2008 (API 0.1.8)
+ *  Oyranos uses recursive POSIX thread mutexes by default. Applications
+ *  can replace them by their own toolkit locks. Passing only zeros
+ *  restores the built in locks. The functions should be set before
+ *  the first object is locked, as existing locks are released with the
+ *  then current release function.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2008/01/14 (Oyranos: 0.1.8)
+ *  @date    2011/11/04
  */
 void         oyThreadLockingSet        ( oyStruct_LockCreate_f  createLockFunc,
                                          oyLockRelease_f   releaseLockFunc,
@@ -187,10 +250,10 @@ void         oyThreadLockingSet        ( oyStruct_LockCreate_f  createLockFunc,
   if(!oyStruct_LockCreateFunc_ && !oyLockReleaseFunc_ &&
      !oyLockFunc_ && !oyUnLockFunc_)
   {
-    oyStruct_LockCreateFunc_ = oyStruct_LockCreateDummy_;
-    oyLockReleaseFunc_ = oyLockReleaseDummy_;
-    oyLockFunc_ = oyLockDummy_;
-    oyUnLockFunc_ = oyUnLockDummy_;
+    oyStruct_LockCreateFunc_ = oyStruct_LockCreateDefault_;
+    oyLockReleaseFunc_ = oyLockReleaseDefault_;
+    oyLockFunc_ = oyLockDefault_;
+    oyUnLockFunc_ = oyUnLockDefault_;
   }
 }
 
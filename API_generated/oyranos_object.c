@@ -5,7 +5,9 @@
 #include "oyranos_helper.h"
 #include "oyranos_i18n.h"
 #include "oyranos_object.h"
+#include "oyranos_object_internal.h"
 #include "oyranos_string.h"
+#include "lookup3.h" /* oy_hashlittle */
 
 /** @brief   test a boolean operator
  *
@@ -516,141 +518,289 @@ int    oyFilterRegistrationMatch     ( const char        * registration,
   return 0;
 }
 #else
+#define OY_REGISTRATION_PATTERNS_N_ 1024
+/* keep the hash chains short, even with a flood of generated keys */
+#define OY_REGISTRATION_PATTERNS_MAX_ (OY_REGISTRATION_PATTERNS_N_ * 8)
+/* the entries are never released, new ones are prepended atomically */
+static oyRegistrationPattern_s_ *
+               oy_registration_patterns_[OY_REGISTRATION_PATTERNS_N_];
+static int oy_registration_patterns_n_ = 0;
+
+/* split text into levels and tokens; only cached entries are interned,
+ * a uncached entry carries its token texts in the same allocation */
+static oyRegistrationPattern_s_ * oyRegistrationPatternNew_ (
+                                       const char        * text,
+                                       uint32_t            hash,
+                                       int                 cache )
+{
+  oyRegistrationPattern_s_ * p = 0;
+  oyRegistrationToken_s_ * token;
+  const char * t, * start = text;
+  char * tmp = 0, * names = 0;
+  int levels_n = 1, tokens_n = 1, level = 0, n, skip;
+  size_t names_size;
+
+  for(t = text; *t; ++t)
+    if(*t == OY_SLASH_C)
+    {
+      ++levels_n;
+      ++tokens_n;
+    } else if(*t == '.')
+      ++tokens_n;
+
+  names_size = cache ? 0 : (t - text) + tokens_n;
+  p = oyAllocateFunc_( sizeof(oyRegistrationPattern_s_) +
+                       sizeof(oyRegistrationToken_s_) * tokens_n +
+                       sizeof(int) * (levels_n + 1) + names_size );
+  if(cache)
+    tmp = oyAllocateFunc_( t - text + 1 );
+  if(!p || (cache && !tmp))
+  {
+    if(p) oyDeAllocateFunc_( p );
+    if(tmp) oyDeAllocateFunc_( tmp );
+    return 0;
+  }
+
+  p->hash = hash;
+  p->text = cache ? oyStringIntern_( text ) : text;
+  p->cached = cache;
+  p->levels_n = levels_n;
+  p->tokens = (oyRegistrationToken_s_*) (p + 1);
+  p->levels = (int*) (p->tokens + tokens_n);
+  p->levels[0] = 0;
+  names = (char*) (p->levels + levels_n + 1);
+  token = p->tokens;
+
+  for(t = text; ; ++t)
+  {
+    if(*t && *t != '.' && *t != OY_SLASH_C)
+      continue;
+
+    /* strip the api number and match type prefixes */
+    n = t - start;
+    token->api = 0;
+    token->type = '+';
+    skip = 0;
+    if(n && start[0] >= '4' && start[0] <= '9')
+    {
+      token->api = start[0];
+      if(n > 1)
+        token->type = start[1];
+      skip = OY_MIN( n, 2 );
+    } else if(n && (start[0] == '_' || start[0] == '-'))
+    {
+      token->type = start[0];
+      skip = 1;
+    }
+    if(cache)
+    {
+      memcpy( tmp, start + skip, n - skip );
+      tmp[n - skip] = 0;
+      token->id = oyStringIntern_( tmp );
+    } else
+    {
+      memcpy( names, start + skip, n - skip );
+      names[n - skip] = 0;
+      token->id = names;
+      names += n - skip + 1;
+    }
+    ++token;
+
+    if(*t != '.')
+      p->levels[++level] = token - p->tokens;
+    if(!*t)
+      break;
+    start = t + 1;
+  }
+
+  if(tmp)
+    oyDeAllocateFunc_( tmp );
+
+  if(!p->text || level != levels_n)
+  {
+    oyDeAllocateFunc_( p );
+    p = 0;
+  }
+
+  return p;
+}
+
+/** @internal
+ *  @brief   look up or compile a registration or pattern
+ *
+ *  Lock free, as entries are never removed.
+ *  A uncached result is signaled in *release and must be deallocated.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/09 (Oyranos: 0.3.2)
+ *  @date    2011/11/10
+ */
+const oyRegistrationPattern_s_ * oyRegistrationPatternGet_ (
+                                       const char        * text,
+                                       int               * release )
+{
+  uint32_t hash = oy_hashlittle( text, strlen(text), 0 );
+  oyRegistrationPattern_s_ ** bucket =
+                   &oy_registration_patterns_[hash % OY_REGISTRATION_PATTERNS_N_];
+  oyRegistrationPattern_s_ * head, * p, * new_p = 0;
+
+  *release = 0;
+
+  do {
+    head = oyAtomicGet_m( bucket );
+    for(p = head; p; p = p->next)
+      if(p->hash == hash && strcmp( p->text, text ) == 0)
+      {
+        /* a other thread was faster */
+        if(new_p)
+          oyDeAllocateFunc_( new_p );
+        return p;
+      }
+
+    if(!new_p &&
+       oyAtomicGet_m( &oy_registration_patterns_n_ ) >=
+                                                 OY_REGISTRATION_PATTERNS_MAX_)
+    {
+      *release = 1;
+      return oyRegistrationPatternNew_( text, hash, 0 );
+    }
+
+    if(!new_p)
+      new_p = oyRegistrationPatternNew_( text, hash, 1 );
+    if(!new_p)
+      return 0;
+    new_p->next = head;
+  } while(!oyAtomicCasPtr_m( bucket, head, new_p ));
+
+  oyAtomicInc_m( &oy_registration_patterns_n_ );
+
+  return new_p;
+}
+
+/** @internal
+ *  @brief   drop all cached registrations and patterns
+ *
+ *  The cache is lock free for readers. So no other thread may match
+ *  registrations meanwhile. Tests use it to start from a empty cache.
+ *  Interned token texts stay valid.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+void   oyRegistrationPatternsReset_  ( void )
+{
+  oyRegistrationPattern_s_ * p, * next;
+  int i;
+
+  for(i = 0; i < OY_REGISTRATION_PATTERNS_N_; ++i)
+  {
+    for(p = oy_registration_patterns_[i]; p; p = next)
+    {
+      next = p->next;
+      oyDeAllocateFunc_( p );
+    }
+    oy_registration_patterns_[i] = 0;
+  }
+  oy_registration_patterns_n_ = 0;
+}
+
+/* a level without text, e.g. from a leading "//" */
+static int oyRegistrationLevelIsEmpty_(
+                                       const oyRegistrationPattern_s_ * p,
+                                       int                 level )
+{
+  const oyRegistrationToken_s_ * t = &p->tokens[p->levels[level]];
+
+  return p->levels[level + 1] - p->levels[level] == 1 &&
+         !t->id[0] && !t->api && t->type == '+';
+}
+
 /** Function oyFilterRegistrationMatch 
  *  @brief   analyse registration string and compare with a given pattern
  *
  *  The rules are described in the @ref module_api overview.
  *  The function is intensively used.
  *
+ *  Registration and pattern are split once into tokens of interned strings
+ *  and cached for the process lifetime. The comparison needs then no
+ *  string parsing and no allocations. Past OY_REGISTRATION_PATTERNS_MAX_
+ *  entries the strings are split per call and the token texts compared.
+ *
  *  @param         registration        registration string to analise
  *  @param         pattern             pattern or key name to compare with
  *  @param         api_number          select object type
  *  @return                            match, useable for ranking
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2008/06/26 (Oyranos: 0.1.8)
- *  @date    2009/07/16
+ *  @date    2011/11/24
  */
 int    oyFilterRegistrationMatch     ( const char        * registration,
                                        const char        * pattern,
                                        oyOBJECT_e          api_number )
 {
-  char  * reg_text = 0;
-  int     reg_n = 0;
-  int     reg_len = 0;
-  char  * regc_text = 0;
-  int     regc_n = 0;
-  int     regc_len = 0;
-  char  * p_text = 0;
-  int     p_n = 0;
-  int     p_len = 0;
-  char  * pc_text = 0;
-  int     pc_n = 0;
-  int     pc_len = 0;
-  int     match = 0, match_tmp = 0, i,j,k, api_num = oyOBJECT_NONE, pc_api_num;
-  char    pc_match_type = '+';
- 
+  const oyRegistrationPattern_s_ * reg = 0, * pat = 0;
+  const oyRegistrationToken_s_ * rt, * pt;
+  int     match = 0, match_tmp = 0, i,j,k, api_num = oyOBJECT_NONE,
+          reg_n, p_n, reg_level, p_level, reg_release = 0, p_release = 0;
+
   if(registration && pattern)
   {
+    reg = oyRegistrationPatternGet_( registration, &reg_release );
+    pat = oyRegistrationPatternGet_( pattern, &p_release );
+    if(!reg || !pat)
+      goto clean;
+
     api_num = oyCMMapiNumberToChar(api_number);
     match_tmp = 1;
-    reg_n = oyStringSegments_(registration, OY_SLASH_C);
-    p_n = oyStringSegments_(pattern, OY_SLASH_C);
+    reg_n = reg->levels_n;
+    p_n = pat->levels_n;
 
     for( i = 0; i < reg_n && i < p_n; ++i)
     {
-      regc_n = 0;
+      reg_level = p_level = i;
 
       /* allow a key only in *pattern to filter from *registration */
       if(p_n == 1)
       {
-        reg_text = oyFilterRegistrationToSTextField( registration,
-                                                    oyFILTER_REG_MAX, &reg_len);
-        regc_n = oyStringSegmentsN_( reg_text, reg_len, '.' );
-        /*if(oyStringSegment_(key_tmp, '.', &regc_n, &regc_texts_pos,
-                              &max_segment ))
-          return 0;*/
-        p_text = oyStringSegment_( (char*)pattern, OY_SLASH_C, i, &p_len );
-        pc_n = oyStringSegmentsN_( p_text, p_len, '.' );
+        reg_level = reg_n - 1;
         i = reg_n;
-      } else
-      /* level by level comparision */
-      {
-        reg_text = oyStringSegment_( (char*)registration,
-                                        OY_SLASH_C, i, &reg_len );
-        regc_n = oyStringSegmentsN_( reg_text, reg_len, '.' );
-        p_text = oyStringSegment_( (char*)pattern, OY_SLASH_C, i, &p_len );
-        pc_n = oyStringSegmentsN_( p_text, p_len, '.' );
       }
 
-      if(match_tmp && pc_n && regc_n)
+      /* empty levels are skipped and do not add to the rank */
+      if(match_tmp &&
+         !oyRegistrationLevelIsEmpty_( pat, p_level ) &&
+         !oyRegistrationLevelIsEmpty_( reg, reg_level ))
       {
-        for( j = 0; j < pc_n; ++j)
+        for( j = pat->levels[p_level]; j < pat->levels[p_level + 1]; ++j)
         {
+          pt = &pat->tokens[j];
           match_tmp = 0;
-          pc_api_num = 0;
-          pc_match_type = '+';
-          pc_text = oyStringSegmentN_( p_text, p_len, '.', j, &pc_len );
 
-          if(pc_text[0] == '4' ||
-             pc_text[0] == '5' ||
-             pc_text[0] == '6' ||
-             pc_text[0] == '7' ||
-             pc_text[0] == '8' ||
-             pc_text[0] == '9')
+          for( k = reg->levels[reg_level]; k < reg->levels[reg_level + 1]; ++k)
           {
-            pc_api_num = pc_text[0];
-            ++ pc_text;
-            pc_match_type = pc_text[0];
-            ++ pc_text;
-            pc_len -= 2;
-          } else
-          if(pc_text[0] == '_' ||
-             pc_text[0] == '-')
-          {
-            pc_match_type = pc_text[0];
-            ++ pc_text;
-            -- pc_len;
-          }
-
-          for( k = 0; k < regc_n; ++k )
-          {
-            regc_text = oyStringSegmentN_( reg_text, reg_len, '.', k,
-                                              &regc_len );
-            if(regc_text[0] == '4' ||
-               regc_text[0] == '5' ||
-               regc_text[0] == '6' ||
-               regc_text[0] == '7' ||
-               regc_text[0] == '8' ||
-               regc_text[0] == '9')
-            {
-              ++ regc_text;
-              ++ regc_text;
-              regc_len -= 2;
-            } else
-            if(regc_text[0] == '_' ||
-               regc_text[0] == '-')
+            rt = &reg->tokens[k];
+
+            /* interned ids are equal by pointer; a empty '.' token
+             * matches all */
+            if((!pt->api || api_num == pt->api) &&
+               (pt->id == rt->id || !pt->id[0] || !rt->id[0] ||
+                ((!reg->cached || !pat->cached) &&
+                 strcmp( pt->id, rt->id ) == 0)))
             {
-              ++ regc_text;
-              -- regc_len;
-            }
-
-            if((!pc_api_num || (pc_api_num && api_num == pc_api_num)) &&
-               memcmp( regc_text, pc_text, OY_MIN(regc_len,pc_len) ) == 0 &&
-	       (regc_len == pc_len || !regc_len || !pc_len))
-            {
-              if(pc_match_type == '+' ||
-                 pc_match_type == '_')
+              if(pt->type == '+' ||
+                 pt->type == '_')
               {
                 ++ match;
                 match_tmp = 1;
-              } else /* if(pc_match_type == '-') */
-                return 0;
+              } else /* if(pt->type == '-') */
+                goto clean;
             }
           }
 
-          if(pc_match_type == '+' && !match_tmp)
-            return 0;
+          if(pt->type == '+' && !match_tmp)
+            goto clean;
         }
       }
     }
@@ -659,7 +809,19 @@ int    oyFilterRegistrationMatch     ( const char        * registration,
   if(match_tmp == 1 && !match)
     match = 1;
 
+  if(reg_release)
+    oyDeAllocateFunc_( (oyPointer)reg );
+  if(p_release)
+    oyDeAllocateFunc_( (oyPointer)pat );
+
   return match;
+
+  clean:
+  if(reg_release && reg)
+    oyDeAllocateFunc_( (oyPointer)reg );
+  if(p_release && pat)
+    oyDeAllocateFunc_( (oyPointer)pat );
+  return 0;
 }
 #endif
 
@@ -183,6 +183,27 @@ typedef enum {
  *  @date    2009/07/27
  */
 #define OY_SELECT_COMMON         4096
+
+/** @typedef oyIO_t
+    parametric type as shorthand for IO flags \n
+
+    should fit into a 32bit type, usual unsigned int or uint32_t \n
+
+    ------ W R \n
+
+    R  no cache read \n
+    W  no cache write \n
+
+    The IO flags are taken by constructors like oyProfile_FromFile() and
+    oyOptions_FromText(). They are a own set and not to be mixed with
+    OY_CREATE_NEW or OY_ADD_ALWAYS of the oyOptions_SetFrom...() functions.
+ */
+#define OY_NO_CACHE_READ            0x01        /** read not from cache */
+#define OY_NO_CACHE_WRITE           0x02        /** write not from cache */
+/* decode */
+#define oyToNoCacheRead_m(r)        ((r)&1)
+#define oyToNoCacheWrite_m(w)       (((w) >> 1)&1)
+
 /** @enum    oyOPTIONATTRIBUTE_e
  *  @brief   usage type
  *  @ingroup objects_value
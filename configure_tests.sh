@@ -1130,12 +1130,27 @@ if [ -n "$LIBTIFF" ] && [ $LIBTIFF -gt 0 ]; then
                         detected"; echo "$echo_" >> $CONF_LOG; test -n "$ECHO" && $ECHO "$echo_"
       echo "#define HAVE_TIFF 1" >> $CONF_H
       echo "TIFF = 1" >> $CONF
+      echo "TIFF_LIBS = -ltiff" >> $CONF
       rm tests/libtest$EXEC_END
     else
       echo_="no or too old libtiff found,"; echo "$echo_" >> $CONF_LOG; test -n "$ECHO" && $ECHO "$echo_"
     fi
 fi
 
+if [ -n "$LIBJPEG" ] && [ $LIBJPEG -gt 0 ]; then
+  rm -f tests/libtest$EXEC_END
+  $CXX $CFLAGS -I$includedir $ROOT_DIR/tests/jpeg_test.cxx $LDFLAGS -L$libdir -ljpeg -o tests/libtest 2>>$CONF_LOG
+    if [ -f tests/libtest ]; then
+      echo_="`tests/libtest`		detected"; echo "$echo_" >> $CONF_LOG; test -n "$ECHO" && $ECHO "$echo_"
+      echo "#define HAVE_JPEG 1" >> $CONF_H
+      echo "JPEG = 1" >> $CONF
+      echo "JPEG_LIBS = -ljpeg" >> $CONF
+      rm tests/libtest$EXEC_END
+    else
+      echo_="no or too old libjpeg found,"; echo "$echo_" >> $CONF_LOG; test -n "$ECHO" && $ECHO "$echo_"
+    fi
+fi
+
 if [ -n "$GETTEXT" ] && [ $GETTEXT -gt 0 ]; then
   rm -f tests/libtest$EXEC_END
     $CXX $CFLAGS -I$includedir $ROOT_DIR/tests/gettext_test.cxx $LDFLAGS -L$libdir -o tests/libtest 2>/dev/null
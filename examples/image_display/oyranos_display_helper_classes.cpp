@@ -30,6 +30,7 @@ public:
   oyRectangle_s * old_display_rectangle;
   oyRectangle_s * old_roi_rectangle;
   int dirty;
+  double zoom;
 
   Oy_Widget()
   {
@@ -37,6 +38,7 @@ public:
     old_display_rectangle = oyRectangle_NewWith( 0,0,0,0, 0 );
     old_roi_rectangle = oyRectangle_NewWith( 0,0,0,0, 0 );
     dirty = 0;
+    zoom = 1.0;
   };
 
   ~Oy_Widget(void)
@@ -54,6 +56,15 @@ public:
 
   oyConversion_s * conversion() { return context; }
 
+  /* scale the view by the "scale" node */
+  int zoomSet( double z )
+  {
+    int error = oyDisplayZoomSet( context, z );
+    if(!error)
+      zoom = z;
+    return error;
+  }
+
   oyFilterNode_s * setImageType( const char * file_name, oyDATATYPE_e data_type )
   {
     oyFilterNode_s * icc = 0;
@@ -62,6 +73,7 @@ public:
                              data_type, 0 );
 
     conversion( c );
+    zoom = 1.0;
 
     oyConversion_Release( &c );
 
@@ -128,6 +128,30 @@ public:
 #endif
           redraw();
           return (1);
+        case FL_MOUSEWHEEL:
+          /* zoom in power of two steps to reuse the converted levels */
+          if(Fl::event_dy() > 0 && zoom > 1.0/256.0 &&
+             zoomSet( zoom / 2.0 ) == 0)
+          {
+            px /= 2;
+            py /= 2;
+          } else
+          if(Fl::event_dy() < 0 && zoom < 8.0 &&
+             zoomSet( zoom * 2.0 ) == 0)
+          {
+            px *= 2;
+            py *= 2;
+          } else
+            return (1);
+          {
+            /* the whole view needs the new scale */
+            oyImage_s * image = oyConversion_GetImage( conversion(),
+                                                       OY_OUTPUT );
+            oyDrawScreenImageDamage( image, 0, 0, w(), h() );
+            oyImage_Release( &image );
+          }
+          redraw();
+          return (1);
       }
       int ret = Fl_Widget::handle(e);
       return ret;
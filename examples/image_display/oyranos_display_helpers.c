@@ -36,9 +36,9 @@
  *  @param[in]     obj                 Oyranos object (optional)
  *  @return                            generated new graph, owned by caller
  *
- *  @version Oyranos: 0.3.0
+ *  @version Oyranos: 0.3.2
  *  @since   2010/09/05 (Oyranos: 0.1.11)
- *  @date    2011/02/16
+ *  @date    2011/11/24
  */
 oyConversion_s * oyConversion_FromImageFileNameForDisplay  (
                                        const char        * file_name,
@@ -73,20 +73,38 @@ oyConversion_s * oyConversion_FromImageFileNameForDisplay  (
   /* release the options object, this means its not any more refered from here*/
   oyOptions_Release( &options );
 
+  /* Set the image to the first/only socket of the filter node.
+   * oyFilterNode_Connect() has now no chance to copy it it the other nodes.
+   * We rely on resolving the image later.
+   */
+  oyFilterNode_DataSet( in, (oyStruct_s*)image_in, 0, 0 );
+
+  /* resample before colour conversion; only the visible pixels are converted
+   * then. The "scale" option changes the zoom level. */
+  out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/scale", 0, obj );
+  options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+  error = oyOptions_SetFromDouble( &options, "//" OY_TYPE_STD "/scale/scale",
+                                   1.0, 0, OY_CREATE_NEW );
+  oyOptions_Release( &options );
+  error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                out, "//" OY_TYPE_STD "/data", 0 );
+  if(error > 0)
+    fprintf( stderr, "could not add  filter: %s\n", "//" OY_TYPE_STD "/scale" );
+  in = out;
+
+  /* 8-bit display output bands visibly; let the CMM dither down to it */
+  if(data_type == oyUINT8)
+    error = oyOptions_SetFromText( &options, "//" OY_TYPE_STD "/icc/dither",
+                                   "1", OY_CREATE_NEW );
   /* create a new filter node */
   icc = out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/icc", options, obj );
+  oyOptions_Release( &options );
   /* append the new to the previous one */
   error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
                                 out, "//" OY_TYPE_STD "/data", 0 );
   if(error > 0)
     fprintf( stderr, "could not add  filter: %s\n", "//" OY_TYPE_STD "/icc" );
 
-  /* Set the image to the first/only socket of the filter node.
-   * oyFilterNode_Connect() has now no chance to copy it it the other nodes.
-   * We rely on resolving the image later.
-   */
-  oyFilterNode_DataSet( in, (oyStruct_s*)image_in, 0, 0 );
-
   /* swap in and out */
   in = out;
 
@@ -132,6 +150,456 @@ oyConversion_s * oyConversion_FromImageFileNameForDisplay  (
 }
 
 
+/** Function oyDisplayZoomSet
+ *  @brief   pass the view zoom to the "scale" node of a display graph
+ *
+ *  A zoom of 0.5 shows the image at half its size. Power of two zoom out
+ *  factors reuse the converted pyramid levels in oyDrawScreenImage().
+ *
+ *  @param[in,out] context             the Oyranos graph from
+ *                                     oyConversion_FromImageFileNameForDisplay()
+ *  @param[in]     zoom                the scale factor, must be positive
+ *  @return                            0 - success, >=  1 - error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+int  oyDisplayZoomSet                ( oyConversion_s    * context,
+                                       double              zoom )
+{
+  oyFilterGraph_s * graph = 0;
+  oyFilterNode_s * scale_node = 0;
+  oyOptions_s * options = 0;
+  int error = !context || zoom <= 0.0;
+
+  if(!error)
+  {
+    graph = oyConversion_GetGraph( context );
+    scale_node = oyFilterGraph_GetNode( graph, -1, "//" OY_TYPE_STD "/scale",
+                                        0 );
+    oyFilterGraph_Release( &graph );
+    error = !scale_node;
+  }
+
+  if(!error)
+  {
+    options = oyFilterNode_OptionsGet( scale_node, OY_SELECT_FILTER );
+    error = oyOptions_SetFromDouble( &options, "//" OY_TYPE_STD "/scale/scale",
+                                     zoom, 0, OY_CREATE_NEW );
+    oyOptions_Release( &options );
+  }
+  oyFilterNode_Release( &scale_node );
+
+  return error;
+}
+
+/** @internal
+ *  Function oyDisplayPyramidLevel_
+ *  @brief   obtain the zoom out level and processing identifier of a graph
+ *
+ *  Only power of two scale factors of the "scale" node are considered.
+ *
+ *  @param[in]     context             the Oyranos graph
+ *  @param[out]    icc                 the icc node, owned by caller
+ *  @return                            the level or -1
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/09/16
+ */
+static int oyDisplayPyramidLevel_    ( oyConversion_s    * context,
+                                       oyFilterNode_s   ** icc )
+{
+  oyFilterGraph_s * graph = oyConversion_GetGraph( context );
+  oyFilterNode_s * scale_node = 0;
+  oyOptions_s * options = 0;
+  double scale = 1.0;
+  int level = 0;
+
+  *icc = oyFilterGraph_GetNode( graph, -1, "//" OY_TYPE_STD "/icc", 0 );
+  scale_node = oyFilterGraph_GetNode( graph, -1, "//" OY_TYPE_STD "/scale", 0);
+  oyFilterGraph_Release( &graph );
+
+  if(scale_node)
+  {
+    options = oyFilterNode_OptionsGet( scale_node, 0 );
+    if(oyOptions_FindDouble( options, "scale", 0, &scale ) != 0)
+      scale = 1.0;
+    oyOptions_Release( &options );
+    oyFilterNode_Release( &scale_node );
+  }
+
+  while(scale < 1.0 && level < 16)
+  {
+    scale *= 2.0;
+    ++level;
+  }
+
+  if(!*icc || scale != 1.0)
+    level = -1;
+
+  return level;
+}
+
+/** @internal
+ *  Function oyDisplayImageCopyRect_
+ *  @brief   copy pixels between two images of the same pixel layout
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/09/16
+ */
+static int oyDisplayImageCopyRect_   ( oyImage_s         * src,
+                                       int                 src_x,
+                                       int                 src_y,
+                                       oyImage_s         * dst,
+                                       int                 dst_x,
+                                       int                 dst_y,
+                                       int                 width,
+                                       int                 height )
+{
+  oyPixel_t pt = oyImage_PixelLayoutGet( src );
+  int bps = oyToChannels_m( pt ) * oySizeofDatatype( oyToDataType_m( pt ) );
+  int y, line_height = 0, is_allocated = 0;
+  char * line = 0;
+
+  if(pt != oyImage_PixelLayoutGet( dst ) || !src->getLine || !dst->setLine ||
+     src_x < 0 || src_y < 0 || dst_x < 0 || dst_y < 0 ||
+     src_x + width > src->width || src_y + height > src->height ||
+     dst_x + width > dst->width || dst_y + height > dst->height)
+    return 1;
+
+  for(y = 0; y < height; ++y)
+  {
+    line = (char*) src->getLine( src, src_y + y, &line_height, -1,
+                                 &is_allocated );
+    if(!line)
+      return 1;
+    dst->setLine( dst, dst_x, dst_y + y, width, -1, &line[src_x * bps] );
+    if(is_allocated)
+      free( line );
+  }
+
+  return 0;
+}
+
+#define oyDISPLAY_PYRAMID_VALID_MAX_ 16
+
+/** @internal
+ *  Function oyDisplayPyramidValidGet_
+ *  @brief   obtain the converted areas of a level
+ *
+ *  @return                            number of rectangles in valid
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static int oyDisplayPyramidValidGet_ ( oyImage_s         * level_image,
+                                       oyRectangle_s     * valid )
+{
+  oyOptions_s * tags = oyImage_TagsGet( level_image );
+  oyRectangle_s * r = 0;
+  int i, n = oyOptions_CountType( tags, "//" OY_TYPE_STD "/pyramid/valid",
+                                  oyOBJECT_RECTANGLE_S );
+
+  if(n > oyDISPLAY_PYRAMID_VALID_MAX_)
+    n = oyDISPLAY_PYRAMID_VALID_MAX_;
+  memset( valid, 0, sizeof(oyRectangle_s) * n );
+
+  for(i = 0; i < n; ++i)
+  {
+    r = (oyRectangle_s*) oyOptions_GetType( tags, i,
+                                         "//" OY_TYPE_STD "/pyramid/valid",
+                                         oyOBJECT_RECTANGLE_S );
+    oyRectangle_SetByRectangle( &valid[i], r );
+    oyRectangle_Release( &r );
+  }
+  oyOptions_Release( &tags );
+
+  return n;
+}
+
+/** @internal
+ *  Function oyDisplayRectanglesCover_
+ *  @brief   test if the union of rectangles contains a rectangle
+ *
+ *  The test rectangle is cut into horizontal bands at all rectangle edges.
+ *  Each band must be filled by the intervals of the spanning rectangles.
+ *
+ *  @return                            1 - covered, 0 - not covered
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static int oyDisplayRectanglesCover_ ( oyRectangle_s     * rects,
+                                       int                 n,
+                                       oyRectangle_s     * test )
+{
+  int edges[2*oyDISPLAY_PYRAMID_VALID_MAX_ + 2],
+      starts[oyDISPLAY_PYRAMID_VALID_MAX_],
+      ends[oyDISPLAY_PYRAMID_VALID_MAX_];
+  int x0 = test->x, x1 = test->x + test->width,
+      y0 = test->y, y1 = test->y + test->height;
+  int i, j, k, b, n_edges = 0, n_ivals, t, reach;
+
+  if(test->width <= 0 || test->height <= 0)
+    return 1;
+
+  edges[n_edges++] = y0;
+  edges[n_edges++] = y1;
+  for(i = 0; i < n; ++i)
+  {
+    int ry0 = rects[i].y, ry1 = rects[i].y + rects[i].height;
+    if(y0 < ry0 && ry0 < y1) edges[n_edges++] = ry0;
+    if(y0 < ry1 && ry1 < y1) edges[n_edges++] = ry1;
+  }
+  /* sort the band edges */
+  for(i = 1; i < n_edges; ++i)
+    for(j = i; j > 0 && edges[j-1] > edges[j]; --j)
+    { t = edges[j]; edges[j] = edges[j-1]; edges[j-1] = t; }
+
+  for(b = 0; b + 1 < n_edges; ++b)
+  {
+    int by0 = edges[b], by1 = edges[b+1];
+
+    if(by0 == by1)
+      continue;
+
+    /* collect the x intervals spanning this band, ordered by start */
+    n_ivals = 0;
+    for(i = 0; i < n; ++i)
+    {
+      int s = rects[i].x, e = rects[i].x + rects[i].width;
+      if(rects[i].y > by0 || rects[i].y + rects[i].height < by1 ||
+         e <= x0 || s >= x1)
+        continue;
+      for(k = n_ivals; k > 0 && starts[k-1] > s; --k)
+      { starts[k] = starts[k-1]; ends[k] = ends[k-1]; }
+      starts[k] = s; ends[k] = e;
+      ++n_ivals;
+    }
+
+    reach = x0;
+    for(k = 0; k < n_ivals && starts[k] <= reach; ++k)
+      if(ends[k] > reach)
+        reach = ends[k];
+    if(reach < x1)
+      return 0;
+  }
+
+  return 1;
+}
+
+/** @internal
+ *  Function oyDisplayPyramidLevelSize_
+ *  @brief   the size of a level in the "scale" node output
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static void oyDisplayPyramidLevelSize_(oyImage_s         * source_image,
+                                       int                 level,
+                                       int               * width,
+                                       int               * height )
+{
+  double scale = 1.0 / (double)(1 << level);
+
+  *width = OY_ROUND( source_image->width * scale );
+  *height = OY_ROUND( source_image->height * scale );
+}
+
+/** @internal
+ *  Function oyDisplayPyramidFetch_
+ *  @brief   fill the display image from a cached level
+ *
+ *  The level holds the source image at 1/2^level of its size. Any view
+ *  inside the level and inside its converted areas is served.
+ *
+ *  @param[in,out] image               the display image
+ *  @param[in]     hash_text           identifies the source and conversion
+ *  @param[in]     level               the zoom out level
+ *  @param[in]     source              the view in level coordinates
+ *  @param[in]     target              the view in image coordinates
+ *  @return                            0 - filled, 1 - not cached
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static int oyDisplayPyramidFetch_    ( oyImage_s         * image,
+                                       const char        * hash_text,
+                                       int                 level,
+                                       oyRectangle_s     * source,
+                                       oyRectangle_s     * target )
+{
+  oyImage_s * cached = oyImage_PyramidLevelGet( image, hash_text, level );
+  oyRectangle_s valid[oyDISPLAY_PYRAMID_VALID_MAX_];
+  int n = 0,
+      error = !cached;
+
+  if(!error)
+  {
+    error = source->x < 0 || source->y < 0 ||
+            source->x + source->width > cached->width ||
+            source->y + source->height > cached->height;
+  }
+
+  if(!error)
+  {
+    n = oyDisplayPyramidValidGet_( cached, valid );
+    error = !oyDisplayRectanglesCover_( valid, n, source );
+  }
+
+  if(!error)
+    error = oyDisplayImageCopyRect_( cached, source->x, source->y,
+                                     image, target->x, target->y,
+                                     source->width, source->height );
+
+  oyImage_Release( &cached );
+
+  return error;
+}
+
+/** @internal
+ *  Function oyDisplayPyramidStore_
+ *  @brief   remember the freshly converted pixels in a level
+ *
+ *  The part of the view which lies inside the level is copied into the
+ *  level at its level coordinates and added to the converted areas. The
+ *  oldest area is forgotten once oyDISPLAY_PYRAMID_VALID_MAX_ is reached.
+ *
+ *  @param[in,out] image               the display image
+ *  @param[in]     source_image        the unscaled source image
+ *  @param[in]     hash_text           identifies the source and conversion
+ *  @param[in]     level               the zoom out level
+ *  @param[in]     source              the view in level coordinates
+ *  @param[in]     target              the view in image coordinates
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static int oyDisplayPyramidStore_    ( oyImage_s         * image,
+                                       oyImage_s         * source_image,
+                                       const char        * hash_text,
+                                       int                 level,
+                                       oyRectangle_s     * source,
+                                       oyRectangle_s     * target )
+{
+  oyImage_s * cached = oyImage_PyramidLevelGet( image, hash_text, level );
+  oyRectangle_s valid[oyDISPLAY_PYRAMID_VALID_MAX_];
+  oyRectangle_s clip = {oyOBJECT_RECTANGLE_S,0,0,0};
+  oyRectangle_s * r = 0;
+  int width = 0, height = 0, dx, dy, i, n = 0, start = 0;
+  int error = 0;
+
+  oyDisplayPyramidLevelSize_( source_image, level, &width, &height );
+
+  if(cached && (cached->width != width || cached->height != height))
+    oyImage_Release( &cached );
+
+  if(!cached)
+  {
+    cached = oyImage_Create( width, height, 0,
+                             oyImage_PixelLayoutGet( image ),
+                             image->profile_, 0 );
+    error = !cached ||
+            oyImage_PyramidLevelSet( image, hash_text, level, cached );
+  }
+
+  /* cut the view to the level */
+  if(!error)
+  {
+    oyRectangle_SetByRectangle( &clip, source );
+    r = oyRectangle_NewWith( 0, 0, width, height, 0 );
+    oyRectangle_Trim( &clip, r );
+    oyRectangle_Release( &r );
+    error = clip.width <= 0 || clip.height <= 0;
+  }
+
+  if(!error)
+  {
+    dx = clip.x - source->x;
+    dy = clip.y - source->y;
+    error = oyDisplayImageCopyRect_( image, target->x + dx, target->y + dy,
+                                     cached, clip.x, clip.y,
+                                     clip.width, clip.height );
+  }
+
+  /* keep track of the converted areas */
+  if(!error)
+    n = oyDisplayPyramidValidGet_( cached, valid );
+  if(!error && !oyDisplayRectanglesCover_( valid, n, &clip ))
+  {
+    if(n == oyDISPLAY_PYRAMID_VALID_MAX_)
+      start = 1;
+
+    oyImage_TagsClear( cached, "//" OY_TYPE_STD "/pyramid/valid" );
+    for(i = start; i <= n && !error; ++i)
+    {
+      r = oyRectangle_NewFrom( i < n ? &valid[i] : &clip, 0 );
+      error = oyOptions_MoveInStruct( &cached->tags,
+                                      "//" OY_TYPE_STD "/pyramid/valid",
+                                      (oyStruct_s**)&r, OY_ADD_ALWAYS );
+    }
+  }
+
+  oyImage_Release( &cached );
+
+  return error;
+}
+
+/** Function oyDrawScreenImageDamage
+ *  @brief   mark a window region for redraw
+ *
+ *  Call this function for instance from the toolkits expose events. The next
+ *  oyDrawScreenImage() call will then convert only the damaged regions.
+ *
+ *  @param[in,out] image               the image from graph to display
+ *  @param[in]     x                   position relative to the window
+ *  @param[in]     y                   position relative to the window
+ *  @param[in]     width               region width
+ *  @param[in]     height              region height
+ *  @return                            0 - success, >=  1 - error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/19 (Oyranos: 0.3.2)
+ *  @date    2011/09/19
+ */
+int  oyDrawScreenImageDamage         ( oyImage_s         * image,
+                                       int                 x,
+                                       int                 y,
+                                       int                 width,
+                                       int                 height )
+{
+  oyRectangle_s * damage = 0;
+
+  if(!image || width <= 0 || height <= 0)
+    return 1;
+
+  damage = oyRectangle_NewWith( x, y, width, height, 0 );
+  return oyOptions_MoveInStruct( &image->tags,
+                                 "//" OY_TYPE_STD "/display/damage",
+                                 (oyStruct_s**)&damage, OY_ADD_ALWAYS );
+}
+
+/** @internal
+ *  Function oyDisplayDamageClear_
+ *  @brief   forget about damaged regions
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/19 (Oyranos: 0.3.2)
+ *  @date    2011/09/19
+ */
+static void oyDisplayDamageClear_    ( oyImage_s         * image )
+{
+  oyImage_TagsClear( image, "//" OY_TYPE_STD "/display/damage" );
+}
+
 /** Function oyDrawScreenImage
  *  @brief   generate a Oyranos image from a given context for display
  *
@@ -153,9 +621,16 @@ oyConversion_s * oyConversion_FromImageFileNameForDisplay  (
  *  @param[out]    image               the image from graph to display
  *  @return                            0 - success, >=  1 - error
  *
- *  @version Oyranos: 0.1.11
+ *  Converted areas are remembered as pyramid levels of the image. Level n
+ *  holds the source image at 1/2^n of its size and is keyed by the level,
+ *  the source image and the icc node. A zoom out by a power of two through
+ *  the "scale" node serves any view inside the converted areas of a level,
+ *  as long as the call is not dirty.
+ *  Regions marked with oyDrawScreenImageDamage() are redrawn alone.
+ *
+ *  @version Oyranos: 0.3.2
  *  @since   2010/09/05 (Oyranos: 0.1.11)
- *  @date    2010/09/10
+ *  @date    2011/09/19
  */
 int  oyDrawScreenImage               ( oyConversion_s    * context,
                                        oyPixelAccess_s   * ticket,
@@ -175,7 +650,7 @@ int  oyDrawScreenImage               ( oyConversion_s    * context,
       int Y = display_rectangle->y;
       int W = display_rectangle->width;
       int H = display_rectangle->height;
-      int channels = 0;
+      int channels = 0, damaged = 0;
       oyRectangle_s * disp_rectangle = 0;
       oyOptions_s * image_tags = 0;
       oyDATATYPE_e data_type = oyUINT8;
@@ -246,6 +721,10 @@ int  oyDrawScreenImage               ( oyConversion_s    * context,
                                     "display_rectangle", oyOBJECT_RECTANGLE_S );
       oyRectangle_SetGeo( disp_rectangle, X,Y,W,H );
 
+      damaged = oyOptions_CountType( image_tags,
+                                     "//" OY_TYPE_STD "/display/damage",
+                                     oyOBJECT_RECTANGLE_S );
+
       oyOptions_Release( &image_tags );
 
       /* decide wether to refresh the cached rectangle of our static image */
@@ -257,6 +736,8 @@ int  oyDrawScreenImage               ( oyConversion_s    * context,
            /* Did the image move? */
            ticket->start_xy[0] != ticket->start_xy_old[0] ||
            ticket->start_xy[1] != ticket->start_xy_old[1]) ||
+           /* Some window regions were exposed? */
+           damaged ||
            dirty ))
       {
 #ifdef DEBUG_
@@ -264,8 +745,59 @@ int  oyDrawScreenImage               ( oyConversion_s    * context,
                 oyRectangle_Show(disp_rectangle), X, Y ),
 #endif
 
+        oyFilterNode_s * icc = 0;
+        oyImage_s * source_image = 0;
+        char * hash_text = 0;
+        int level = oyDisplayPyramidLevel_( context, &icc ),
+            cached = 0;
+        oyRectangle_s source = {oyOBJECT_RECTANGLE_S,0,0,0},
+                      target = {oyOBJECT_RECTANGLE_S,0,0,0};
+
+        /* the visible area in the converted image and in the output image */
+        oyRectangle_SetGeo( &source,
+                  (int)(ticket->start_xy[0] * image->width + 0.5),
+                  (int)(ticket->start_xy[1] * image->width + 0.5),
+                  (int)(ticket->output_image_roi->width * image->width + 0.5),
+                  (int)(ticket->output_image_roi->height * image->width + 0.5));
+        oyRectangle_SetGeo( &target,
+                  (int)(ticket->output_image_roi->x * image->width + 0.5),
+                  (int)(ticket->output_image_roi->y * image->width + 0.5),
+                  source.width, source.height );
+
+        /* the source image and the device link identify the levels */
+        source_image = oyConversion_GetImage( context, OY_INPUT );
+        if(icc && source_image)
+        {
+          const char * icc_text = oyFilterNode_GetText( icc, oyNAME_NICK );
+          hash_text = malloc( strlen(icc_text) + 80 );
+          if(hash_text)
+            sprintf( hash_text, "%s source:%d %dx%d", icc_text,
+                     oyObject_GetId( source_image->oy_ ),
+                     source_image->width, source_image->height );
+        }
+        if(dirty)
+          oyImage_PyramidClear( image );
+
+        if(hash_text && level >= 0)
+          cached = !oyDisplayPyramidFetch_( image, hash_text, level,
+                                            &source, &target );
+        /* the cache refreshed the whole area */
+        if(cached)
+          oyDisplayDamageClear_( image );
+
         /* convert the image data */
-        oyConversion_RunPixels( context, ticket );
+        if(!cached)
+        {
+          oyConversion_RunPixels( context, ticket );
+
+          if(hash_text && level >= 0)
+            oyDisplayPyramidStore_( image, source_image, hash_text, level,
+                                    &source, &target );
+        }
+        if(hash_text)
+          free( hash_text );
+        oyImage_Release( &source_image );
+        oyFilterNode_Release( &icc );
 
         /* remember the old rectangle */
         oyRectangle_SetByRectangle( old_display_rectangle, disp_rectangle );
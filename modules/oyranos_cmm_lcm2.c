@@ -1849,9 +1849,9 @@ char * lcm2FlagsToText               ( int                 flags )
  *  The function might be used to provide a module specific context.
  *  Implements oyModuleData_Convert_f
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2008/12/28 (Oyranos: 0.1.10)
- *  @date    2008/12/28
+ *  @date    2011/09/09
  */
 int  lcm2ModuleData_Convert          ( oyPointer_s       * data_in,
                                        oyPointer_s       * data_out,
@@ -1867,9 +1867,23 @@ int  lcm2ModuleData_Convert          ( oyPointer_s       * data_in,
   oyFilterPlug_s * plug = (oyFilterPlug_s *)node->plugs[0];
   oyImage_s * image_input = 0,
             * image_output = 0;
+  oyPixel_t pixel_layout_out;
+  const char * o_txt = 0;
 
   image_input = (oyImage_s*)plug->remote_socket_->data;
   image_output = (oyImage_s*)socket->data;
+  pixel_layout_out = image_output->layout_[0];
+
+  /* transform to 16-bit and let lcm2FilterPlug_CmmIccRun dither to 8-bit */
+  o_txt = oyOptions_FindString( node->core->options_, "dither", 0 );
+  if(o_txt && atoi( o_txt ) > 0 &&
+     oyToDataType_m( pixel_layout_out ) == oyUINT8 &&
+     oyToDataType_m( image_input->layout_[0] ) != oyUINT8 &&
+     !oyToPlanar_m( pixel_layout_out ) && !oyToByteswap_m( pixel_layout_out ))
+  {
+    pixel_layout_out &= (~oyDataType_m( oyUINT8 ));
+    pixel_layout_out |= oyDataType_m( oyUINT16 );
+  }
 
 
   if(!error)
@@ -1889,7 +1903,7 @@ int  lcm2ModuleData_Convert          ( oyPointer_s       * data_in,
                                oyPointer_GetSize( cmm_ptr_in) );
     xform = lcm2CMMConversionContextCreate_( lps, 1, 0,0,0,
                                            image_input->layout_[0],
-                                           image_output->layout_[0],
+                                           pixel_layout_out,
                                            node->core->options_,
                                            &ltw, cmm_ptr_out );
     if(!xform)
@@ -1910,9 +1924,9 @@ int  lcm2ModuleData_Convert          ( oyPointer_s       * data_in,
 /** Function lcm2FilterPlug_CmmIccRun
  *  @brief   implement oyCMMFilterPlug_GetNext_f()
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2008/07/18 (Oyranos: 0.1.8)
- *  @date    2011/06/17
+ *  @date    2011/09/05
  */
 int      lcm2FilterPlug_CmmIccRun    ( oyFilterPlug_s    * requestor_plug,
                                        oyPixelAccess_s   * ticket )
@@ -2016,6 +2030,23 @@ int      lcm2FilterPlug_CmmIccRun    ( oyFilterPlug_s    * requestor_plug,
     int w_in =  (int)(array_in->width+0.5),
         w_out = (int)(array_out->width+0.5);
     int stride_in = w_in * bps_in;
+    /* alpha and other extra channels are passed outside of lcms */
+    int colours_in = oyProfile_GetChannelsCount( image_input->profile_ ),
+        colours_out = oyProfile_GetChannelsCount( image_output->profile_ );
+    int alpha_copy = oyToChannels_m( pixel_layout_in ) > colours_in &&
+                     channels > colours_out;
+    oyConnectorImaging_s * pattern = (oyConnectorImaging_s*)socket->pattern;
+    int premultiplied = alpha_copy && oyImage_IsPremultiplied( image_input ) &&
+                     pattern && pattern->type_ == oyOBJECT_CONNECTOR_IMAGING_S &&
+                     pattern->can_premultiplied_alpha;
+    int xyz_in = 0;
+    /* a 16-bit transform is dithered down to the 8-bit output */
+    oyPixel_t pixel_layout_xform = pixel_layout_out;
+    int dither = oyToDataType_m( ltw->oy_pixel_layout_out ) == oyUINT16 &&
+                 data_type_out == oyUINT8;
+    uint8_t * array_dither_tmp = 0;
+    int stride_dither = 0,
+        dither_x = 0, dither_y = 0;
 
     n = w_out / channels;
 
@@ -2035,6 +2066,8 @@ int      lcm2FilterPlug_CmmIccRun    ( oyFilterPlug_s    * requestor_plug,
     if(ltw->sig_in  == icSigXYZData &&
        (data_type_in == oyFLOAT ||
         data_type_in == oyDOUBLE))
+      xyz_in = 1;
+    if(xyz_in || premultiplied)
     {
       array_in_tmp = oyAllocateFunc_( stride_in * threads_n );
       if(data_type_in == oyFLOAT)
@@ -2048,6 +2081,16 @@ int      lcm2FilterPlug_CmmIccRun    ( oyFilterPlug_s    * requestor_plug,
     {
       array_out_tmp = array_out->array2d[0];
     }
+    if(dither)
+    {
+      pixel_layout_xform &= (~oyDataType_m( data_type_out ));
+      pixel_layout_xform |= oyDataType_m( oyUINT16 );
+      stride_dither = n * channels * sizeof(uint16_t);
+      array_dither_tmp = oyAllocateFunc_( stride_dither * threads_n );
+      /* absolute positions keep the dither pattern seamless across tickets */
+      dither_x = OY_ROUND( ticket->output_image_roi->x * image_output->width );
+      dither_y = OY_ROUND( ticket->output_image_roi->y * image_output->width );
+    }
     
 
     /*  - - - - - conversion - - - - - */
@@ -2058,99 +2101,76 @@ int      lcm2FilterPlug_CmmIccRun    ( oyFilterPlug_s    * requestor_plug,
       const double xyz_factor = 1.0 + 32767.0/32768.0;
       const int use_xyz_scale = 1;
       int index = 0;
-      if(array_out->height > threads_n * 10)
-      {
 #if defined(USE_OPENMP)
-#pragma omp parallel for private(index,j,array_in_tmp_flt,array_in_tmp_dbl,array_out_tmp_flt,array_out_tmp_dbl)
+#pragma omp parallel for private(index,j,array_in_tmp_flt,array_in_tmp_dbl,array_out_tmp_flt,array_out_tmp_dbl) if(array_out->height > threads_n * 10)
 #endif
-        for( k = 0; k < array_out->height; ++k)
-        {
-          if(array_in_tmp && use_xyz_scale)
-          {
+      for( k = 0; k < array_out->height; ++k)
+      {
+        uint8_t * line_in = array_in->array2d[k],
+                * line_out = array_out->array2d[k];
 #if defined(_OPENMP) && defined(USE_OPENMP)
-            index = omp_get_thread_num();
+        index = omp_get_thread_num();
 #endif
-            memcpy( &array_in_tmp[stride_in*index], array_in->array2d[k], w_in * bps_in );
-            if(data_type_in == oyFLOAT)
-            {
-              array_in_tmp_flt = (float*) &array_in_tmp[stride_in*index];
-              for(j = 0; j < w_in; ++j)
-              {
-                array_in_tmp_flt[j] /= xyz_factor;
-              }
-            } else
-            if(data_type_in == oyDOUBLE)
-            {
-              array_in_tmp_dbl = (double*) &array_in_tmp[stride_in*index];
-              for(j = 0; j < w_in; ++j)
-              {
-                array_in_tmp_dbl[j] /= xyz_factor;
-              }
-            }
-            cmsDoTransform( ltw->lcm2, &array_in_tmp[stride_in*index],
-                                       array_out->array2d[k], n );
-          } else
-            cmsDoTransform( ltw->lcm2, array_in->array2d[k],
-                                       array_out->array2d[k], n );
-          if(array_out_tmp && use_xyz_scale)
-          {
-            if(data_type_out == oyFLOAT)
-            {
-              array_out_tmp_flt = (float*) array_out->array2d[k];
-              for(j = 0; j < w_out; ++j)
-                array_out_tmp_flt[j] *= xyz_factor;
-            } else
-            if(data_type_out == oyDOUBLE)
-            {
-              array_out_tmp_dbl = (double*) array_out->array2d[k];
-              for(j = 0; j < w_out; ++j)
-                array_out_tmp_dbl[j] *= xyz_factor;
-            }
-          }
-        }
-      } else
-        for( k = 0; k < array_out->height; ++k)
+        if(array_in_tmp && use_xyz_scale)
         {
-          if(array_in_tmp && use_xyz_scale)
+          line_in = &array_in_tmp[stride_in*index];
+          memcpy( line_in, array_in->array2d[k], w_in * bps_in );
+          /* lcms expects straight colours */
+          if(premultiplied)
+            oyPixelAlphaMultiply( line_in, pixel_layout_in, colours_in, n, 1 );
+          if(xyz_in && data_type_in == oyFLOAT)
           {
-            memcpy( array_in_tmp, array_in->array2d[k], w_in * bps_in );
-            if(data_type_in == oyFLOAT)
+            array_in_tmp_flt = (float*) line_in;
             for(j = 0; j < w_in; ++j)
-            {
               array_in_tmp_flt[j] /= xyz_factor;
-            }
-            if(data_type_in == oyDOUBLE)
+          } else
+          if(xyz_in && data_type_in == oyDOUBLE)
+          {
+            array_in_tmp_dbl = (double*) line_in;
             for(j = 0; j < w_in; ++j)
-            {
               array_in_tmp_dbl[j] /= xyz_factor;
-            }
-            cmsDoTransform( ltw->lcm2, array_in_tmp,
-                                       array_out->array2d[k], n );
+          }
+        }
+        if(dither)
+          line_out = &array_dither_tmp[stride_dither*index];
+
+        cmsDoTransform( ltw->lcm2, line_in, line_out, n );
+
+        if(array_out_tmp && use_xyz_scale)
+        {
+          if(data_type_out == oyFLOAT)
+          {
+            array_out_tmp_flt = (float*) line_out;
+            for(j = 0; j < w_out; ++j)
+              array_out_tmp_flt[j] *= xyz_factor;
           } else
-            cmsDoTransform( ltw->lcm2, array_in->array2d[k],
-                                       array_out->array2d[k], n );
-          if(array_out_tmp && use_xyz_scale)
+          if(data_type_out == oyDOUBLE)
           {
-            if(data_type_out == oyFLOAT)
-            {
-              array_out_tmp_flt = (float*) array_out->array2d[k];
-              for(j = 0; j < w_out; ++j)
-                array_out_tmp_flt[j] *= xyz_factor;
-            } else
-            if(data_type_out == oyDOUBLE)
-            {
-              array_out_tmp_dbl = (double*) array_out->array2d[k];
-              for(j = 0; j < w_out; ++j)
-                array_out_tmp_dbl[j] *= xyz_factor;
-            }
+            array_out_tmp_dbl = (double*) line_out;
+            for(j = 0; j < w_out; ++j)
+              array_out_tmp_dbl[j] *= xyz_factor;
           }
         }
+        if(alpha_copy)
+        {
+          oyPixelAlphaCopy( array_in->array2d[k], pixel_layout_in, colours_in,
+                            line_out, pixel_layout_xform, colours_out, n );
+          if(premultiplied)
+            oyPixelAlphaMultiply( line_out, pixel_layout_xform, colours_out,
+                                  n, 0 );
+        }
+        if(dither)
+          oyPixelDither16To8( (uint16_t*)line_out, array_out->array2d[k],
+                              channels, n, dither_x, dither_y + k );
+      }
     /*lcm2_msg(oyMSG_WARN,(oyStruct_s*)ticket, "%s: %d End width: %d",
             __FILE__,__LINE__, n);*/
     }
 
     if(array_in_tmp)
       oyDeAllocateFunc_( array_in_tmp );
+    if(array_dither_tmp)
+      oyDeAllocateFunc_( array_dither_tmp );
 
   } else
   {
@@ -2230,6 +2250,7 @@ char lcm2_extra_options[] = {
      <" "icc" ">\n\
       <cmyk_cmyk_black_preservation.advanced>0</cmyk_cmyk_black_preservation.advanced>\n\
       <precalculation.advanced>2</precalculation.advanced>\n\
+      <dither.advanced>0</dither.advanced>\n\
      </" "icc" ">\n\
     </" OY_TYPE_STD ">\n\
    </" OY_DOMAIN_INTERNAL ">\n\
@@ -2305,6 +2326,22 @@ int lcm2GetOptionsUI                 ( oyOptions_s        * options,
        </xf:item>\n\
       </xf:choices>\n\
      </xf:select1>\n");
+  A("\
+     <xf:select1 ref=\"/" OY_TOP_SHARED "/" OY_DOMAIN_INTERNAL "/" OY_TYPE_STD "/" "icc/dither\">\n\
+      <xf:label>" );
+  A(          _("Dithering"));
+  A(                              "</xf:label>\n\
+      <xf:choices>\n\
+       <xf:item>\n\
+        <xf:value>0</xf:value>\n\
+        <xf:label>none</xf:label>\n\
+       </xf:item>\n\
+       <xf:item>\n\
+        <xf:value>1</xf:value>\n\
+        <xf:label>ordered</xf:label>\n\
+       </xf:item>\n\
+      </xf:choices>\n\
+     </xf:select1>\n");
 
   if(allocateFunc && tmp)
   {
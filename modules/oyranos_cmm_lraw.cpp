@@ -29,6 +29,10 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
+#include <sys/stat.h>
+#if defined(HAVE_POSIX)
+#include <pthread.h>
+#endif
 
 #include <libraw.h>
 #include <libraw_types.h>
@@ -360,11 +364,395 @@ extern "C" {
 int              oyArray2d_ToPPM_    ( oyArray2d_s       * array,
                                        const char        * file_name ); }
 
+/* --- decoded image cache --- */
+
+/** the number of decoded raw images kept, most recently used first */
+#define LRAW_CACHE_MAX 2
+
+typedef struct {
+  char         * key;                  /**< file identity + decode options */
+  oyArray2d_s  * array;                /**< linear demosaiced samples */
+  int            spp;                  /**< samples per pixel */
+} lrawCacheEntry_s;
+
+static lrawCacheEntry_s lraw_cache_[LRAW_CACHE_MAX];
+
+/* concurrent loads reorder the cache */
+#if defined(HAVE_POSIX)
+static pthread_mutex_t lraw_cache_mutex_ = PTHREAD_MUTEX_INITIALIZER;
+#define lrawCacheLock_m()   pthread_mutex_lock( &lraw_cache_mutex_ )
+#define lrawCacheUnLock_m() pthread_mutex_unlock( &lraw_cache_mutex_ )
+#else
+#define lrawCacheLock_m()
+#define lrawCacheUnLock_m()
+#endif
+
+/** @internal
+ *  Function lrawDecodeKey_
+ *  @brief   identify a decoded raw image
+ *
+ *  The key covers the file path, size and modification time and all
+ *  parameters which influence unpacking and demosaicing. Colour related
+ *  settings are not part of it, as they are applied downstream.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/30 (Oyranos: 0.3.2)
+ *  @date    2011/09/30
+ */
+static char *    lrawDecodeKey_      ( const char        * filename,
+                                       libraw_output_params_t * params )
+{
+  char * key = 0;
+  struct stat st;
+
+  if(!filename || stat( filename, &st ) != 0)
+    return 0;
+
+  oyStringAddPrintf_( &key, oyAllocateFunc_, oyDeAllocateFunc_,
+                      "%s:%ld:%ld half_size=%d four_color_rgb=%d "
+                      "user_qual=%d use_camera_wb=%d output_bps=%d",
+                      filename, (long)st.st_size, (long)st.st_mtime,
+                      params->half_size, params->four_color_rgb,
+                      params->user_qual, params->use_camera_wb,
+                      params->output_bps );
+  return key;
+}
+
+/** @internal
+ *  Function lrawCacheGet_
+ *  @brief   look up a decoded raw image
+ *
+ *  A hit is moved to the front of the cache. The caller obtains a own
+ *  copy of the samples, as images are writable.
+ *
+ *  @return                            a array copy or zero
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/30 (Oyranos: 0.3.2)
+ *  @date    2011/09/30
+ */
+static oyArray2d_s * lrawCacheGet_   ( const char        * key,
+                                       int               * spp )
+{
+  int i, j;
+  oyArray2d_s * array = 0;
+
+  lrawCacheLock_m();
+  for(i = 0; key && i < LRAW_CACHE_MAX && lraw_cache_[i].key; ++i)
+    if(strcmp( lraw_cache_[i].key, key ) == 0)
+    {
+      lrawCacheEntry_s hit = lraw_cache_[i];
+      for(j = i; j > 0; --j)
+        lraw_cache_[j] = lraw_cache_[j-1];
+      lraw_cache_[0] = hit;
+      *spp = hit.spp;
+      array = oyArray2d_Copy( hit.array, hit.array->oy_ );
+      break;
+    }
+  lrawCacheUnLock_m();
+
+  return array;
+}
+
+/** @internal
+ *  Function lrawCachePut_
+ *  @brief   remember a decoded raw image
+ *
+ *  The least recently used entry is dropped. The cache keeps a copy of the
+ *  samples, which stays untouched by the image the array is handed to.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/30 (Oyranos: 0.3.2)
+ *  @date    2011/09/30
+ */
+static void      lrawCachePut_       ( const char        * key,
+                                       oyArray2d_s       * array,
+                                       int                 spp )
+{
+  int j;
+  lrawCacheEntry_s * last = &lraw_cache_[LRAW_CACHE_MAX-1];
+
+  if(!key || !array)
+    return;
+
+  lrawCacheLock_m();
+  if(last->key)
+    oyDeAllocateFunc_( last->key );
+  oyArray2d_Release( &last->array );
+
+  for(j = LRAW_CACHE_MAX-1; j > 0; --j)
+    lraw_cache_[j] = lraw_cache_[j-1];
+
+  lraw_cache_[0].key = oyStringCopy_( key, oyAllocateFunc_ );
+  lraw_cache_[0].array = oyArray2d_Copy( array, array->oy_ );
+  lraw_cache_[0].spp = spp;
+  lrawCacheUnLock_m();
+}
+
+/* --- embedded thumbnail preview --- */
+
+#ifdef HAVE_JPEG
+extern "C" {
+#include <jpeglib.h>
+}
+/* jpeg_mem_src() appeared with libjpeg 8 and libjpeg-turbo */
+#if JPEG_LIB_VERSION < 80 && !defined(MEM_SRCDST_SUPPORTED)
+#undef HAVE_JPEG
+#endif
+#endif
+
+#ifdef HAVE_JPEG
+#include <csetjmp>
+
+typedef struct {
+  struct jpeg_error_mgr pub;
+  jmp_buf        jmp;
+} lrawJpegError_s;
+
+static void      lrawJpegErrorExit_  ( j_common_ptr        cinfo )
+{
+  lrawJpegError_s * err = (lrawJpegError_s*) cinfo->err;
+  char text[JMSG_LENGTH_MAX];
+
+  (*cinfo->err->format_message)( cinfo, text );
+  message( oyMSG_WARN, 0, OY_DBG_FORMAT_ " libjpeg: %s", OY_DBG_ARGS_, text );
+  longjmp( err->jmp, 1 );
+}
+
+/** @internal
+ *  Function lrawJpegDecode_
+ *  @brief   decode a in memory JPEG thumbnail
+ *
+ *  A embedded ICC profile from the APP2 markers is returned in prof.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/03 (Oyranos: 0.3.2)
+ *  @date    2011/10/03
+ */
+static oyArray2d_s * lrawJpegDecode_ ( const unsigned char * data,
+                                       size_t              size,
+                                       int               * width,
+                                       int               * height,
+                                       int               * spp,
+                                       oyProfile_s      ** prof )
+{
+  struct jpeg_decompress_struct cinfo;
+  lrawJpegError_s jerr;
+  oyArray2d_s * volatile array = 0;
+  jpeg_saved_marker_ptr m;
+  size_t icc_size = 0;
+  unsigned char * icc = 0;
+
+  cinfo.err = jpeg_std_error( &jerr.pub );
+  jerr.pub.error_exit = lrawJpegErrorExit_;
+
+  if(setjmp( jerr.jmp ))
+  {
+    jpeg_destroy_decompress( &cinfo );
+    oyArray2d_Release( (oyArray2d_s**)&array );
+    return 0;
+  }
+
+  jpeg_create_decompress( &cinfo );
+  jpeg_mem_src( &cinfo, (unsigned char*)data, size );
+  jpeg_save_markers( &cinfo, JPEG_APP0 + 2, 0xFFFF );
+  jpeg_read_header( &cinfo, TRUE );
+
+  /* "ICC_PROFILE\0" + sequence number + count; chunks are in file order */
+  for(m = cinfo.marker_list; m; m = m->next)
+    if(m->marker == JPEG_APP0 + 2 && m->data_length > 14 &&
+       memcmp( m->data, "ICC_PROFILE", 12 ) == 0)
+      icc_size += m->data_length - 14;
+  if(icc_size)
+    icc = (unsigned char*) oyAllocateFunc_( icc_size );
+  if(icc)
+  {
+    size_t pos = 0;
+    for(m = cinfo.marker_list; m; m = m->next)
+      if(m->marker == JPEG_APP0 + 2 && m->data_length > 14 &&
+         memcmp( m->data, "ICC_PROFILE", 12 ) == 0)
+      {
+        memcpy( &icc[pos], m->data + 14, m->data_length - 14 );
+        pos += m->data_length - 14;
+      }
+    *prof = oyProfile_FromMem( icc_size, icc, 0, 0 );
+    oyDeAllocateFunc_( icc );
+  }
+
+  cinfo.out_color_space = cinfo.num_components == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  /* a preview needs no accurate IDCT */
+  cinfo.dct_method = JDCT_IFAST;
+  jpeg_start_decompress( &cinfo );
+
+  *width = cinfo.output_width;
+  *height = cinfo.output_height;
+  *spp = cinfo.output_components;
+  array = oyArray2d_Create( NULL, *width * *spp, *height, oyUINT8, 0 );
+
+  while(array && cinfo.output_scanline < cinfo.output_height)
+  {
+    JSAMPROW row = (JSAMPROW) array->array2d[cinfo.output_scanline];
+    jpeg_read_scanlines( &cinfo, &row, 1 );
+  }
+
+  jpeg_finish_decompress( &cinfo );
+  jpeg_destroy_decompress( &cinfo );
+
+  return array;
+}
+#endif /* HAVE_JPEG */
+
+/** @internal
+ *  Function lrawPreview_
+ *  @brief   obtain the camera generated thumbnail of a RAW file
+ *
+ *  JPEG thumbnails carry either a embedded profile or are described by the
+ *  EXIF colour space, sRGB or Adobe RGB. Bitmap thumbnails are sRGB.
+ *  Without libjpeg only bitmap thumbnails are served.
+ *
+ *  @return                            a image or zero for a full decode
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/03 (Oyranos: 0.3.2)
+ *  @date    2011/10/03
+ */
+static oyImage_s * lrawPreview_      ( LibRaw            & rip,
+                                       const char        * filename,
+                                       oyFilterNode_s    * node )
+{
+  oyImage_s * image = 0;
+  oyArray2d_s * array = 0;
+  oyProfile_s * prof = 0;
+  oyDATATYPE_e data_type = oyUINT8;
+  libraw_processed_image_t * thumb = 0;
+  int width = 0, height = 0, spp = 0, h;
+  int error = rip.open_file( filename );
+  double clck = oyClock();
+
+  if(!error)
+    error = rip.unpack_thumb();
+  if(!error)
+    thumb = rip.dcraw_make_mem_thumb( &error );
+
+  if(!thumb)
+  {
+    message( oyMSG_DBG, (oyStruct_s*)node,
+             OY_DBG_FORMAT_ " no thumbnail in: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
+    return 0;
+  }
+
+  if(thumb->type == LIBRAW_IMAGE_BITMAP)
+  {
+    int byteps = thumb->bits == 16 ? 2 : 1;
+    size_t row_size;
+
+    width = thumb->width;
+    height = thumb->height;
+    spp = thumb->colors;
+    row_size = (size_t)width * spp * byteps;
+    if(byteps == 2)
+      data_type = oyUINT16;
+
+    if(row_size * height <= thumb->data_size)
+      array = oyArray2d_Create( NULL, width * spp, height, data_type, 0 );
+    for(h = 0; array && h < height; ++h)
+      memcpy( array->array2d[h], &thumb->data[h * row_size], row_size );
+  }
+#ifdef HAVE_JPEG
+  else if(thumb->type == LIBRAW_IMAGE_JPEG)
+    array = lrawJpegDecode_( thumb->data, thumb->data_size,
+                             &width, &height, &spp, &prof );
+#endif
+
+  LibRaw::dcraw_clear_mem( thumb );
+
+  if(!array)
+  {
+    oyProfile_Release( &prof );
+    return 0;
+  }
+
+  if(!prof)
+  {
+#if defined(LIBRAW_COMPILE_CHECK_VERSION_NOTLESS)
+#if LIBRAW_COMPILE_CHECK_VERSION_NOTLESS(0,20)
+    if(rip.imgdata.color.ExifColorSpace == LIBRAW_COLORSPACE_AdobeRGB)
+      prof = oyProfile_FromFile( "compatibleWithAdobeRGB1998.icc", 0, 0 );
+#endif
+#endif
+    if(!prof)
+      prof = oyProfile_FromStd( spp < 3 ? oyASSUMED_GRAY : oyASSUMED_WEB, 0 );
+  }
+
+  image = oyImage_Create( width, height, array->array2d[0],
+                          oyChannels_m(spp) | oyDataType_m(data_type),
+                          prof, 0 );
+  if(image)
+  {
+    oyImage_DataSet( image, (oyStruct_s**)&array, 0,0,0,0,0,0 );
+    oyOptions_SetFromText( &image->tags,
+                           "//" OY_TYPE_STD OY_SLASH CMM_NICK "/preview",
+                           "1", OY_CREATE_NEW );
+  }
+  oyArray2d_Release( &array );
+  oyProfile_Release( &prof );
+
+  clck = oyClock() - clck;
+  DBG_NUM1_S("thumbnail: %g", clck/1000000.0 );
+
+  return image;
+}
+
+/** @internal
+ *  Function lrawImageServe_
+ *  @brief   hand a read image to the graph
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/03 (Oyranos: 0.3.2)
+ *  @date    2011/10/03
+ */
+static int       lrawImageServe_     ( oyImage_s        ** image,
+                                       const char        * filename,
+                                       oyFilterSocket_s  * socket,
+                                       oyPixelAccess_s   * ticket )
+{
+  oyImage_s * image_in = *image;
+  int error = oyOptions_SetFromText( &image_in->tags,
+                              "//" OY_TYPE_STD OY_SLASH CMM_NICK "/filename",
+                                 filename, OY_CREATE_NEW );
+
+  if(error <= 0)
+  {
+    socket->data = (oyStruct_s*)oyImage_Copy( image_in, 0 );
+  }
+
+  if(ticket &&
+     ticket->output_image &&
+     ticket->output_image->width == 0 &&
+     ticket->output_image->height == 0)
+  {
+    ticket->output_image->width = image_in->width;
+    ticket->output_image->height = image_in->height;
+    oyImage_SetCritical( ticket->output_image, image_in->layout_[0], 0,0 );
+  }
+
+  oyImage_Release( image );
+
+  /* return an error to cause the graph to retry */
+  return 1;
+}
+
 /** Function lrawFilterPlug_ImageInputRAWRun
  *  @brief   implement oyCMMFilter_GetNext_f()
  *
- *  @version Oyranos: 0.1.10
- *  @date    2009/06/14
+ *  The option "half_size" selects between fast half size and full size
+ *  demosaicing. Decoded images are cached by file identity and decode
+ *  options; a rerun, e.g. after changed colour settings, skips libraw.
+ *  The option "preview" serves the embedded camera thumbnail, if any.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @date    2011/10/03
  *  @since   2009/06/14 (Oyranos: 0.1.10)
  */
 int      lrawFilterPlug_ImageInputRAWRun (
@@ -380,12 +768,14 @@ int      lrawFilterPlug_ImageInputRAWRun (
   oyProfile_s * prof = 0;
   oyImage_s * image_in = 0;
   oyPixel_t pixel_type = 0;
-  uint8_t * buf = 0;
+  oyArray2d_s * array = 0;
   size_t  mem_n = 0;   /* needed memory in bytes */
+  char * key = 0;
+  int32_t half_size = 1;
+  int32_t preview = 0;
 
   int info_good = 1;
 
-  int type = 0;        /* PNM type */
   int width = 0;
   int height = 0;
   int spp = 0;         /* samples per pixel */
@@ -405,10 +795,6 @@ int      lrawFilterPlug_ImageInputRAWRun (
           params->output_color, params->output_bps, params->no_auto_bright,
           params->gamm[0], params->gamm[1]);
 
-  /* render at half size */
-  params->half_size = 1;
-  params->four_color_rgb = 1;
-
   /* passing through the data reading */
   if(requestor_plug->type_ == oyOBJECT_FILTER_PLUG_S &&
      requestor_plug->remote_socket_->data)
@@ -437,22 +823,22 @@ int      lrawFilterPlug_ImageInputRAWRun (
   if(error <= 0)
     filename = oyOptions_FindString( node->core->options_, "filename", 0 );
 
-  if(filename)
-    error = rip.open_file( filename );
+  /* the camera thumbnail, for fast browsing */
+  oyOptions_FindInt( node->core->options_, "preview", 0, &preview );
 
-  if(error)
+  if(preview && filename)
   {
-    message( oyMSG_WARN, (oyStruct_s*)node,
-             OY_DBG_FORMAT_ " could not open: %s",
-             OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
-    return 1;
+    image_in = lrawPreview_( rip, filename, node );
+    if(image_in)
+      return lrawImageServe_( &image_in, filename, socket, ticket );
+    rip.recycle();
   }
 
-  double clck = oyClock();
-  error = rip.unpack();
-  clck = oyClock() - clck;
-  DBG_NUM1_S("rip.unpack(): %g", clck/1000000.0 );
+  /* render at half size, unless full size demosaicing is requested */
+  oyOptions_FindInt( node->core->options_, "half_size", 0, &half_size );
 
+  params->half_size = half_size ? 1 : 0;
+  params->four_color_rgb = 1;
   params->output_color = 0;    /* raw_color */
   params->output_bps = 16;     /* linear space */
   params->gamm[0] = 1.0; params->gamm[1] = 1.0;
@@ -463,6 +849,42 @@ int      lrawFilterPlug_ImageInputRAWRun (
   int render = oyOptions_FindString( node->core->options_, "render", "0" ) == NULL ? 1 : 0;
 
   if(render)
+  {
+    key = lrawDecodeKey_( filename, params );
+    array = lrawCacheGet_( key, &spp );
+  }
+
+  if(array)
+  {
+    data_type = array->t;
+    byteps = oySizeofDatatype( data_type );
+    width = array->width / spp;
+    height = array->height;
+    DBG_NUM1_S("reuse decoded image: %s", key );
+  }
+
+  if(filename && !array)
+    error = rip.open_file( filename );
+
+  if(error)
+  {
+    message( oyMSG_WARN, (oyStruct_s*)node,
+             OY_DBG_FORMAT_ " could not open: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
+    if(key) oyDeAllocateFunc_( key );
+    return 1;
+  }
+
+  double clck = 0;
+  if(!array)
+  {
+    clck = oyClock();
+    error = rip.unpack();
+    clck = oyClock() - clck;
+    DBG_NUM1_S("rip.unpack(): %g", clck/1000000.0 );
+  }
+
+  if(render && !array)
   {
     clck = oyClock();
     error = rip.dcraw_process();
@@ -470,7 +892,7 @@ int      lrawFilterPlug_ImageInputRAWRun (
     DBG_NUM1_S("rip.dcraw_process(): %g", clck/1000000.0 );
   }
 
-  if(render)
+  if(render && !array)
   {
     clck = oyClock();
     image_rgb = rip.dcraw_make_mem_image();
@@ -489,12 +911,12 @@ int      lrawFilterPlug_ImageInputRAWRun (
       data_type = oyUINT16;
       byteps = 2;
       maxval = 65535;
-      message( oyMSG_WARN, (oyStruct_s*)node,
+      message( oyMSG_DBG, (oyStruct_s*)node,
              OY_DBG_FORMAT_ " maxval: %g",
              OY_DBG_ARGS_, maxval );
     }
 
-  } else
+  } else if(!array)
   {
     info_good = 0;
   }
@@ -502,20 +924,12 @@ int      lrawFilterPlug_ImageInputRAWRun (
     switch(spp)
     {
       case 1:
-           profile_type = oyASSUMED_GRAY;
-           type = 5;
-           break;
       case 2:
            profile_type = oyASSUMED_GRAY;
-           type = 5;
            break;
       case 3:
-           profile_type = oyASSUMED_RGB;
-           type = 6;
-           break;
       case 4:
            profile_type = oyASSUMED_RGB;
-           type = 6;
            break;
     }
 
@@ -525,6 +939,7 @@ int      lrawFilterPlug_ImageInputRAWRun (
     message( oyMSG_WARN, (oyStruct_s*)node,
              OY_DBG_FORMAT_ "failed to get info of %s",
              OY_DBG_ARGS_, oyNoEmptyString_m_( filename ));
+    if(key) oyDeAllocateFunc_( key );
     return FALSE;
   }
 
@@ -533,93 +948,52 @@ int      lrawFilterPlug_ImageInputRAWRun (
   if( image_rgb )
     error = mem_n != image_rgb->data_size;
 
-  if(info_good)
-    oyAllocHelper_m_( buf, uint8_t, mem_n, 0, return 1);
-
-  /* the following code is almost completely taken from ku.b's ppm CP plug-in */
-  /* ... and then copied from the input_ppm Oyranos filter */
-  if(info_good)
+  if(image_rgb && !error)
   {
-    int h, j_h = 0, p, n_samples, n_bytes;
-    int byte_swap = 0; /*!oyBigEndian();*/
-    unsigned char *d_8 = 0;
-    unsigned char *src = image_rgb->data;
+    array = oyArray2d_Create( NULL, width * spp, height, data_type, 0 );
+    if(!array)
+      error = 1;
+  }
 
-    uint16_t *d_16;
-    float  *d_f;
+  /* copy and normalise the libraw rows; each row is independent */
+  if(image_rgb && array)
+  {
+    int h;
+    const int n_samples = width * spp;
+    const size_t row_size = (size_t)n_samples * byteps;
+    const unsigned char * src = image_rgb->data;
+    unsigned char ** rows = (unsigned char**) array->array2d;
 
+    clck = oyClock();
 #pragma omp parallel for
     for(h = 0; h < height; ++h)
     {
-        n_samples = 1 * width * spp;
-        n_bytes = n_samples * byteps;
-
-        d_8  = buf;
-        d_16 = (uint16_t*)buf;
-        d_f  = (float*)buf;
-
-        /*  TODO 1 bit raw and ascii */
-        if (type == 1 || type == 4) {
-
-        /*  TODO ascii  */
-        } else if (type == 2 || type == 3) {
-
-
-        /*  raw and floats */
-        } else if (type == 5 || type == 6 ||
-                   type == -5 || type == -6 ||
-                   type == 7 )
-        {
-          if(byteps == 1) {
-            d_8 = &src[ h * width * spp * byteps ];
-          } else if(byteps == 2) {
-            d_16 = (uint16_t*)& src[ h * width * spp * byteps ];
-          } else if(byteps == 4) {
-            d_f = (float*)&src[ h * width * spp * byteps ];
-          }
-          memcpy (&buf[ h * width * spp * byteps ],
-                  &src[ (j_h + h) * width * spp * byteps ],
-                  1 * width * spp * byteps);
-        }
-
-        /* normalise and byteswap */
-        if( byte_swap )
-        {
-          unsigned char *c_buf = &buf[ h * width * spp * byteps ];
-          char  tmp;
-          if (byteps == 2) {         /* 16 bit */
-            for (p = 0; p < n_bytes; p += 2)
-            {
-              tmp = c_buf[p];
-              c_buf[p] = c_buf[p+1];
-              c_buf[p+1] = tmp;
-            }
-          } else if (byteps == 4) {  /* float */
-            for (p = 0; p < n_bytes; p += 4)
-            {
-              tmp = c_buf[p];
-              c_buf[p] = c_buf[p+3];
-              c_buf[p+3] = tmp;
-              tmp = c_buf[p+1];
-              c_buf[p+1] = c_buf[p+2];
-              c_buf[p+2] = tmp;
-            }
-          }
-        }
-
-        if (byteps == 1 && maxval < 255) {         /*  8 bit */
-          for (p = 0; p < n_samples; ++p)
-            d_8[p] = (d_8[p] * 255) / maxval;
-        } else if (byteps == 2 && maxval < 65535) {/* 16 bit */
-          for (p = 0; p < n_samples; ++p)
-            d_16 [p] = (d_16[p] * 65535) / maxval;
-        } else if (byteps == 4 && maxval != 1.0) {  /* float */
-          for (p = 0; p < n_samples; ++p)
-            d_f[p] = d_f[p] * maxval;
-        }
+      int p;
+      unsigned char * d_8 = rows[h];
+      uint16_t * d_16 = (uint16_t*) rows[h];
+
+      memcpy( d_8, &src[h * row_size], row_size );
+
+      if (byteps == 1 && maxval < 255) {         /*  8 bit */
+        for (p = 0; p < n_samples; ++p)
+          d_8[p] = (d_8[p] * 255) / maxval;
+      } else if (byteps == 2 && maxval < 65535) {/* 16 bit */
+        for (p = 0; p < n_samples; ++p)
+          d_16[p] = (d_16[p] * 65535) / maxval;
+      }
     }
+    clck = oyClock() - clck;
+    DBG_NUM1_S("copy rows: %g", clck/1000000.0 );
+
+    lrawCachePut_( key, array, spp );
   }
 
+  if(image_rgb)
+    LibRaw::dcraw_clear_mem( image_rgb );
+  image_rgb = 0;
+  if(key) oyDeAllocateFunc_( key );
+  key = 0;
+
   pixel_type = oyChannels_m(spp) | oyDataType_m(data_type);
   int32_t n = 0;
   error = oyOptions_Filter( &options, &n, 0,
@@ -637,8 +1011,12 @@ int      lrawFilterPlug_ImageInputRAWRun (
              OY_DBG_ARGS_,  t?t:"---" );
   }
 
-  image_in = oyImage_Create( width, height, buf, pixel_type, prof, 0 );
-  buf = 0;
+  /* hand over the decoded samples; the image holds its own array reference */
+  image_in = oyImage_Create( width, height, array ? array->array2d[0] : 0,
+                             pixel_type, prof, 0 );
+  if(image_in && array)
+    oyImage_DataSet( image_in, (oyStruct_s**)&array, 0,0,0,0,0,0 );
+  oyArray2d_Release( &array );
 
   if(oyOptions_FindString( node->core->options_, "device", "1" ) != NULL)
   {
@@ -659,33 +1037,10 @@ int      lrawFilterPlug_ImageInputRAWRun (
       message( oyMSG_WARN, (oyStruct_s*)node,
              OY_DBG_FORMAT_ "libraw can't create a new image\n%dx%d %d",
              OY_DBG_ARGS_,  width, height, pixel_type );
-      oyFree_m_ (buf)
     return FALSE;
   }
 
-  error = oyOptions_SetFromText( &image_in->tags,
-                              "//" OY_TYPE_STD OY_SLASH CMM_NICK "/filename",
-                                 filename, OY_CREATE_NEW );
-
-  if(error <= 0)
-  {
-    socket->data = (oyStruct_s*)oyImage_Copy( image_in, 0 );
-  }
-
-  if(ticket &&
-     ticket->output_image &&
-     ticket->output_image->width == 0 &&
-     ticket->output_image->height == 0)
-  {
-    ticket->output_image->width = image_in->width;
-    ticket->output_image->height = image_in->height;
-    oyImage_SetCritical( ticket->output_image, image_in->layout_[0], 0,0 );
-  }
-
-  oyImage_Release( &image_in );
-
-  /* return an error to cause the graph to retry */
-  return 1;
+  return lrawImageServe_( &image_in, filename, socket, ticket );
 }
 
 const char lraw_extra_options[] = {
@@ -709,7 +1064,10 @@ const char lraw_extra_options[] = {
       <four_color_rgb.advanced>0</four_color_rgb.advanced>\n\
      </" CMM_NICK ">\n\
      <" CMM_NICK ">\n\
-      <half_size.advanced>0</half_size.advanced>\n\
+      <half_size.advanced>1</half_size.advanced>\n\
+     </" CMM_NICK ">\n\
+     <" CMM_NICK ">\n\
+      <preview.advanced>0</preview.advanced>\n\
      </" CMM_NICK ">\n\
      <" CMM_NICK ">\n\
       <highlight.advanced>0</highlight.advanced>\n\
@@ -853,7 +1211,9 @@ const char * oyraApi4UiImageInputLibrawGetText (
                "with value \"1\" requestests a oyConfig_s object containing "
                "typical device informations about the cameraRAW file. "
                "The option \"render\" with value \"0\" will skip some of the "
-               "data processing.");
+               "data processing. The option \"half_size\" with value \"0\" "
+               "demosaics at full resolution. The option \"preview\" with "
+               "value \"1\" returns the embedded camera thumbnail instead.");
   }
   return 0;
 }
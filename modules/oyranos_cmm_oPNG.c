@@ -177,199 +177,334 @@ oyOptions_s* oPNGFilter_ImageOutputPNGValidateOptions
   return 0;
 }
 
-/** @func    oPNGFilterPlug_ImageOutputPNGWrite
- *  @brief   implement oyCMMFilter_GetNext_f()
+/* PNG filter type selection for the "filter" option */
+static int oPNG_filter_masks_[6] = { PNG_FILTER_NONE, PNG_FILTER_SUB,
+                                     PNG_FILTER_UP, PNG_FILTER_AVG,
+                                     PNG_FILTER_PAETH, PNG_ALL_FILTERS };
+
+/** @func    oyImage_WritePNG
+ *  @brief   encode a image into a PNG file
  *
- *  @version Oyranos: 0.1.8
- *  @since   2008/10/07 (Oyranos: 0.1.8)
- *  @date    2009/02/18
+ *  The rows are passed directly to png_write_rows(). If array covers the
+ *  whole image in the image data type, its lines are used without copy.
+ *  Otherwise the rows are obtained from oyImage_s::getLine. Floating point
+ *  samples are converted to 16-bit, as PNG has no floating point encoding.
+ *
+ *  Options:
+ *  - "compression" - zlib level 0-9, -1 for the libpng default
+ *  - "filter" - 0 none, 1 sub, 2 up, 3 average, 4 paeth, 5 adaptive,
+ *               -1 for the libpng default
+ *  - "embed_profile" - 1 write the image profile as iCCP chunk
+ *  - "interlace" - 1 write Adam7 interlaced for progressive display
+ *
+ *  @param[in]     image               the image to encode
+ *  @param[in]     array               optional pixel rows of image
+ *  @param[in]     filename            the file to write to
+ *  @param[in]     options             the above options
+ *  @param[in]     object              the calling object for messages
+ *  @return                            error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/23 (Oyranos: 0.3.2)
+ *  @date    2011/09/23
  */
-int      oPNGFilterPlug_ImageOutputPNGWrite (
-                                       oyFilterPlug_s    * requestor_plug,
-                                       oyPixelAccess_s   * ticket )
+int          oyImage_WritePNG        ( oyImage_s         * image,
+                                       oyArray2d_s       * array,
+                                       const char        * filename,
+                                       oyOptions_s       * options,
+                                       oyStruct_s        * object )
 {
-  oyFilterSocket_s * socket = requestor_plug->remote_socket_;
-  oyFilterPlug_s * plug = 0;
-  oyFilterNode_s * input_node = 0,
-                 * node = 0;
-  int result = 0;
-  const char * filename = 0;
   FILE * fp = 0;
+  png_structp png_ptr = 0;
+  png_infop info_ptr = 0;
+  int error = !image || !filename;
+  int32_t compression = -1,
+          filter = -1,
+          embed_profile = 1,
+          interlace = 0;
+  int channels = 0, cchan_n = 0, alpha, byteps = 0, color_type = 0,
+      width = 0, height = 0, n = 0, y, i, pass, passes;
+  oyDATATYPE_e data_type = oyUINT8;
+  png_bytep * rows = 0;
+  uint16_t * buf = 0;
+  oyPointer icc = 0;
+  size_t icc_size = 0;
+  const char * icc_name = 0;
+  char * vs = 0;
+  png_text text;
+  /* a allocated image line survives a longjmp() only in a volatile */
+  uint8_t * volatile line_allocated = 0;
 
-  node = socket->node;
-  plug = (oyFilterPlug_s *)node->plugs[0];
-  input_node = plug->remote_socket_->node;
+  if(!error)
+  {
+    channels = oyToChannels_m( image->layout_[0] );
+    data_type = oyToDataType_m( image->layout_[0] );
+    byteps = oySizeofDatatype( data_type );
+    cchan_n = oyProfile_GetChannelsCount( image->profile_ );
+    alpha = channels - cchan_n;
+    width = image->width;
+    height = image->height;
+    n = width * channels;
+
+    if(cchan_n == 1 && alpha == 0)
+      color_type = PNG_COLOR_TYPE_GRAY;
+    else if(cchan_n == 1 && alpha == 1)
+      color_type = PNG_COLOR_TYPE_GRAY_ALPHA;
+    else if(cchan_n == 3 && alpha == 0)
+      color_type = PNG_COLOR_TYPE_RGB;
+    else if(cchan_n == 3 && alpha == 1)
+      color_type = PNG_COLOR_TYPE_RGB_ALPHA;
+    else
+    {
+      message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " can not encode %d colour + %d alpha channels",
+             OY_DBG_ARGS_, cchan_n, alpha );
+      error = 1;
+    }
 
-  /* to reuse the requestor_plug is a exception for the starting request */
-  result = input_node->api7_->oyCMMFilterPlug_Run( plug, ticket );
+    if(!(data_type == oyUINT8 || data_type == oyUINT16 ||
+         data_type == oyFLOAT || data_type == oyDOUBLE))
+    {
+      message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " data type not supported: %d",
+             OY_DBG_ARGS_, data_type );
+      error = 1;
+    }
+  }
 
-  if(result <= 0)
-    filename = oyOptions_FindString( node->core->options_, "filename", 0 );
+  if(!error)
+  {
+    oyOptions_FindInt( options, "compression", 0, &compression );
+    oyOptions_FindInt( options, "filter", 0, &filter );
+    oyOptions_FindInt( options, "embed_profile", 0, &embed_profile );
+    oyOptions_FindInt( options, "interlace", 0, &interlace );
+
+    /* all memory is obtained before setjmp() to keep the error path simple */
+    if(array && array->t == data_type &&
+       array->width >= n && array->height >= height)
+      rows = (png_bytep*) array->array2d;
+    else
+      oyAllocHelper_m_( rows, png_bytep, height, oyAllocateFunc_,
+                        error = 1 );
+    if(!error && byteps > 2)
+      oyAllocHelper_m_( buf, uint16_t, n, oyAllocateFunc_, error = 1 );
 
-  if(filename)
+#if defined(PNG_iCCP_SUPPORTED)
+    if(!error && embed_profile)
+    {
+      icc = oyProfile_GetMem( image->profile_, &icc_size, 0, oyAllocateFunc_ );
+      icc_name = oyProfile_GetText( image->profile_, oyNAME_DESCRIPTION );
+      if(!icc_name || !icc_name[0])
+        icc_name = "ICC profile";
+    }
+#endif
+    vs = oyVersionString(1,oyAllocateFunc_);
+  }
+
+  if(!error)
+  {
     fp = fopen( filename, "wb" );
+    if(!fp)
+    {
+      message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " could not open: %s",
+             OY_DBG_ARGS_, filename );
+      error = 1;
+    }
+  }
 
-  if(fp)
+  if(!error)
   {
-      size_t pt = 0;
-      char text[128];
-      int  len = 0;
-      int  i,j,k,l, n;
-      char bytes[48];
-      oyImage_s *image_output = (oyImage_s*)socket->data;
-
-      int cchan_n = oyProfile_GetChannelsCount( image_output->profile_ );
-      int channels = oyToChannels_m( image_output->layout_[0] );
-      oyDATATYPE_e data_type = oyToDataType_m( image_output->layout_[0] );
-      int alpha = channels - cchan_n;
-      int byteps = oySizeofDatatype( data_type );
-      const char * colourspacename = oyProfile_GetText( image_output->profile_,
-                                                        oyNAME_DESCRIPTION );
-      char * vs = oyVersionString(1,malloc);
-      uint8_t * out_values = 0;
-      const uint8_t * u8;
-      double * dbls;
-      float flt;
-
-            fputc( 'P', fp );
-      if(alpha) 
-            fputc( '7', fp );
-      else
-      {
-        if(byteps == 1 ||
-           byteps == 2)
-        {
-          if(channels == 1)
-            fputc( '5', fp );
-          else
-            fputc( '6', fp );
-        } else
-        if (byteps == 4 || byteps == 8)
-        {
-          if(channels == 1)
-            fputc( 'f', fp ); /* PFM gray */
-          else
-            fputc( 'F', fp ); /* PFM rgb */
-        }
-      }
+    png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING,
+                                       (png_voidp)filename,
+                                       oPNGerror, oPNGwarn );
+    if(png_ptr)
+      info_ptr = png_create_info_struct( png_ptr );
+    if(!info_ptr)
+    {
+      png_destroy_write_struct( &png_ptr, (png_infopp)NULL );
+      error = 1;
+    }
+  }
 
-      fputc( '\n', fp );
+  if(!error && setjmp(png_jmpbuf(png_ptr)))
+  {
+    if(line_allocated)
+      image->oy_->deallocateFunc_( line_allocated );
+    png_destroy_write_struct( &png_ptr, &info_ptr );
+    error = 1;
+    goto png_write_clean;
+  }
 
-      snprintf( text, 128, "# CREATOR: Oyranos-%s " CMM_NICK "\"%s\"\n",
-                oyNoEmptyString_m_(vs), node->relatives_ );
-      if(vs) free(vs); vs = 0;
-      len = strlen( text );
-      do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
+  if(!error)
+  {
+    png_init_io( png_ptr, fp );
+#if defined(PNG_BENIGN_ERRORS_SUPPORTED)
+    /* a profile, which libpng dislikes, shall not stop the image */
+    png_set_benign_errors( png_ptr, 1 );
+#endif
 
-      {
-        time_t  cutime;         /* Time since epoch */
-        struct tm       *gmt;
-        char time_str[24];
-
-        cutime = time(NULL); /* time right NOW */
-        gmt = gmtime(&cutime);
-        strftime(time_str, 24, "%Y/%m/%d %H:%M:%S", gmt);
-        snprintf( text, 128, "# DATE/TIME: %s\n", time_str );
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
-      }
+    if(0 <= compression && compression <= 9)
+      png_set_compression_level( png_ptr, compression );
+    if(0 <= filter && filter <= 5)
+      png_set_filter( png_ptr, PNG_FILTER_TYPE_BASE,
+                      oPNG_filter_masks_[filter] );
 
-      snprintf( text, 128, "# COLORSPACE: %s\n", colourspacename ?
-                colourspacename : "--" );
-      len = strlen( text );
-      do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
+    png_set_IHDR( png_ptr, info_ptr, width, height, byteps == 1 ? 8 : 16,
+                  color_type,
+                  interlace ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
+                  PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE );
 
-      if(byteps == 1)
-        snprintf( bytes, 48, "255" );
-      else
-      if(byteps == 2)
-        snprintf( bytes, 48, "65535" );
-      else
-      if (byteps == 4 || byteps == 8) 
-      {
-        if(oyBigEndian())
-          snprintf( bytes, 48, "1.0" );
-        else
-          snprintf( bytes, 48, "-1.0" );
-      }
-      else
-        message( oyMSG_WARN, (oyStruct_s*)node,
-             OY_DBG_FORMAT_ " byteps: %d",
-             OY_DBG_ARGS_, byteps );
+#if defined(PNG_iCCP_SUPPORTED)
+    if(icc && icc_size)
+# if PNG_LIBPNG_VER < 10500
+      png_set_iCCP( png_ptr, info_ptr, (png_charp)icc_name,
+                    PNG_COMPRESSION_TYPE_BASE, (png_charp)icc, icc_size );
+# else
+      png_set_iCCP( png_ptr, info_ptr, icc_name,
+                    PNG_COMPRESSION_TYPE_BASE, (png_const_bytep)icc, icc_size );
+# endif
+#endif
 
+    memset( &text, 0, sizeof(text) );
+    text.compression = PNG_TEXT_COMPRESSION_NONE;
+    text.key = (png_charp)"Software";
+    text.text = (png_charp)(vs ? vs : "Oyranos");
+    png_set_text( png_ptr, info_ptr, &text, 1 );
 
-      if(alpha)
-      {
-        const char *tupl = "RGB_ALPHA";
+    png_write_info( png_ptr, info_ptr );
 
-        if(channels == 2)
-          tupl = "GRAYSCALE_ALPHA";
-        snprintf( text, 128, "WIDTH %d\nHEIGHT %d\nDEPTH %d\nMAXVAL "
-                  "%s\nTUPLTYPE %s\nENDHDR\n",
-                  image_output->width, image_output->height,
-                  channels, bytes, tupl );
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
+    if(byteps > 1 && !oyBigEndian())
+      png_set_swap( png_ptr );
 
-      }
+    /* Adam7 needs all rows once per pass */
+    passes = png_set_interlace_handling( png_ptr );
+    for( pass = 0; pass < passes; ++pass )
+    {
+      if(array && rows == (png_bytep*) array->array2d && byteps <= 2)
+        /* the whole image in one call */
+        png_write_rows( png_ptr, rows, height );
       else
+      for( y = 0; y < height; )
       {
-        snprintf( text, 128, "%d %d\n", image_output->width,
-                                       image_output->height);
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
-
-        snprintf( text, 128, "%s\n", bytes );
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
-      }
+        int lines = 0,
+            is_allocated = 0;
+        uint8_t * line = 0;
 
-      n = image_output->width * channels;
-      if(byteps == 8)
-        u8 = (uint8_t*) &flt;
+        if(array && rows == (png_bytep*) array->array2d)
+        {
+          line = array->array2d[y];
+          lines = 1;
+        } else
+          line = image->getLine( image, y, &lines, -1, &is_allocated );
+        if(is_allocated)
+          line_allocated = line;
 
-      for( k = 0; k < image_output->height; ++k)
-      {
-        int height = 0,
-            is_allocated = 0;
-        out_values = image_output->getLine( image_output, k, &height, -1, 
-                                            &is_allocated );
-        len = n * byteps;
+        if(!line || lines <= 0)
+          png_error( png_ptr, "no image line" );
+        if(y + lines > height)
+          lines = height - y;
 
-        for( l = 0; l < height; ++l )
+        if(byteps > 2)
         {
-          if(byteps == 8)
+          /* PNG has no floating point encoding; write 16-bit */
+          for( i = 0; i < lines; ++i )
           {
-            dbls = (double*)out_values;
-            for(i = 0; i < n; ++i)
+            int j;
+            double v;
+            for( j = 0; j < n; ++j )
             {
-              flt = dbls[l * len + i];
-              for(j = 0; j < 4; ++j)
-                fputc ( u8[j], fp);
-            }
-          } else 
-          for(i = 0; i < len; ++i)
-          {
-            if(!oyBigEndian() && (byteps == 2))
-            { if(i%2)
-                fputc ( out_values[l * len + i - 1] , fp);
+              if(data_type == oyFLOAT)
+                v = ((float*)line)[i * n + j];
               else
-                fputc ( out_values[l * len + i + 1] , fp);
-            } else
-              fputc ( out_values[l * len + i] , fp);
+                v = ((double*)line)[i * n + j];
+              v = v * 65535.0 + 0.5;
+              buf[j] = v < 0 ? 0 : v > 65535 ? 65535 : (uint16_t)v;
+            }
+            png_write_row( png_ptr, (png_bytep)buf );
           }
+        } else
+        {
+          for( i = 0; i < lines; ++i )
+            rows[y + i] = line + i * n * byteps;
+          png_write_rows( png_ptr, &rows[y], lines );
         }
 
         if(is_allocated)
-          image_output->oy_->deallocateFunc_(out_values);
+        {
+          line_allocated = 0;
+          image->oy_->deallocateFunc_( line );
+        }
+        y += lines;
       }
+    }
+
+    png_write_end( png_ptr, info_ptr );
+    png_destroy_write_struct( &png_ptr, &info_ptr );
+  }
+
+  png_write_clean:
+  if(fp)
+  {
+    fflush( fp );
+    fclose( fp );
+  }
+  if(rows && !(array && rows == (png_bytep*) array->array2d))
+    oyDeAllocateFunc_( rows );
+  if(buf)
+    oyDeAllocateFunc_( buf );
+  if(icc)
+    oyDeAllocateFunc_( icc );
+  if(vs)
+    oyDeAllocateFunc_( vs );
+
+  return error;
+}
+
+/** @func    oPNGFilterPlug_ImageOutputPNGWrite
+ *  @brief   implement oyCMMFilter_GetNext_f()
+ *
+ *  The rows of the ticket array are handed to libpng as they are, which avoids
+ *  a full image copy.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2008/10/07 (Oyranos: 0.1.8)
+ *  @date    2011/09/23
+ */
+int      oPNGFilterPlug_ImageOutputPNGWrite (
+                                       oyFilterPlug_s    * requestor_plug,
+                                       oyPixelAccess_s   * ticket )
+{
+  oyFilterSocket_s * socket = requestor_plug->remote_socket_;
+  oyFilterPlug_s * plug = 0;
+  oyFilterNode_s * input_node = 0,
+                 * node = 0;
+  int result = 0;
+  const char * filename = 0;
+
+  node = socket->node;
+  plug = (oyFilterPlug_s *)node->plugs[0];
+  input_node = plug->remote_socket_->node;
+
+  /* to reuse the requestor_plug is a exception for the starting request */
+  result = input_node->api7_->oyCMMFilterPlug_Run( plug, ticket );
 
-      fflush( fp );
-      fclose (fp);
+  if(result <= 0)
+    filename = oyOptions_FindString( node->core->options_, "filename", 0 );
+
+  if(filename)
+  {
+    oyImage_s *image_output = (oyImage_s*)socket->data;
+    oyArray2d_s * a = 0;
+
+    /* only a ticket spanning the whole image can serve as row source */
+    if(ticket && ticket->array &&
+       ticket->start_xy[0] == 0 && ticket->start_xy[1] == 0)
+      a = ticket->array;
 
-    /*message( oyMSG_WARN, (oyStruct_s*)node,
-             OY_DBG_FORMAT_ "write file %s",
-             OY_DBG_ARGS_, filename );*/
+    if(oyImage_WritePNG( image_output, a, filename, node->core->options_,
+                         (oyStruct_s*)node ))
+      result = 1;
   }
 
   return result;
@@ -382,6 +517,10 @@ const char png_write_extra_options[] = {
     <" OY_TYPE_STD ">\n\
      <" "file_write" ">\n\
       <filename></filename>\n\
+      <compression.advanced>-1</compression.advanced>\n\
+      <filter.advanced>-1</filter.advanced>\n\
+      <embed_profile>1</embed_profile>\n\
+      <interlace.advanced>0</interlace.advanced>\n\
      </" "file_write" ">\n\
     </" OY_TYPE_STD ">\n\
    </" OY_DOMAIN_INTERNAL ">\n\
@@ -641,14 +780,272 @@ oyOptions_s* oPNGFilter_ImageInputPNGValidateOptions
   return 0;
 }
 
+/* --- incremental PNG decoding ----------------------------------------------*/
+
+/* rows decoded ahead of a request in sequential files */
+#define oPNG_ROWS_AHEAD 16
+
+/** @internal
+ *  @struct  oPNGDecoder_s
+ *  @brief   open PNG decoder behind a oyImage_s
+ *
+ *  Held in a oyPointer_s as oyImage_s::pixel_data . Sequential files are
+ *  decoded up to the requested line. Interlaced files are decoded pass wise.
+ *  In progressive mode the first passes are shown as rectangles and each
+ *  new sweep over the image decodes one more pass.
+ */
+typedef struct {
+  FILE       * fp;                     /**< open file */
+  png_structp  png_ptr;                /**< decoder or zero when done */
+  png_infop    info_ptr;               /**< decoder info */
+  int          height;                 /**< image height */
+  size_t       row_size;               /**< bytes per row */
+  int          passes;                 /**< interlace passes; 1 sequential */
+  int          passes_done;            /**< decoded interlace passes */
+  int          progressive;            /**< passes to decode before serving */
+  int          rows_done;              /**< decoded rows in sequential files */
+  int          last_y;                 /**< previous requested line */
+  png_bytep  * rows;                   /**< decoded rows */
+} oPNGDecoder_s;
+
+static void oPNGDecoderFinish_       ( oPNGDecoder_s     * d )
+{
+  if(d->png_ptr)
+  {
+    if(!setjmp(png_jmpbuf(d->png_ptr)))
+      png_read_end( d->png_ptr, NULL );
+    png_destroy_read_struct( &d->png_ptr, &d->info_ptr, (png_infopp)NULL );
+    d->png_ptr = 0;
+  }
+  if(d->fp)
+    fclose( d->fp );
+  d->fp = 0;
+}
+
+static int oPNGDecoderRelease_       ( oyPointer         * ptr )
+{
+  oPNGDecoder_s * d;
+  int i;
+
+  if(!ptr || !*ptr)
+    return 1;
+
+  d = (oPNGDecoder_s*) *ptr;
+
+  if(d->png_ptr)
+  {
+    /* skip png_read_end() for a incomplete image */
+    png_destroy_read_struct( &d->png_ptr, &d->info_ptr, (png_infopp)NULL );
+    d->png_ptr = 0;
+  }
+  oPNGDecoderFinish_( d );
+
+  if(d->rows)
+  {
+    for(i = 0; i < d->height; ++i)
+      if(d->rows[i])
+        oyDeAllocateFunc_( d->rows[i] );
+    oyDeAllocateFunc_( d->rows );
+  }
+  oyDeAllocateFunc_( d );
+  *ptr = 0;
+
+  return 0;
+}
+
+/* decode sequential rows until end */
+static int oPNGDecodeRows_           ( oPNGDecoder_s     * d,
+                                       int                 end )
+{
+  int y;
+
+  if(!d->png_ptr)
+    return 1;
+
+  if(setjmp(png_jmpbuf(d->png_ptr)))
+  {
+    png_destroy_read_struct( &d->png_ptr, &d->info_ptr, (png_infopp)NULL );
+    d->png_ptr = 0;
+    oPNGDecoderFinish_( d );
+    return 1;
+  }
+
+  if(end > d->height)
+    end = d->height;
+
+  for(y = d->rows_done; y < end; ++y)
+  {
+    if(!d->rows[y])
+      d->rows[y] = (png_bytep) oyAllocateFunc_( d->row_size );
+    if(!d->rows[y])
+      png_error( d->png_ptr, "MEM Error." );
+    png_read_row( d->png_ptr, d->rows[y], NULL );
+    d->rows_done = y + 1;
+  }
+
+  if(d->rows_done == d->height)
+    oPNGDecoderFinish_( d );
+
+  return 0;
+}
+
+/* decode interlace passes until passes */
+static int oPNGDecodePasses_         ( oPNGDecoder_s     * d,
+                                       int                 passes )
+{
+  int y;
+
+  if(!d->png_ptr)
+    return 1;
+
+  if(setjmp(png_jmpbuf(d->png_ptr)))
+  {
+    png_destroy_read_struct( &d->png_ptr, &d->info_ptr, (png_infopp)NULL );
+    d->png_ptr = 0;
+    oPNGDecoderFinish_( d );
+    return 1;
+  }
+
+  if(passes > d->passes)
+    passes = d->passes;
+
+  /* all rows take part in each pass */
+  for(y = 0; y < d->height; ++y)
+    if(!d->rows[y])
+    {
+      d->rows[y] = (png_bytep) oyAllocateFunc_( d->row_size );
+      if(!d->rows[y])
+        png_error( d->png_ptr, "MEM Error." );
+      memset( d->rows[y], 0, d->row_size );
+    }
+
+  for( ; d->passes_done < passes; ++d->passes_done)
+    if(d->progressive)
+      /* the "rectangle" effect fills the not yet decoded pixels */
+      png_read_rows( d->png_ptr, NULL, d->rows, d->height );
+    else
+      png_read_rows( d->png_ptr, d->rows, NULL, d->height );
+
+  if(d->passes_done == d->passes)
+    oPNGDecoderFinish_( d );
+
+  return 0;
+}
+
+/** @internal
+ *  @brief   oyImage_GetLine_f for oPNGDecoder_s
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/28 (Oyranos: 0.3.2)
+ *  @date    2011/09/28
+ */
+static oyPointer oPNGGetLine_        ( oyImage_s         * image,
+                                       int                 line_y,
+                                       int               * height,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  oPNGDecoder_s * d = (oPNGDecoder_s*) oyPointer_GetPointer(
+                                             (oyPointer_s*)image->pixel_data );
+  png_bytep line = 0;
+
+  if(is_allocated) *is_allocated = 0;
+  if(height) *height = 1;
+
+  if(!d || line_y < 0 || line_y >= d->height)
+  {
+    message( oyMSG_WARN, (oyStruct_s*)image,
+             OY_DBG_FORMAT_ " line_y out of range: %d/%d",
+             OY_DBG_ARGS_, line_y, d ? d->height : 0 );
+    if(height) *height = 0;
+    return 0;
+  }
+
+  /* libpng state, the row table and the tags are shared by all readers */
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  if(d->png_ptr)
+  {
+    if(d->passes == 1)
+    {
+      if(line_y >= d->rows_done)
+        oPNGDecodeRows_( d, line_y + oPNG_ROWS_AHEAD );
+    } else
+    {
+      int passes = d->passes;
+      if(d->progressive)
+      {
+        if(d->passes_done == 0)
+          passes = d->progressive;
+        else if(line_y < d->last_y)
+          /* a new sweep over the image; oPNGGetPoint_ repeats rows */
+          passes = d->passes_done + 1;
+        else
+          passes = d->passes_done;
+      }
+      if(passes > d->passes_done)
+      {
+        oPNGDecodePasses_( d, passes );
+        oyOptions_SetFromInt( &image->tags,
+                          "//" OY_TYPE_STD "/input_png.file_read/passes_done",
+                          d->passes_done, 0, OY_CREATE_NEW );
+      }
+    }
+  }
+  d->last_y = line_y;
+
+  /* a broken file leaves undecoded rows; show them empty */
+  if(!d->rows[line_y])
+  {
+    d->rows[line_y] = (png_bytep) oyAllocateFunc_( d->row_size );
+    if(d->rows[line_y])
+      memset( d->rows[line_y], 0, d->row_size );
+  }
+  line = d->rows[line_y];
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+
+  return line;
+}
+
+/** @internal
+ *  @brief   oyImage_GetPoint_f for oPNGDecoder_s
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/28 (Oyranos: 0.3.2)
+ *  @date    2011/09/28
+ */
+static oyPointer oPNGGetPoint_       ( oyImage_s         * image,
+                                       int                 point_x,
+                                       int                 point_y,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  uint8_t * line = oPNGGetLine_( image, point_y, 0, channel, is_allocated );
+
+  if(!line)
+    return 0;
+  return &line[point_x * oyToChannels_m( image->layout_[0] ) *
+               oySizeofDatatype( oyToDataType_m( image->layout_[0] ) )];
+}
+
 /** @func    oyImage_FromPNG
- *  @brief   implement oyCMMFilter_GetNext_f()
+ *  @brief   open a PNG file as image
  *
- *  @version Oyranos: 0.1.11
+ *  Only the header is read here. The pixels are decoded as lines get
+ *  requested through oyImage_s::getLine.
+ *
+ *  @param[in]     filename            the PNG file
+ *  @param[in]     progressive         for interlaced files the number of
+ *                                     passes to decode before lines are
+ *                                     served; 0 decodes all passes at once
+ *  @param[in]     object              the calling object for messages
+ *  @return                            the image
+ *
+ *  @version Oyranos: 0.3.2
  *  @since   2010/09/12 (Oyranos: 0.1.11)
- *  @date    2010/09/12
+ *  @date    2011/09/28
  */
 oyImage_s *  oyImage_FromPNG         ( const char        * filename,
+                                       int32_t             progressive,
                                        oyStruct_s        * object )
 {
   int error = 0;
@@ -679,6 +1076,7 @@ oyImage_s *  oyImage_FromPNG         ( const char        * filename,
   png_infop info_ptr = 0;
   int color_type = 0,
       num_passes;
+  oPNGDecoder_s * d = 0;
 
 
   if(filename)
@@ -820,30 +1218,41 @@ oyImage_s *  oyImage_FromPNG         ( const char        * filename,
     prof = oyProfile_FromStd( profile_type, 0 );
   }
 
-  /* create the image */
-  image_in = oyImage_Create( width, height, NULL, pixel_layout, prof, 0 );
-  if(image_in)
+  /* hand the decoder over to the image */
+  oyAllocHelper_m_( d, oPNGDecoder_s, 1, oyAllocateFunc_, info_good = 0 );
+  if(d)
+    oyAllocHelper_m_( d->rows, png_bytep, height, oyAllocateFunc_,
+                      info_good = 0 );
+  if(d && d->rows)
   {
-    oyArray2d_s * a = oyArray2d_Create( NULL,
-                                        width * oyToChannels_m(pixel_layout),
-                                        height,
-                                        oyToDataType_m(pixel_layout),
-                                        0 );
-    int i;
-    for( i = 0; i < num_passes; ++i )
-#if 0
-      /* sequential reading */
-      for( y = 0; y < height; ++y )
-        png_read_rows( png_ptr, &a->array2d[y], NULL, 1 );
-#else
-      png_read_rows( png_ptr, a->array2d, NULL, height );
-#endif
-
-    oyImage_DataSet ( image_in, (oyStruct_s**) &a, 0,0,0,0,0,0 );
-  }
-
-  png_read_end( png_ptr, info_ptr );
-  png_destroy_read_struct( &png_ptr, &info_ptr, (png_infopp)NULL );
+    oyPointer_s * pixel_data = oyPointer_New( 0 );
+
+    d->fp = fp;
+    d->png_ptr = png_ptr;
+    d->info_ptr = info_ptr;
+    d->height = height;
+    d->row_size = png_get_rowbytes( png_ptr, info_ptr );
+    d->passes = num_passes;
+    d->progressive = num_passes > 1 && progressive > 0 ? progressive : 0;
+    d->last_y = -1;
+    fp = 0;
+    png_ptr = 0;
+    info_ptr = 0;
+
+    error = oyPointer_Set( pixel_data, 0, "oPNGDecoder_s", d, "oPNGDecoder_s",
+                           oPNGDecoderRelease_ );
+    d = 0;
+    image_in = oyImage_CreateFromData( width, height, pixel_layout, prof,
+                                       (oyStruct_s**) &pixel_data,
+                                       oPNGGetPoint_, oPNGGetLine_, 0,
+                                       0, 0, 0, 0 );
+    oyPointer_Release( &pixel_data );
+  } else if(d)
+    oyDeAllocateFunc_( d );
+  oyProfile_Release( &prof );
+
+  if(png_ptr)
+    png_destroy_read_struct( &png_ptr, &info_ptr, (png_infopp)NULL );
 
   if (!image_in)
   {
@@ -851,6 +1260,8 @@ oyImage_s *  oyImage_FromPNG         ( const char        * filename,
              OY_DBG_FORMAT_ "PNG can't create a new image\n%dx%d %d",
              OY_DBG_ARGS_,  width, height, pixel_layout );
       oyFree_m_ (data)
+      if(fp)
+        fclose (fp);
     return NULL;
   }
 
@@ -871,11 +1282,11 @@ oyImage_s *  oyImage_FromPNG         ( const char        * filename,
              OY_DBG_ARGS_, oyNoEmptyString_m_( filename ), fsize, (int)fpos );
   }
   fpos = 0;
-  fclose (fp);
+  if(fp)
+    fclose (fp);
   fp = NULL;
 
 
-  /* return an error to cause the graph to retry */
   return image_in;
 }
 
@@ -898,6 +1309,7 @@ int      oPNGFilterPlug_ImageInputPNGRun (
 
   /* file variables */
   const char * filename = 0;
+  int32_t progressive = 0;
 
   int info_good = 1;
 
@@ -928,7 +1340,9 @@ int      oPNGFilterPlug_ImageInputPNGRun (
   if(error <= 0)
     filename = oyOptions_FindString( node->core->options_, "filename", 0 );
 
-  image_in = oyImage_FromPNG( filename, (oyStruct_s*)node );
+  oyOptions_FindInt( node->core->options_, "progressive", 0, &progressive );
+
+  image_in = oyImage_FromPNG( filename, progressive, (oyStruct_s*)node );
 
   if(!image_in)
   {
@@ -966,6 +1380,7 @@ const char png_read_extra_options[] = {
     <" OY_TYPE_STD ">\n\
      <" "file_read" ">\n\
       <filename></filename>\n\
+      <progressive.advanced>0</progressive.advanced>\n\
      </" "file_read" ">\n\
     </" OY_TYPE_STD ">\n\
    </" OY_DOMAIN_INTERNAL ">\n\
@@ -1152,6 +1567,7 @@ char * oPNG_api7_image_input_png_properties[] =
   "layers=1",     /* layer count, one for plain images */
   "icc=0",        /* image type ICC profile support */
   "ext=png", /* supported extensions */
+  "magic=89504e470d0a1a0a", /* file signatures */
   0
 };
 
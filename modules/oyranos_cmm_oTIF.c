@@ -0,0 +1,1533 @@
+/** @file oyranos_cmm_oTIF.c
+ *
+ *  Oyranos is an open source Colour Management System
+ *
+ *  @par Copyright:
+ *            2011 (C) Kai-Uwe Behrmann
+ *
+ *  @brief    TIFF module for Oyranos
+ *  @internal
+ *  @author   Kai-Uwe Behrmann <ku.b@gmx.de>
+ *  @par License:
+ *            new BSD <http://www.opensource.org/licenses/bsd-license.php>
+ *  @since    2011/10/05
+ */
+
+#include "config.h"
+#include "oyranos_alpha.h"
+#include "oyranos_cmm.h"
+#include "oyranos_helper.h"
+#include "oyranos_icc.h"
+#include "oyranos_i18n.h"
+#include "oyranos_io.h"
+#include "oyranos_object_internal.h" /* oyAtomicGet_m */
+#include "oyranos_definitions.h"
+#include "oyranos_string.h"
+#include "oyranos_texts.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <tiffio.h>
+
+#define CMM_NICK "oTIF"
+#define CMM_VERSION {0,1,0}
+
+oyMessage_f message = oyMessageFunc;
+
+extern oyCMMapi4_s   oTIF_api4_image_write_tiff;
+extern oyCMMapi7_s   oTIF_api7_image_write_tiff;
+extern oyCMMapi4_s   oTIF_api4_image_input_tiff;
+extern oyCMMapi7_s   oTIF_api7_image_input_tiff;
+
+/* OY_INPUT_TIFF_REGISTRATION */
+/* OY_WRITE_TIFF_REGISTRATION */
+
+
+oyWIDGET_EVENT_e   oTIFWidgetEvent   ( oyOptions_s       * options,
+                                       oyWIDGET_EVENT_e    type,
+                                       oyStruct_s        * event )
+{return 0;}
+
+int                oTIFCMMInit       ( oyStruct_s        * filter )
+{ int error = 0; return error; }
+
+/** Function oTIFCMMMessageFuncSet
+ *  @brief API requirement
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+int            oTIFCMMMessageFuncSet ( oyMessage_f         message_func )
+{
+  message = message_func;
+  return 0;
+}
+
+
+/**
+ *  This function implements oyCMMInfoGetText_f.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+const char * oTIFGetText             ( const char        * select,
+                                       oyNAME_e            type,
+                                       oyStruct_s        * context )
+{
+  if(strcmp(select, "name")==0)
+    if(type == oyNAME_NICK)
+      return _(CMM_NICK);
+
+  return oyCMMgetText( select, type, context );
+}
+
+
+/** @instance oTIF_cmm_module
+ *  @brief    oTIF module infos
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMInfo_s oTIF_cmm_module = {
+
+  oyOBJECT_CMM_INFO_S,
+  0,0,0,
+  CMM_NICK,
+  "0.3.2",
+  oTIFGetText,        /**< getText */
+  (char**)oyCMM_texts, /**< texts; list of arguments to getText */
+  OYRANOS_VERSION,
+
+  (oyCMMapi_s*) & oTIF_api4_image_write_tiff,
+
+  {oyOBJECT_ICON_S, 0,0,0, 0,0,0, "oyranos_logo.png"},
+};
+
+
+void oTIFerror( const char * module, const char * format, va_list ap )
+{
+  char text[1024];
+  vsnprintf( text, 1024, format, ap );
+  message( oyMSG_WARN, (oyStruct_s*)NULL/*node*/,
+             OY_DBG_FORMAT_ "%s: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( module ), text );
+}
+void oTIFwarn( const char * module, const char * format, va_list ap )
+{
+  char text[1024];
+  /* unknown private tags are common and no reason to warn */
+  vsnprintf( text, 1024, format, ap );
+  message( oyMSG_DBG, (oyStruct_s*)NULL/*node*/,
+             OY_DBG_FORMAT_ "%s: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( module ), text );
+}
+
+static void oTIFHandlersSet_         ( )
+{
+  TIFFSetErrorHandler( oTIFerror );
+  TIFFSetWarningHandler( oTIFwarn );
+}
+
+
+/* OY_WRITE_TIFF_REGISTRATION --------------------------------------------*/
+
+
+oyOptions_s* oTIFFilter_ImageOutputTIFFValidateOptions
+                                     ( oyFilterCore_s    * filter,
+                                       oyOptions_s       * validate,
+                                       int                 statical,
+                                       uint32_t          * result )
+{
+  uint32_t error = !filter;
+
+  if(!error)
+    error = !oyOptions_FindString( validate, "filename", 0 );
+
+  *result = error;
+
+  return 0;
+}
+
+/** @func    oyImage_WriteTIFF
+ *  @brief   encode a image into a TIFF file
+ *
+ *  The image is written in bands of one tile or strip height. Each band is
+ *  split into tiles and, for planar files, into channel planes, which are
+ *  passed to TIFFWriteEncodedTile() or TIFFWriteEncodedStrip(). If array
+ *  covers the whole image in the image data type, its lines are used without
+ *  copy. Otherwise the lines are obtained from oyImage_s::getLine.
+ *
+ *  Options:
+ *  - "compression" - TIFF compression scheme: 1 none, 5 LZW,
+ *                    8 deflate, 32773 packbits
+ *  - "tile_width" and "tile_height" - tile size, rounded up to a multiple of
+ *                    16; 0 writes strips
+ *  - "planar" - 1 write each channel into a separate plane
+ *  - "embed_profile" - 1 write the image profile into the ICC tag
+ *
+ *  @param[in]     image               the image to encode
+ *  @param[in]     array               optional pixel rows of image
+ *  @param[in]     filename            the file to write to
+ *  @param[in]     options             the above options
+ *  @param[in]     object              the calling object for messages
+ *  @return                            error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+int          oyImage_WriteTIFF       ( oyImage_s         * image,
+                                       oyArray2d_s       * array,
+                                       const char        * filename,
+                                       oyOptions_s       * options,
+                                       oyStruct_s        * object )
+{
+  TIFF * tif = 0;
+  int error = !image || !filename;
+  int32_t compression = COMPRESSION_NONE,
+          tile_width = 256,
+          tile_height = 256,
+          planar = 0,
+          embed_profile = 1;
+  int channels = 0, cchan_n = 0, byteps = 0, width = 0, height = 0,
+      tiled = 0, tw = 0, th = 0, planes = 1, x, y, i, r, c, s, lines;
+  oyDATATYPE_e data_type = oyUINT8;
+  icColorSpaceSignature csp = 0;
+  uint16 photometric = PHOTOMETRIC_MINISBLACK,
+         sample_format = SAMPLEFORMAT_UINT,
+         extra[16];
+  size_t row_size = 0, pixel_size = 0, sample_size = 0;
+  uint8_t * band = 0, * tile = 0, ** rows = 0;
+  oyPointer icc = 0;
+  size_t icc_size = 0;
+  char * vs = 0;
+
+  if(!error)
+  {
+    channels = oyToChannels_m( image->layout_[0] );
+    data_type = oyToDataType_m( image->layout_[0] );
+    byteps = oySizeofDatatype( data_type );
+    cchan_n = oyProfile_GetChannelsCount( image->profile_ );
+    csp = (icColorSpaceSignature) oyProfile_GetSignature( image->profile_,
+                                                  oySIGNATURE_COLOUR_SPACE );
+    width = image->width;
+    height = image->height;
+    pixel_size = channels * byteps;
+    row_size = width * pixel_size;
+
+    switch(csp)
+    {
+      case icSigGrayData: photometric = PHOTOMETRIC_MINISBLACK; break;
+      case icSigRgbData:  photometric = PHOTOMETRIC_RGB; break;
+      case icSigCmykData: photometric = PHOTOMETRIC_SEPARATED; break;
+      case icSigLabData:  photometric = PHOTOMETRIC_ICCLAB; break;
+      default:
+           photometric = cchan_n == 1 ? PHOTOMETRIC_MINISBLACK :
+                                        PHOTOMETRIC_SEPARATED;
+    }
+
+    if(channels < cchan_n || channels - cchan_n > 16)
+    {
+      message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " can not encode %d colour + %d extra channels",
+             OY_DBG_ARGS_, cchan_n, channels - cchan_n );
+      error = 1;
+    }
+    for(i = 0; i < channels - cchan_n && i < 16; ++i)
+      extra[i] = EXTRASAMPLE_UNASSALPHA;
+
+    switch(data_type)
+    {
+      case oyUINT8:
+      case oyUINT16: sample_format = SAMPLEFORMAT_UINT; break;
+      case oyHALF:
+      case oyFLOAT:
+      case oyDOUBLE: sample_format = SAMPLEFORMAT_IEEEFP; break;
+      default:
+      message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " data type not supported: %d",
+             OY_DBG_ARGS_, data_type );
+      error = 1;
+    }
+  }
+
+  if(!error)
+  {
+    oyOptions_FindInt( options, "compression", 0, &compression );
+    oyOptions_FindInt( options, "tile_width", 0, &tile_width );
+    oyOptions_FindInt( options, "tile_height", 0, &tile_height );
+    oyOptions_FindInt( options, "planar", 0, &planar );
+    oyOptions_FindInt( options, "embed_profile", 0, &embed_profile );
+
+    if(embed_profile)
+      icc = oyProfile_GetMem( image->profile_, &icc_size, 0, oyAllocateFunc_ );
+    vs = oyVersionString(1,oyAllocateFunc_);
+
+    oTIFHandlersSet_();
+#if defined(TIFF_BIGTIFF)
+    /* classic TIFF ends at 4 GB */
+    if((double)row_size * height > 0xF0000000)
+      tif = TIFFOpen( filename, "w8" );
+    else
+#endif
+    tif = TIFFOpen( filename, "w" );
+    if(!tif)
+    {
+      message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " could not open: %s",
+             OY_DBG_ARGS_, filename );
+      error = 1;
+    }
+  }
+
+  if(!error)
+  {
+    planes = planar && channels > 1 ? channels : 1;
+    tiled = tile_width > 0 && tile_height > 0;
+
+    TIFFSetField( tif, TIFFTAG_IMAGEWIDTH, (uint32)width );
+    TIFFSetField( tif, TIFFTAG_IMAGELENGTH, (uint32)height );
+    TIFFSetField( tif, TIFFTAG_BITSPERSAMPLE, (uint16)(byteps * 8) );
+    TIFFSetField( tif, TIFFTAG_SAMPLESPERPIXEL, (uint16)channels );
+    TIFFSetField( tif, TIFFTAG_SAMPLEFORMAT, sample_format );
+    TIFFSetField( tif, TIFFTAG_PHOTOMETRIC, photometric );
+    TIFFSetField( tif, TIFFTAG_PLANARCONFIG, planes > 1 ?
+                  PLANARCONFIG_SEPARATE : PLANARCONFIG_CONTIG );
+    TIFFSetField( tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT );
+    if(photometric == PHOTOMETRIC_SEPARATED && csp == icSigCmykData)
+      TIFFSetField( tif, TIFFTAG_INKSET, INKSET_CMYK );
+    if(channels > cchan_n)
+      TIFFSetField( tif, TIFFTAG_EXTRASAMPLES, (uint16)(channels - cchan_n),
+                    extra );
+    if(TIFFIsCODECConfigured( (uint16)compression ))
+      TIFFSetField( tif, TIFFTAG_COMPRESSION, (uint16)compression );
+    if(compression == COMPRESSION_LZW ||
+       compression == COMPRESSION_ADOBE_DEFLATE)
+      /* differences compress better than samples */
+      TIFFSetField( tif, TIFFTAG_PREDICTOR,
+                    sample_format == SAMPLEFORMAT_IEEEFP ?
+                    PREDICTOR_FLOATINGPOINT : PREDICTOR_HORIZONTAL );
+    if(vs)
+      TIFFSetField( tif, TIFFTAG_SOFTWARE, vs );
+    if(icc && icc_size)
+      TIFFSetField( tif, TIFFTAG_ICCPROFILE, (uint32)icc_size, icc );
+
+    if(tiled)
+    {
+      tw = (tile_width + 15) / 16 * 16;
+      th = (tile_height + 15) / 16 * 16;
+      TIFFSetField( tif, TIFFTAG_TILEWIDTH, (uint32)tw );
+      TIFFSetField( tif, TIFFTAG_TILELENGTH, (uint32)th );
+    } else
+    {
+      tw = width;
+      th = TIFFDefaultStripSize( tif, 0 );
+      if(th > height)
+        th = height;
+      TIFFSetField( tif, TIFFTAG_ROWSPERSTRIP, (uint32)th );
+    }
+
+    sample_size = planes > 1 ? byteps : pixel_size;
+    oyAllocHelper_m_( rows, uint8_t*, th, oyAllocateFunc_, error = 1 );
+    if(!error && !(array && array->t == data_type &&
+                   array->width >= width * channels && array->height >= height))
+      oyAllocHelper_m_( band, uint8_t, th * row_size, oyAllocateFunc_,
+                        error = 1 );
+    if(!error)
+      oyAllocHelper_m_( tile, uint8_t, tw * th * sample_size, oyAllocateFunc_,
+                        error = 1 );
+  }
+
+  for(y = 0; !error && y < height; y += th)
+  {
+    lines = th < height - y ? th : height - y;
+
+    /* collect the lines of this band */
+    for(i = 0; i < lines; )
+    {
+      int n = 1, is_allocated = 0;
+      uint8_t * line;
+
+      if(!band)
+      {
+        rows[i] = array->array2d[y + i];
+        ++i;
+        continue;
+      }
+
+      line = image->getLine( image, y + i, &n, -1, &is_allocated );
+      if(!line || n <= 0)
+      {
+        message( oyMSG_WARN, object, OY_DBG_FORMAT_ " no image line %d",
+                 OY_DBG_ARGS_, y + i );
+        error = 1;
+        break;
+      }
+      for(r = 0; r < n && i < lines; ++r, ++i)
+      {
+        rows[i] = &band[i * row_size];
+        memcpy( rows[i], &line[r * row_size], row_size );
+      }
+      if(is_allocated)
+        image->oy_->deallocateFunc_( line );
+    }
+    /* tiles span over the image bottom */
+    for(i = lines; i < th; ++i)
+      rows[i] = rows[lines - 1];
+
+    for(x = 0; !error && x < width; x += tw)
+    {
+      int cols = tw < width - x ? tw : width - x;
+      int tile_lines = tiled ? th : lines;
+
+      if(cols < tw)
+        memset( tile, 0, tw * th * sample_size );
+
+      for(s = 0; s < planes && !error; ++s)
+      {
+        tsize_t size = tw * tile_lines * sample_size;
+
+        for(r = 0; r < tile_lines; ++r)
+        {
+          uint8_t * src = &rows[r][x * pixel_size],
+                  * dst = &tile[r * tw * sample_size];
+          if(planes == 1)
+            memcpy( dst, src, cols * pixel_size );
+          else
+            for(c = 0; c < cols; ++c)
+              memcpy( &dst[c * byteps], &src[c * pixel_size + s * byteps],
+                      byteps );
+        }
+
+        if(tiled)
+          error = TIFFWriteEncodedTile( tif, TIFFComputeTile( tif, x, y, 0, s ),
+                                        tile, size ) < 0;
+        else
+          error = TIFFWriteEncodedStrip( tif, TIFFComputeStrip( tif, y, s ),
+                                         tile, size ) < 0;
+      }
+    }
+  }
+
+  if(tif)
+    TIFFClose( tif );
+  if(rows)
+    oyDeAllocateFunc_( rows );
+  if(band)
+    oyDeAllocateFunc_( band );
+  if(tile)
+    oyDeAllocateFunc_( tile );
+  if(icc)
+    oyDeAllocateFunc_( icc );
+  if(vs)
+    oyDeAllocateFunc_( vs );
+
+  return error;
+}
+
+/** @func    oTIFFilterPlug_ImageOutputTIFFWrite
+ *  @brief   implement oyCMMFilter_GetNext_f()
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+int      oTIFFilterPlug_ImageOutputTIFFWrite (
+                                       oyFilterPlug_s    * requestor_plug,
+                                       oyPixelAccess_s   * ticket )
+{
+  oyFilterSocket_s * socket = requestor_plug->remote_socket_;
+  oyFilterPlug_s * plug = 0;
+  oyFilterNode_s * input_node = 0,
+                 * node = 0;
+  int result = 0;
+  const char * filename = 0;
+
+  node = socket->node;
+  plug = (oyFilterPlug_s *)node->plugs[0];
+  input_node = plug->remote_socket_->node;
+
+  /* to reuse the requestor_plug is a exception for the starting request */
+  result = input_node->api7_->oyCMMFilterPlug_Run( plug, ticket );
+
+  if(result <= 0)
+    filename = oyOptions_FindString( node->core->options_, "filename", 0 );
+
+  if(filename)
+  {
+    oyImage_s *image_output = (oyImage_s*)socket->data;
+    oyArray2d_s * a = 0;
+
+    /* only a ticket spanning the whole image can serve as row source */
+    if(ticket && ticket->array &&
+       ticket->start_xy[0] == 0 && ticket->start_xy[1] == 0)
+      a = ticket->array;
+
+    if(oyImage_WriteTIFF( image_output, a, filename, node->core->options_,
+                          (oyStruct_s*)node ))
+      result = 1;
+  }
+
+  return result;
+}
+
+const char tiff_write_extra_options[] = {
+ "\n\
+  <" OY_TOP_SHARED ">\n\
+   <" OY_DOMAIN_INTERNAL ">\n\
+    <" OY_TYPE_STD ">\n\
+     <" "file_write" ">\n\
+      <filename></filename>\n\
+      <compression.advanced>1</compression.advanced>\n\
+      <tile_width.advanced>256</tile_width.advanced>\n\
+      <tile_height.advanced>256</tile_height.advanced>\n\
+      <planar.advanced>0</planar.advanced>\n\
+      <embed_profile>1</embed_profile>\n\
+     </" "file_write" ">\n\
+    </" OY_TYPE_STD ">\n\
+   </" OY_DOMAIN_INTERNAL ">\n\
+  </" OY_TOP_SHARED ">\n"
+};
+
+int  oTIFTIFFwriteUiGet              ( oyOptions_s       * opts,
+                                       char             ** xforms_layout,
+                                       oyAlloc_f           allocateFunc )
+{
+  char * text = (char*)allocateFunc(5);
+  text[0] = 0;
+  *xforms_layout = text;
+  return 0;
+}
+
+
+oyDATATYPE_e oTIF_image_tiff_data_types[6] = {oyUINT8, oyUINT16, oyHALF,
+                                              oyFLOAT, oyDOUBLE, 0};
+
+
+
+oyConnectorImaging_s oTIF_imageOutputTIFF_connector_out = {
+  oyOBJECT_CONNECTOR_IMAGING_S,0,0,
+                               (oyObject_s)&oy_connector_imaging_static_object,
+  oyCMMgetImageConnectorSocketText, /* getText */
+  oy_image_connector_texts, /* texts */
+  "//" OY_TYPE_STD "/image.data", /* connector_type */
+  oyFilterSocket_MatchImagingPlug, /* filterSocket_MatchPlug */
+  0, /* is_plug == oyFilterPlug_s */
+  oTIF_image_tiff_data_types,
+  5, /* data_types_n; elements in data_types array */
+  -1, /* max_colour_offset */
+  1, /* min_channels_count; */
+  16, /* max_channels_count; */
+  1, /* min_colour_count; */
+  15, /* max_colour_count; */
+  0, /* can_planar; can read separated channels */
+  1, /* can_interwoven; can read continuous channels */
+  0, /* can_swap; can swap colour channels (BGR)*/
+  0, /* can_swap_bytes; non host byte order */
+  0, /* can_revert; revert 1 -> 0 and 0 -> 1 */
+  1, /* can_premultiplied_alpha; */
+  1, /* can_nonpremultiplied_alpha; */
+  0, /* can_subpixel; understand subpixel order */
+  0, /* oyCHANNELTYPE_e    * channel_types; */
+  0, /* count in channel_types */
+  1, /* id; relative to oyFilter_s, e.g. 1 */
+  0  /* is_mandatory; mandatory flag */
+};
+oyConnectorImaging_s * oTIF_imageOutputTIFF_connectors_socket[2] =
+             { &oTIF_imageOutputTIFF_connector_out, 0 };
+
+
+oyConnectorImaging_s oTIF_imageOutputTIFF_connector_in = {
+  oyOBJECT_CONNECTOR_IMAGING_S,0,0,
+                               (oyObject_s)&oy_connector_imaging_static_object,
+  oyCMMgetImageConnectorPlugText, /* getText */
+  oy_image_connector_texts, /* texts */
+  "//" OY_TYPE_STD "/image.data", /* connector_type */
+  oyFilterSocket_MatchImagingPlug, /* filterSocket_MatchPlug */
+  1, /* is_plug == oyFilterPlug_s */
+  oTIF_image_tiff_data_types,
+  5, /* data_types_n; elements in data_types array */
+  -1, /* max_colour_offset */
+  1, /* min_channels_count; */
+  16, /* max_channels_count; */
+  1, /* min_colour_count; */
+  15, /* max_colour_count; */
+  0, /* can_planar; can read separated channels */
+  1, /* can_interwoven; can read continuous channels */
+  0, /* can_swap; can swap colour channels (BGR)*/
+  0, /* can_swap_bytes; non host byte order */
+  0, /* can_revert; revert 1 -> 0 and 0 -> 1 */
+  1, /* can_premultiplied_alpha; */
+  1, /* can_nonpremultiplied_alpha; */
+  0, /* can_subpixel; understand subpixel order */
+  0, /* oyCHANNELTYPE_e    * channel_types; */
+  0, /* count in channel_types */
+  2, /* id; relative to oyFilter_s, e.g. 1 */
+  0  /* is_mandatory; mandatory flag */
+};
+oyConnectorImaging_s * oTIF_imageOutputTIFF_connectors_plug[2] =
+             { &oTIF_imageOutputTIFF_connector_in, 0 };
+
+/**
+ *  This function implements oyCMMGetText_f.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+const char * oTIFApi4ImageWriteUiGetText (
+                                       const char        * select,
+                                       oyNAME_e            type,
+                                       oyStruct_s        * context )
+{
+  static char * category = 0;
+  if(strcmp(select,"name"))
+  {
+         if(type == oyNAME_NICK)
+      return "write_tiff";
+    else if(type == oyNAME_NAME)
+      return _("Image[write_tiff]");
+    else
+      return _("Write TIFF Image Filter Object");
+  }
+  else if(strcmp(select,"category"))
+  {
+    if(!category)
+    {
+      STRING_ADD( category, _("Files") );
+      STRING_ADD( category, _("/") );
+      STRING_ADD( category, _("Write TIFF") );
+    }
+         if(type == oyNAME_NICK)
+      return "category";
+    else if(type == oyNAME_NAME)
+      return category;
+    else
+      return category;
+  }
+  else if(strcmp(select,"help"))
+  {
+         if(type == oyNAME_NICK)
+      return "help";
+    else if(type == oyNAME_NAME)
+      return _("Option \"filename\", a valid filename");
+    else
+      return _("The Option \"filename\" should contain a valid filename to write the tiff data into. A existing file will be overwritten without notice. The options \"tile_width\" and \"tile_height\" select tiles, 0 writes strips. The option \"planar\" writes one plane per channel.");
+  }
+  return 0;
+}
+const char * oTIF_api4_image_write_tiff_ui_texts[] = {"name", "category", "help", 0};
+
+/** @instance oTIF_api4_image_write_tiff_ui
+ *  @brief    oTIF oyCMMapi4_s::ui implementation
+ *
+ *  The UI for filter write tiff.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMui_s oTIF_api4_image_write_tiff_ui = {
+  oyOBJECT_CMM_DATA_TYPES_S,           /**< oyOBJECT_e       type; */
+  0,0,0,                            /* unused oyStruct_s fields; keep to zero */
+
+  CMM_VERSION,                         /**< int32_t version[3] */
+  {0,3,0},                            /**< int32_t module_api[3] */
+
+  oTIFFilter_ImageOutputTIFFValidateOptions, /* oyCMMFilter_ValidateOptions_f */
+  oTIFWidgetEvent, /* oyWidgetEvent_f */
+
+  "Files/Write TIFF", /* category */
+  tiff_write_extra_options, /* const char * options */
+  oTIFTIFFwriteUiGet, /* oyCMMuiGet_f oyCMMuiGet */
+
+  oTIFApi4ImageWriteUiGetText, /* oyCMMGetText_f   getText */
+  oTIF_api4_image_write_tiff_ui_texts /* const char    ** texts */
+};
+
+/** @instance oTIF_api4
+ *  @brief    oTIF oyCMMapi4_s implementation
+ *
+ *  A filter writing a TIFF image.
+ *
+ *  @par Options:
+ *  - "filename" - the file name to write to
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMapi4_s   oTIF_api4_image_write_tiff = {
+
+  oyOBJECT_CMM_API4_S, /* oyStruct_s::type oyOBJECT_CMM_API4_S */
+  0,0,0, /* unused oyStruct_s fileds; keep to zero */
+  (oyCMMapi_s*) & oTIF_api7_image_write_tiff, /* oyCMMapi_s * next */
+
+  oTIFCMMInit, /* oyCMMInit_f */
+  oTIFCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
+
+  /* registration */
+  OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL OY_SLASH OY_TYPE_STD "/write_tiff.file_write._CPU._" CMM_NICK,
+
+  CMM_VERSION, /* int32_t version[3] */
+  {0,3,0},                  /**< int32_t module_api[3] */
+  0,   /* id_; keep empty */
+  0,   /* api5_; keep empty */
+
+  oyFilterNode_TextToInfo_, /* oyCMMFilterNode_ContextToMem_f */
+  0, /* oyCMMFilterNode_GetText_f        oyCMMFilterNode_GetText */
+  {0}, /* char context_type[8] */
+
+  &oTIF_api4_image_write_tiff_ui        /**< oyCMMui_s *ui */
+};
+
+/** @instance oTIF_api7
+ *  @brief    oTIF oyCMMapi7_s implementation
+ *
+ *  A filter writing a TIFF image.
+ *
+ *  @par Options:
+ *  - "filename" - the file name to write to
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMapi7_s   oTIF_api7_image_write_tiff = {
+
+  oyOBJECT_CMM_API7_S, /* oyStruct_s::type oyOBJECT_CMM_API7_S */
+  0,0,0, /* unused oyStruct_s fileds; keep to zero */
+  (oyCMMapi_s*) & oTIF_api4_image_input_tiff, /* oyCMMapi_s * next */
+
+  oTIFCMMInit, /* oyCMMInit_f */
+  oTIFCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
+
+  /* registration */
+  OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL OY_SLASH OY_TYPE_STD "/write_tiff.file_write._CPU._" CMM_NICK,
+
+  CMM_VERSION, /* int32_t version[3] */
+  {0,3,0},                  /**< int32_t module_api[3] */
+  0,   /* id_; keep empty */
+  0,   /* api5_; keep empty */
+
+  oTIFFilterPlug_ImageOutputTIFFWrite, /* oyCMMFilterPlug_Run_f */
+  {0}, /* char data_type[8] */
+
+  (oyConnector_s**) oTIF_imageOutputTIFF_connectors_plug,   /* plugs */
+  1,   /* plugs_n */
+  0,   /* plugs_last_add */
+  (oyConnector_s**) oTIF_imageOutputTIFF_connectors_socket,   /* sockets */
+  1,   /* sockets_n */
+  0    /* sockets_last_add */
+};
+
+
+/* OY_INPUT_TIFF_REGISTRATION --------------------------------------------*/
+
+
+
+oyOptions_s* oTIFFilter_ImageInputTIFFValidateOptions
+                                     ( oyFilterCore_s    * filter,
+                                       oyOptions_s       * validate,
+                                       int                 statical,
+                                       uint32_t          * result )
+{
+  uint32_t error = !filter;
+
+  if(!error)
+    error = !oyOptions_FindString( validate, "filename", 0 );
+
+  *result = error;
+
+  return 0;
+}
+
+/* --- on demand TIFF decoding -----------------------------------------------*/
+
+/** @internal
+ *  @struct  oTIFDecoder_s
+ *  @brief   open TIFF file behind a oyImage_s
+ *
+ *  Held in a oyPointer_s as oyImage_s::pixel_data . Strips are handled as
+ *  tiles of the full image width. The decoded pixels are kept interleaved
+ *  in bands of one tile height, which are allocated on first access. Each
+ *  tile is decoded once, when a line or the tile itself is requested.
+ */
+typedef struct {
+  TIFF       * tif;                    /**< open file or zero when done */
+  int          width;                  /**< image width */
+  int          height;                 /**< image height */
+  int          spp;                    /**< samples per pixel */
+  int          byteps;                 /**< bytes per sample */
+  int          planar;                 /**< one plane per channel */
+  int          tiled;                  /**< tiles or strips */
+  int          tile_width;             /**< strip width is the image width */
+  int          tile_height;            /**< rows per strip */
+  int          tiles_across;           /**< tiles per band */
+  int          tiles_down;             /**< bands */
+  int          tiles_done;             /**< decoded tiles */
+  size_t       row_size;               /**< bytes of a band row */
+  uint8_t   ** bands;                  /**< decoded bands */
+  char       * decoded;                /**< decoded flag per tile */
+  oyPointer ** tile_rows;              /**< row pointers per tile */
+  uint8_t    * buf;                    /**< tile decode buffer */
+} oTIFDecoder_s;
+
+static int oTIFDecoderRelease_       ( oyPointer         * ptr )
+{
+  oTIFDecoder_s * d;
+  int i;
+
+  if(!ptr || !*ptr)
+    return 1;
+
+  d = (oTIFDecoder_s*) *ptr;
+
+  if(d->tif)
+    TIFFClose( d->tif );
+  d->tif = 0;
+
+  if(d->bands)
+  {
+    for(i = 0; i < d->tiles_down; ++i)
+      if(d->bands[i])
+        oyDeAllocateFunc_( d->bands[i] );
+    oyDeAllocateFunc_( d->bands );
+  }
+  if(d->tile_rows)
+  {
+    for(i = 0; i < d->tiles_across * d->tiles_down; ++i)
+      if(d->tile_rows[i])
+        oyDeAllocateFunc_( d->tile_rows[i] );
+    oyDeAllocateFunc_( d->tile_rows );
+  }
+  if(d->decoded)
+    oyDeAllocateFunc_( d->decoded );
+  if(d->buf)
+    oyDeAllocateFunc_( d->buf );
+  oyDeAllocateFunc_( d );
+  *ptr = 0;
+
+  return 0;
+}
+
+/* decode one tile into its band; broken tiles remain empty */
+static int oTIFDecodeTile_           ( oyImage_s         * image,
+                                       oTIFDecoder_s     * d,
+                                       int                 tile_x,
+                                       int                 tile_y )
+{
+  int error = 0;
+  int i = tile_y * d->tiles_across + tile_x;
+
+  /* the flag is published after the band is filled */
+  if(oyAtomicGet_m( &d->decoded[i] ))
+    return 0;
+
+  /* libtiff handles are not reentrant; the image lock serialises decoding,
+   * the tile counter and closing the file */
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  if(!d->decoded[i])
+  {
+    int x = tile_x * d->tile_width,
+        y = tile_y * d->tile_height,
+        tw = d->tile_width,
+        th = d->tile_height,
+        cols = tw < d->width - x ? tw : d->width - x,
+        planes = d->planar ? d->spp : 1,
+        pixel_size = d->spp * d->byteps,
+        sample_size = d->planar ? d->byteps : pixel_size,
+        r, c, s;
+    uint8_t * band;
+
+    if(!d->bands[tile_y])
+    {
+      /* one spare tile row keeps pointers of the last tile inside memory */
+      d->bands[tile_y] = (uint8_t*) oyAllocateFunc_( d->row_size * th +
+                                                     tw * pixel_size );
+      if(d->bands[tile_y])
+        memset( d->bands[tile_y], 0, d->row_size * th + tw * pixel_size );
+    }
+    band = d->bands[tile_y];
+    if(!band)
+      error = 1;
+
+    for(s = 0; s < planes && !error; ++s)
+    {
+      tsize_t size = tw * th * sample_size;
+      uint8_t * dst = d->buf;
+
+      /* interleaved strips go straight into their band */
+      if(!d->tiled && planes == 1)
+        dst = band;
+
+      if(!d->tif)
+        error = 1;
+      else if(d->tiled)
+        error = TIFFReadEncodedTile( d->tif,
+                                     TIFFComputeTile( d->tif, x, y, 0, s ),
+                                     dst, size ) < 0;
+      else
+        error = TIFFReadEncodedStrip( d->tif,
+                                      TIFFComputeStrip( d->tif, y, s ),
+                                      dst, size ) < 0;
+
+      if(error || dst == band)
+        break;
+
+      for(r = 0; r < th; ++r)
+      {
+        uint8_t * src = &d->buf[r * tw * sample_size],
+                * line = &band[r * d->row_size + x * pixel_size];
+        if(planes == 1)
+          memcpy( line, src, cols * pixel_size );
+        else
+          for(c = 0; c < cols; ++c)
+            memcpy( &line[c * pixel_size + s * d->byteps],
+                    &src[c * d->byteps], d->byteps );
+      }
+    }
+
+    if(error)
+      message( oyMSG_WARN, 0, OY_DBG_FORMAT_ " could not decode tile %d,%d",
+               OY_DBG_ARGS_, tile_x, tile_y );
+
+    oyAtomicSet_m( &d->decoded[i], 1 );
+    ++d->tiles_done;
+
+    /* all pixels are in memory */
+    if(d->tiles_done == d->tiles_across * d->tiles_down && d->tif)
+    {
+      TIFFClose( d->tif );
+      d->tif = 0;
+    }
+  }
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+
+  return error;
+}
+
+/** @internal
+ *  @brief   oyImage_GetLine_f for oTIFDecoder_s
+ *
+ *  All lines up to the band end are returned in height.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+static oyPointer oTIFGetLine_        ( oyImage_s         * image,
+                                       int                 line_y,
+                                       int               * height,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  oTIFDecoder_s * d = (oTIFDecoder_s*) oyPointer_GetPointer(
+                                             (oyPointer_s*)image->pixel_data );
+  int ty, tx, y;
+
+  if(is_allocated) *is_allocated = 0;
+  if(height) *height = 1;
+
+  if(!d || line_y < 0 || line_y >= d->height)
+  {
+    message( oyMSG_WARN, (oyStruct_s*)image,
+             OY_DBG_FORMAT_ " line_y out of range: %d/%d",
+             OY_DBG_ARGS_, line_y, d ? d->height : 0 );
+    if(height) *height = 0;
+    return 0;
+  }
+
+  ty = line_y / d->tile_height;
+  y = line_y - ty * d->tile_height;
+  for(tx = 0; tx < d->tiles_across; ++tx)
+    oTIFDecodeTile_( image, d, tx, ty );
+
+  if(!d->bands[ty])
+  {
+    if(height) *height = 0;
+    return 0;
+  }
+
+  if(height)
+  {
+    *height = d->tile_height - y;
+    if(line_y + *height > d->height)
+      *height = d->height - line_y;
+  }
+
+  return &d->bands[ty][y * d->row_size];
+}
+
+/** @internal
+ *  @brief   oyImage_GetTile_f for oTIFDecoder_s
+ *
+ *  The tile position is counted in oyImage_s::tile_width and
+ *  oyImage_s::tile_height units. The returned row pointers stay valid for the
+ *  image life time. Only the columns inside the image are defined.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+static oyPointer * oTIFGetTile_      ( oyImage_s         * image,
+                                       int                 tile_x,
+                                       int                 tile_y,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  oTIFDecoder_s * d = (oTIFDecoder_s*) oyPointer_GetPointer(
+                                             (oyPointer_s*)image->pixel_data );
+  oyPointer * tile = 0;
+  int i, r;
+
+  if(is_allocated) *is_allocated = 0;
+
+  if(!d || tile_x < 0 || tile_x >= d->tiles_across ||
+           tile_y < 0 || tile_y >= d->tiles_down)
+  {
+    message( oyMSG_WARN, (oyStruct_s*)image,
+             OY_DBG_FORMAT_ " tile out of range: %d,%d",
+             OY_DBG_ARGS_, tile_x, tile_y );
+    return 0;
+  }
+
+  oTIFDecodeTile_( image, d, tile_x, tile_y );
+
+  i = tile_y * d->tiles_across + tile_x;
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  if(!d->tile_rows[i] && d->bands[tile_y])
+  {
+    oyPointer * rows = (oyPointer*) oyAllocateFunc_( sizeof(oyPointer) *
+                                                     d->tile_height );
+    for(r = 0; rows && r < d->tile_height; ++r)
+      rows[r] = &d->bands[tile_y][r * d->row_size +
+                                  tile_x * d->tile_width * d->spp * d->byteps];
+    d->tile_rows[i] = rows;
+  }
+  tile = d->tile_rows[i];
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+
+  return tile;
+}
+
+/** @internal
+ *  @brief   oyImage_GetPoint_f for oTIFDecoder_s
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+static oyPointer oTIFGetPoint_       ( oyImage_s         * image,
+                                       int                 point_x,
+                                       int                 point_y,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  uint8_t * line = oTIFGetLine_( image, point_y, 0, channel, is_allocated );
+
+  if(!line)
+    return 0;
+  return &line[point_x * oyToChannels_m( image->layout_[0] ) *
+               oySizeofDatatype( oyToDataType_m( image->layout_[0] ) )];
+}
+
+/** @func    oyImage_FromTIFF
+ *  @brief   open a TIFF file as image
+ *
+ *  Only the header is read here. Tiles and strips are decoded as lines or
+ *  tiles get requested through oyImage_s::getLine and oyImage_s::getTile.
+ *  The tile size is set in oyImage_s::tile_width and oyImage_s::tile_height
+ *  for tile parallel processing. A embedded ICC profile is attached,
+ *  otherwise a assumed profile after the photometric interpretation.
+ *
+ *  @param[in]     filename            the TIFF file
+ *  @param[in]     object              the calling object for messages
+ *  @return                            the image
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyImage_s *  oyImage_FromTIFF        ( const char        * filename,
+                                       oyStruct_s        * object )
+{
+  TIFF * tif = 0;
+  int info_good = 1;
+  oyDATATYPE_e data_type = oyUINT8;
+  oyPROFILE_e profile_type = oyASSUMED_RGB;
+  oyProfile_s * prof = 0;
+  oyImage_s * image_in = 0;
+  oyPixel_t pixel_layout = 0;
+  uint32 width = 0, height = 0, tw = 0, th = 0, icc_size = 0;
+  uint16 bps = 8, spp = 1, sample_format = SAMPLEFORMAT_UINT,
+         planar = PLANARCONFIG_CONTIG, photometric = PHOTOMETRIC_MINISBLACK,
+         compression = COMPRESSION_NONE;
+  void * icc = 0;
+  oTIFDecoder_s * d = 0;
+
+  oTIFHandlersSet_();
+  if(filename)
+    /* "m" keeps libtiff from memory mapping the whole file */
+    tif = TIFFOpen( filename, "rm" );
+
+  if(!tif)
+  {
+    message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " could not open: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
+    return NULL;
+  }
+
+  TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &width );
+  TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &height );
+  TIFFGetFieldDefaulted( tif, TIFFTAG_BITSPERSAMPLE, &bps );
+  TIFFGetFieldDefaulted( tif, TIFFTAG_SAMPLESPERPIXEL, &spp );
+  TIFFGetFieldDefaulted( tif, TIFFTAG_SAMPLEFORMAT, &sample_format );
+  TIFFGetFieldDefaulted( tif, TIFFTAG_PLANARCONFIG, &planar );
+  TIFFGetFieldDefaulted( tif, TIFFTAG_COMPRESSION, &compression );
+  TIFFGetField( tif, TIFFTAG_PHOTOMETRIC, &photometric );
+
+  switch(photometric)
+  {
+    case PHOTOMETRIC_MINISBLACK: profile_type = oyASSUMED_GRAY; break;
+    case PHOTOMETRIC_RGB:        profile_type = oyASSUMED_RGB; break;
+    case PHOTOMETRIC_SEPARATED:  profile_type = oyASSUMED_CMYK; break;
+    case PHOTOMETRIC_ICCLAB:     profile_type = oyASSUMED_LAB; break;
+    case PHOTOMETRIC_YCBCR:
+         /* let the JPEG codec deliver RGB */
+         if(compression == COMPRESSION_JPEG && planar == PLANARCONFIG_CONTIG)
+         {
+           TIFFSetField( tif, TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB );
+           profile_type = oyASSUMED_RGB;
+           break;
+         }
+    default:
+         message( oyMSG_WARN, object,
+                  OY_DBG_FORMAT_ " photometric %d not supported: %s",
+                  OY_DBG_ARGS_, photometric, filename );
+         info_good = 0;
+  }
+
+  if(sample_format == SAMPLEFORMAT_IEEEFP)
+    data_type = bps == 16 ? oyHALF : bps == 32 ? oyFLOAT : oyDOUBLE;
+  else
+    data_type = bps == 16 ? oyUINT16 : oyUINT8;
+  if(!(bps == 8 || bps == 16 || ((bps == 32 || bps == 64) &&
+                                 sample_format == SAMPLEFORMAT_IEEEFP)) ||
+     sample_format == SAMPLEFORMAT_INT)
+  {
+    message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ " %d bits per sample, format %d not supported: %s",
+             OY_DBG_ARGS_, bps, sample_format, filename );
+    info_good = 0;
+  }
+
+  pixel_layout = oyChannels_m(spp) | oyDataType_m(data_type);
+
+  if(TIFFIsTiled( tif ))
+  {
+    TIFFGetField( tif, TIFFTAG_TILEWIDTH, &tw );
+    TIFFGetField( tif, TIFFTAG_TILELENGTH, &th );
+  } else
+  {
+    tw = width;
+    TIFFGetFieldDefaulted( tif, TIFFTAG_ROWSPERSTRIP, &th );
+    if(th > height)
+      th = height;
+  }
+  if(!width || !height || !tw || !th)
+    info_good = 0;
+
+  if(TIFFGetField( tif, TIFFTAG_ICCPROFILE, &icc_size, &icc ) && icc_size)
+  {
+    prof = oyProfile_FromMem( icc_size, icc, 0,0 );
+    message( oyMSG_DBG, object,
+             OY_DBG_FORMAT_ " ICC profile (size: %d)",
+             OY_DBG_ARGS_, (int)icc_size );
+  }
+  if(!prof)
+    prof = oyProfile_FromStd( profile_type, 0 );
+
+  /* hand the file over to the image */
+  if(info_good)
+    oyAllocHelper_m_( d, oTIFDecoder_s, 1, oyAllocateFunc_, info_good = 0 );
+  if(d)
+  {
+    d->width = width;
+    d->height = height;
+    d->spp = spp;
+    d->byteps = bps / 8;
+    d->planar = planar == PLANARCONFIG_SEPARATE && spp > 1;
+    d->tiled = TIFFIsTiled( tif );
+    d->tile_width = tw;
+    d->tile_height = th;
+    d->tiles_across = (width + tw - 1) / tw;
+    d->tiles_down = (height + th - 1) / th;
+    d->row_size = (size_t)width * spp * d->byteps;
+
+    oyAllocHelper_m_( d->bands, uint8_t*, d->tiles_down, oyAllocateFunc_,
+                      info_good = 0 );
+    if(info_good)
+      oyAllocHelper_m_( d->decoded, char, d->tiles_across * d->tiles_down,
+                        oyAllocateFunc_, info_good = 0 );
+    if(info_good)
+      oyAllocHelper_m_( d->tile_rows, oyPointer*,
+                        d->tiles_across * d->tiles_down,
+                        oyAllocateFunc_, info_good = 0 );
+    if(info_good)
+      oyAllocHelper_m_( d->buf, uint8_t, (size_t)tw * th * spp * d->byteps,
+                        oyAllocateFunc_, info_good = 0 );
+  }
+
+  if(d && info_good)
+  {
+    oyPointer_s * pixel_data = oyPointer_New( 0 );
+
+    d->tif = tif;
+    tif = 0;
+
+    oyPointer_Set( pixel_data, 0, "oTIFDecoder_s", d, "oTIFDecoder_s",
+                   oTIFDecoderRelease_ );
+    d = 0;
+    image_in = oyImage_CreateFromData( width, height, pixel_layout, prof,
+                                       (oyStruct_s**) &pixel_data,
+                                       oTIFGetPoint_, oTIFGetLine_,
+                                       oTIFGetTile_, 0, 0, 0, 0 );
+    oyPointer_Release( &pixel_data );
+  } else if(d)
+  {
+    oyPointer ptr = d;
+    oTIFDecoderRelease_( &ptr );
+    d = 0;
+  }
+  oyProfile_Release( &prof );
+  if(tif)
+    TIFFClose( tif );
+
+  if(!image_in)
+  {
+    message( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ "TIFF can't create a new image\n%dx%d %d",
+             OY_DBG_ARGS_,  width, height, pixel_layout );
+    return NULL;
+  }
+
+  image_in->tile_width = tw;
+  image_in->tile_height = th;
+
+  oyOptions_SetFromText( &image_in->tags,
+                         "//" OY_TYPE_STD "/input_tiff.file_read/filename",
+                         filename, OY_CREATE_NEW );
+
+  return image_in;
+}
+
+/** @func    oTIFFilterPlug_ImageInputTIFFRun
+ *  @brief   implement oyCMMFilter_GetNext_f()
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+int      oTIFFilterPlug_ImageInputTIFFRun (
+                                       oyFilterPlug_s    * requestor_plug,
+                                       oyPixelAccess_s   * ticket )
+{
+  /* module variables */
+  oyFilterSocket_s * socket = 0;
+  oyFilterNode_s * node = 0;
+  int error = 0;
+  oyImage_s * image_in = 0;
+
+  /* file variables */
+  const char * filename = 0;
+
+  /* passing through the data reading */
+  if(requestor_plug->type_ == oyOBJECT_FILTER_PLUG_S &&
+     requestor_plug->remote_socket_->data)
+  {
+    error = oyFilterPlug_ImageRootRun( requestor_plug, ticket );
+
+    return error;
+
+  } else if(requestor_plug->type_ == oyOBJECT_FILTER_SOCKET_S)
+  {
+    /* To open the a image here seems not so straight forward.
+     * Still the plug-in should be prepared to initialise the image data before
+     * normal processing occurs.
+     */
+    socket = (oyFilterSocket_s*) requestor_plug;
+    requestor_plug = 0;
+    node = socket->node;
+
+  } else {
+    /* second option to open the file */
+    socket = requestor_plug->remote_socket_;
+    node = socket->node;
+  }
+
+  if(error <= 0)
+    filename = oyOptions_FindString( node->core->options_, "filename", 0 );
+
+  image_in = oyImage_FromTIFF( filename, (oyStruct_s*)node );
+
+  if(!image_in)
+  {
+    message( oyMSG_WARN, (oyStruct_s*)node,
+             OY_DBG_FORMAT_ " failed: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
+    return error;
+  }
+
+  if(error <= 0)
+  {
+    socket->data = (oyStruct_s*)oyImage_Copy( image_in, 0 );
+  }
+
+  if(ticket &&
+     ticket->output_image &&
+     ticket->output_image->width == 0 &&
+     ticket->output_image->height == 0)
+  {
+    ticket->output_image->width = image_in->width;
+    ticket->output_image->height = image_in->height;
+    oyImage_SetCritical( ticket->output_image, image_in->layout_[0], 0,0 );
+  }
+
+  oyImage_Release( &image_in );
+
+  /* return an error to cause the graph to retry */
+  return 1;
+}
+
+const char tiff_read_extra_options[] = {
+ "\n\
+  <" OY_TOP_SHARED ">\n\
+   <" OY_DOMAIN_INTERNAL ">\n\
+    <" OY_TYPE_STD ">\n\
+     <" "file_read" ">\n\
+      <filename></filename>\n\
+     </" "file_read" ">\n\
+    </" OY_TYPE_STD ">\n\
+   </" OY_DOMAIN_INTERNAL ">\n\
+  </" OY_TOP_SHARED ">\n"
+};
+
+int  oTIFTIFFreadUiGet               ( oyOptions_s       * opts,
+                                       char             ** xforms_layout,
+                                       oyAlloc_f           allocateFunc )
+{
+  char * text = (char*)allocateFunc(5);
+  text[0] = 0;
+  *xforms_layout = text;
+  return 0;
+}
+
+
+oyConnectorImaging_s oTIF_imageInputTIFF_connector = {
+  oyOBJECT_CONNECTOR_IMAGING_S,0,0,
+                               (oyObject_s)&oy_connector_imaging_static_object,
+  oyCMMgetImageConnectorSocketText, /* getText */
+  oy_image_connector_texts, /* texts */
+  "//" OY_TYPE_STD "/image.data", /* connector_type */
+  oyFilterSocket_MatchImagingPlug, /* filterSocket_MatchPlug */
+  0, /* is_plug == oyFilterPlug_s */
+  oTIF_image_tiff_data_types,
+  5, /* data_types_n; elements in data_types array */
+  -1, /* max_colour_offset */
+  1, /* min_channels_count; */
+  16, /* max_channels_count; */
+  1, /* min_colour_count; */
+  15, /* max_colour_count; */
+  0, /* can_planar; can read separated channels */
+  1, /* can_interwoven; can read continuous channels */
+  0, /* can_swap; can swap colour channels (BGR)*/
+  0, /* can_swap_bytes; non host byte order */
+  0, /* can_revert; revert 1 -> 0 and 0 -> 1 */
+  1, /* can_premultiplied_alpha; */
+  1, /* can_nonpremultiplied_alpha; */
+  0, /* can_subpixel; understand subpixel order */
+  0, /* oyCHANNELTYPE_e    * channel_types; */
+  0, /* count in channel_types */
+  1, /* id; relative to oyFilter_s, e.g. 1 */
+  0  /* is_mandatory; mandatory flag */
+};
+oyConnectorImaging_s * oTIF_imageInputTIFF_connectors[2] =
+             { &oTIF_imageInputTIFF_connector, 0 };
+
+
+/**
+ *  This function implements oyCMMGetText_f.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+const char * oTIFApi4ImageInputUiGetText (
+                                       const char        * select,
+                                       oyNAME_e            type,
+                                       oyStruct_s        * context )
+{
+  static char * category = 0;
+  if(strcmp(select,"name"))
+  {
+         if(type == oyNAME_NICK)
+      return "input_tiff";
+    else if(type == oyNAME_NAME)
+      return _("Image[input_tiff]");
+    else
+      return _("Input TIFF Image Filter Object");
+  }
+  else if(strcmp(select,"category"))
+  {
+    if(!category)
+    {
+      STRING_ADD( category, _("Files") );
+      STRING_ADD( category, _("/") );
+      STRING_ADD( category, _("Read TIFF") );
+    }
+         if(type == oyNAME_NICK)
+      return "category";
+    else if(type == oyNAME_NAME)
+      return category;
+    else
+      return category;
+  }
+  else if(strcmp(select,"help"))
+  {
+         if(type == oyNAME_NICK)
+      return "help";
+    else if(type == oyNAME_NAME)
+      return _("Option \"filename\", a valid filename of a existing TIFF image");
+    else
+      return _("The Option \"filename\" should contain a valid filename to read the tiff data from. If the file does not exist, a error will occure.\nThe ICC profile tag is searched for or a assumed ICC profile after the photometric interpretation will be attached to the resulting image. Tiles and strips are decoded on request.");
+  }
+  return 0;
+}
+const char * oTIF_api4_image_input_tiff_ui_texts[] = {"name", "category", "help", 0};
+
+/** @instance oTIF_api4_ui_image_input_tiff
+ *  @brief    oTIF oyCMMapi4_s::ui implementation
+ *
+ *  The UI for filter input tiff.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMui_s oTIF_api4_ui_image_input_tiff = {
+  oyOBJECT_CMM_DATA_TYPES_S,           /**< oyOBJECT_e       type; */
+  0,0,0,                            /* unused oyStruct_s fields; keep to zero */
+
+  CMM_VERSION,                         /**< int32_t version[3] */
+  {0,3,0},                            /**< int32_t module_api[3] */
+
+  oTIFFilter_ImageInputTIFFValidateOptions, /* oyCMMFilter_ValidateOptions_f */
+  oTIFWidgetEvent, /* oyWidgetEvent_f */
+
+  "Files/Read TIFF", /* category */
+  tiff_read_extra_options, /* const char * options */
+  oTIFTIFFreadUiGet, /* oyCMMuiGet_f oyCMMuiGet */
+
+  oTIFApi4ImageInputUiGetText, /* oyCMMGetText_f   getText */
+  oTIF_api4_image_input_tiff_ui_texts /* const char    ** texts */
+};
+
+/** @instance oTIF_api4
+ *  @brief    oTIF oyCMMapi4_s implementation
+ *
+ *  A filter for reading a TIFF image.
+ *
+ *  @par Options:
+ *  - "filename" - the file name to read from
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMapi4_s   oTIF_api4_image_input_tiff = {
+
+  oyOBJECT_CMM_API4_S, /* oyStruct_s::type oyOBJECT_CMM_API4_S */
+  0,0,0, /* unused oyStruct_s fileds; keep to zero */
+  (oyCMMapi_s*) & oTIF_api7_image_input_tiff, /* oyCMMapi_s * next */
+
+  oTIFCMMInit, /* oyCMMInit_f */
+  oTIFCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
+
+  /* registration */
+  OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL OY_SLASH OY_TYPE_STD "/input_tiff.file_read._CPU._" CMM_NICK,
+
+  CMM_VERSION, /* int32_t version[3] */
+  {0,3,0},                  /**< int32_t module_api[3] */
+  0,   /* id_; keep empty */
+  0,   /* api5_; keep empty */
+
+  oyFilterNode_TextToInfo_, /* oyCMMFilterNode_ContextToMem_f */
+  0, /* oyCMMFilterNode_GetText_f        oyCMMFilterNode_GetText */
+  {0}, /* char context_type[8] */
+
+  &oTIF_api4_ui_image_input_tiff        /**< oyCMMui_s *ui */
+};
+
+char * oTIF_api7_image_input_tiff_properties[] =
+{
+  "file=read",    /* file load|write */
+  "image=pixel",  /* image type, pixel/vector/font */
+  "layers=1",     /* layer count, one for plain images */
+  "icc=1",        /* image type ICC profile support */
+  "ext=tif,tiff", /* supported extensions */
+  "magic=49492a00,4d4d002a,49492b00,4d4d002b", /* file signatures */
+  0
+};
+
+/** @instance oTIF_api7
+ *  @brief    oTIF oyCMMapi7_s implementation
+ *
+ *  A filter reading a TIFF image.
+ *
+ *  @par Options:
+ *  - "filename" - the file name to read from
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/05 (Oyranos: 0.3.2)
+ *  @date    2011/10/05
+ */
+oyCMMapi7_s   oTIF_api7_image_input_tiff = {
+
+  oyOBJECT_CMM_API7_S, /* oyStruct_s::type oyOBJECT_CMM_API7_S */
+  0,0,0, /* unused oyStruct_s fileds; keep to zero */
+  (oyCMMapi_s*) NULL, /* oyCMMapi_s * next */
+
+  oTIFCMMInit, /* oyCMMInit_f */
+  oTIFCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
+
+  /* registration */
+  OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL OY_SLASH OY_TYPE_STD "/input_tiff.file_read._CPU._" CMM_NICK,
+
+  CMM_VERSION, /* int32_t version[3] */
+  {0,3,0},                  /**< int32_t module_api[3] */
+  0,   /* id_; keep empty */
+  0,   /* api5_; keep empty */
+
+  oTIFFilterPlug_ImageInputTIFFRun, /* oyCMMFilterPlug_Run_f */
+  {0}, /* char data_type[8] */
+
+  0,   /* plugs */
+  0,   /* plugs_n */
+  0,   /* plugs_last_add */
+  (oyConnector_s**) oTIF_imageInputTIFF_connectors,   /* sockets */
+  1,   /* sockets_n */
+  0,    /* sockets_last_add */
+
+  oTIF_api7_image_input_tiff_properties /* char * properties */
+};
+
+/* ---------------------------------------------------------------------------*/
+
@@ -465,14 +465,19 @@ int  oydiFilterSocket_ImageDisplayInit(oyFilterSocket_s  * socket,
 /** @func    oydiFilterPlug_ImageDisplayRun
  *  @brief   implement oyCMMFilter_GetNext_f()
  *
- *  @version Oyranos: 0.1.10
+ *  Damaged window regions can be placed as "//imaging/display/damage"
+ *  rectangles in the output image tags. The rectangles are in pixels
+ *  relative to the display rectangle. With damage present only those
+ *  regions are processed and the tags are removed afterwards.
+ *
+ *  @version Oyranos: 0.3.2
  *  @since   2009/02/23 (Oyranos: 0.1.10)
- *  @date    2009/03/17
+ *  @date    2011/11/24
  */
 int      oydiFilterPlug_ImageDisplayRun(oyFilterPlug_s   * requestor_plug,
                                        oyPixelAccess_s   * ticket )
 {
-  int n = 0, i;
+  int n = 0, i, j, damage_n = 0;
   int result = 0, l_result = 0, error = 0;
   oyFilterGraph_s * display_graph = 0;
   oyFilterSocket_s * socket = requestor_plug->remote_socket_;
@@ -482,7 +487,9 @@ int      oydiFilterPlug_ImageDisplayRun(oyFilterPlug_s   * requestor_plug,
             * image_input = 0;
   oyOption_s * o = 0;
   oyRectangle_s * r, * device_rectangle, * display_rectangle;
-  oyRectangle_s roi_pix = {oyOBJECT_RECTANGLE_S,0,0,0};
+  oyRectangle_s roi_pix = {oyOBJECT_RECTANGLE_S,0,0,0},
+                roi_all = {oyOBJECT_RECTANGLE_S,0,0,0},
+                damage_pix = {oyOBJECT_RECTANGLE_S,0,0,0};
   oyConfigs_s * devices = 0;
   oyConfig_s * c = 0;
   oyProfile_s * p = 0;
@@ -612,7 +619,9 @@ int      oydiFilterPlug_ImageDisplayRun(oyFilterPlug_s   * requestor_plug,
     if(!n || oyFilterNode_EdgeCount( rectangles, 1, OY_FILTEREDGE_CONNECTED ) < n)
       return 1;
 
-    /* process all display rectangles */
+    /* process all display rectangles; send the option and image change
+     * signals once after the loop */
+    oyObserverBatchBegin();
     if(error <= 0)
     for(i = 0; i < n; ++i)
     {
@@ -694,6 +703,7 @@ int      oydiFilterPlug_ImageDisplayRun(oyFilterPlug_s   * requestor_plug,
 
       oyConfig_Release( &c );
     }
+    oyObserverBatchEnd();
 
     oyConfigs_Release( &devices );
 
@@ -706,9 +716,54 @@ int      oydiFilterPlug_ImageDisplayRun(oyFilterPlug_s   * requestor_plug,
     }
 
 
-    /* make the graph flow: process the upstream "rectangles" node */
-    l_result = rectangles->api7_->oyCMMFilterPlug_Run( node->plugs[0], ticket );
-    if(l_result > 0 || result == 0) result = l_result;
+    /* process only the damaged window regions, if any are given */
+    if(image)
+      damage_n = oyOptions_CountType( image->tags,
+                                      "//" OY_TYPE_STD "/display/damage",
+                                      oyOBJECT_RECTANGLE_S );
+    if(damage_n)
+    {
+      oyRectangle_SetByRectangle( &roi_all, ticket->output_image_roi );
+
+      for(j = 0; j < damage_n; ++j)
+      {
+        r = (oyRectangle_s *) oyOptions_GetType( image->tags, j,
+                                       "//" OY_TYPE_STD "/display/damage",
+                                                 oyOBJECT_RECTANGLE_S );
+        oyRectangle_SetByRectangle( &damage_pix, r );
+        oyRectangle_Release( &r );
+
+        /* the rectangles node trims each branch ticket to this region */
+        if(image->width != 0)
+          oyRectangle_Scale( &damage_pix, 1./image->width );
+        oyRectangle_SetByRectangle( ticket->output_image_roi, &damage_pix );
+        oyRectangle_Trim( ticket->output_image_roi, &roi_all );
+
+        if(oy_debug)
+          oydi_msg( oyMSG_DBG, (oyStruct_s*)image,
+                    OY_DBG_FORMAT_"damage %d: %s", OY_DBG_ARGS_, j,
+                    oyRectangle_Show( ticket->output_image_roi ) );
+
+        if(oyRectangle_CountPoints( ticket->output_image_roi ) <= 0)
+          continue;
+
+        /* make the graph flow: process the upstream "rectangles" node */
+        l_result = rectangles->api7_->oyCMMFilterPlug_Run( node->plugs[0],
+                                                           ticket );
+        if(l_result > 0 || result == 0) result = l_result;
+      }
+
+      oyRectangle_SetByRectangle( ticket->output_image_roi, &roi_all );
+
+      /* the damage is handled */
+      oyImage_TagsClear( image, "//" OY_TYPE_STD "/display/damage" );
+    } else
+    {
+      /* make the graph flow: process the upstream "rectangles" node */
+      l_result = rectangles->api7_->oyCMMFilterPlug_Run( node->plugs[0],
+                                                         ticket );
+      if(l_result > 0 || result == 0) result = l_result;
+    }
   }
 
   clean:
@@ -735,6 +790,7 @@ char oydi_extra_options[] = {
       <display_id.invisible></display_id.invisible>\n\
       <window_id.invisible></window_id.invisible>\n\
       <display_rectangle.invisible></display_rectangle.invisible>\n\
+      <damage.invisible></damage.invisible>\n\
       <datatype.advanced.invisible></datatype.advanced.invisible>\n\
       <preserve_alpha.advanced.invisible></preserve_alpha.advanced.invisible>\n\
      </" "display." CMM_NICK ">\n\
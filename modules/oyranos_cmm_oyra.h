@@ -74,6 +74,8 @@ extern oyCMMapi4_s   oyra_api4_image_write_ppm;
 extern oyCMMapi7_s   oyra_api7_image_write_ppm;
 extern oyCMMapi4_s   oyra_api4_image_rectangles;
 extern oyCMMapi7_s   oyra_api7_image_rectangles;
+extern oyCMMapi4_s   oyra_api4_image_scale;
+extern oyCMMapi7_s   oyra_api7_image_scale;
 extern oyCMMapi4_s   oyra_api4_image_output;
 extern oyCMMapi7_s   oyra_api7_image_output;
 extern oyCMMapi4_s   oyra_api4_image_root;
@@ -22,9 +22,11 @@
 #include "oyranos_icc.h"
 #include "oyranos_i18n.h"
 #include "oyranos_io.h"
+#include "oyranos_object_internal.h" /* oyAtomicCasPtr_m */
 #include "oyranos_definitions.h"
 #include "oyranos_string.h"
 #include "oyranos_texts.h"
+#include <ctype.h>
 #include <iconv.h>
 #include <math.h>
 #include <stdarg.h>
@@ -37,6 +39,7 @@
 
 /* OY_IMAGE_LOAD_REGISTRATION */
 /* OY_IMAGE_REGIONS_REGISTRATION */
+/* OY_IMAGE_SCALE_REGISTRATION */
 /* OY_IMAGE_ROOT_REGISTRATION */
 /* OY_IMAGE_OUTPUT_REGISTRATION */
 
@@ -82,32 +85,289 @@ oyPointer  oyraFilte15ode_ImageLoadContextToMem (
   return oyFilterNode_TextToInfo_( node, size, allocateFunc );
 }
 
+#define OYRA_MAGIC_MAX 12
+#define OYRA_MAGIC_LEN 16
+/** @internal
+ *  @struct  oyraFileReader_s
+ *  @brief   a file_read module with its file signatures
+ *
+ *  The signatures come from the "magic=" property of the oyCMMapi7_s, a
+ *  comma separated list of hexadecimal byte strings, which are expected at
+ *  the file start. e.g. "magic=89504e47" for PNG.
+ */
+typedef struct {
+  oyCMMapi7_s  * api7;                 /**< the reader */
+  char         * ext;                  /**< lower case "ext=" list */
+  uint8_t        magic[OYRA_MAGIC_MAX][OYRA_MAGIC_LEN];
+  int            magic_len[OYRA_MAGIC_MAX];
+  int            magic_n;              /**< zero for unknown signatures */
+} oyraFileReader_s;
+
+/** the index of pixel image readers, published once */
+typedef struct {
+  oyraFileReader_s * readers;
+  int                n;
+} oyraFileReaders_s;
+
+static oyraFileReaders_s * oyra_file_readers_ = 0;
+
+static void oyraFileReaderMagicParse_( oyraFileReader_s  * r,
+                                       const char        * text )
+{
+  while(*text && r->magic_n < OYRA_MAGIC_MAX)
+  {
+    int len = 0;
+    unsigned int byte;
+
+    while(len < OYRA_MAGIC_LEN && sscanf( text, "%2x", &byte ) == 1 &&
+          isxdigit( text[0] ) && isxdigit( text[1] ))
+    {
+      r->magic[r->magic_n][len++] = byte;
+      text += 2;
+    }
+    if(len)
+      r->magic_len[r->magic_n++] = len;
+    while(*text && *text != ',') ++text;
+    if(*text == ',') ++text;
+  }
+}
+
+/** @internal
+ *  @brief   release a index of pixel image readers
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static void oyraFileReadersRelease_  ( oyraFileReaders_s ** index )
+{
+  oyraFileReaders_s * idx = *index;
+  int i;
+
+  if(!idx)
+    return;
+
+  for(i = 0; i < idx->n; ++i)
+  {
+    oyraFileReader_s * r = &idx->readers[i];
+    oyCMMapiFilter_s * api = (oyCMMapiFilter_s*) r->api7;
+    if(r->ext)
+      oyFree_m_( r->ext );
+    if(api && api->release)
+      api->release( (oyStruct_s**)&api );
+  }
+  if(idx->readers)
+    oyFree_m_( idx->readers );
+  oyFree_m_( idx );
+  *index = 0;
+}
+
+#if defined(__GNUC__)
+/* the module has no unload hook; free the index as the library goes */
+static void oyraFileReadersFinish_   ( void ) __attribute__((destructor));
+static void oyraFileReadersFinish_   ( void )
+{
+  oyraFileReaders_s * idx = oyAtomicGet_m( &oyra_file_readers_ );
+  if(idx && oyAtomicCasPtr_m( &oyra_file_readers_, idx, 0 ))
+    oyraFileReadersRelease_( &idx );
+}
+#endif
+
+/** @internal
+ *  @brief   the index of pixel image readers
+ *
+ *  The module scan happens only on the first call. Concurrent first
+ *  callers may each scan; only one index is published and the others
+ *  are released.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/11 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+static int oyraFileReadersGet_       ( oyraFileReader_s ** readers )
+{
+  oyraFileReaders_s * idx = oyAtomicGet_m( &oyra_file_readers_ );
+
+  if(!idx)
+  {
+    uint32_t i, j, k, n,
+           * rank_list = 0;
+    oyCMMapiFilters_s * apis = oyCMMsGetFilterApis_( 0,0,
+                                 "//" OY_TYPE_STD "/file_read",
+                                 oyOBJECT_CMM_API7_S,
+                                 oyFILTER_REG_MODE_STRIP_IMPLEMENTATION_ATTR,
+                                 &rank_list,0 );
+
+    n = oyCMMapiFilters_Count( apis );
+    oyAllocHelper_m_( idx, oyraFileReaders_s, 1, 0, n = 0 );
+    if(idx && n)
+      oyAllocHelper_m_( idx->readers, oyraFileReader_s, n, 0, n = 0 );
+
+    for(i = 0; i < n; ++i)
+    {
+      int file_read = 0,
+          image_pixel = 0;
+      oyCMMapiFilter_s * api = oyCMMapiFilters_Get( apis, i );
+      oyCMMapi7_s * api7 = (oyCMMapi7_s*) api;
+      oyraFileReader_s * r = &idx->readers[idx->n];
+
+      j = 0;
+      if(api7 && api7->properties)
+        while(api7->properties[j] && api7->properties[j][0])
+        {
+          const char * prop = api7->properties[j];
+
+          if(strcmp( prop, "file=read" ) == 0)
+            file_read = 1;
+
+          if(strstr( prop, "image=" ) != 0 &&
+             strstr( prop, "pixel" ) != 0)
+            image_pixel = 1;
+
+          if(strstr( prop, "ext=" ) == prop)
+          {
+            STRING_ADD( r->ext, &prop[4] );
+            k = 0;
+            while(r->ext[k]) { r->ext[k] = tolower( r->ext[k] ); ++k; }
+          }
+
+          if(strstr( prop, "magic=" ) == prop)
+            oyraFileReaderMagicParse_( r, &prop[6] );
+          ++j;
+        }
+
+      /* the api stays referenced in the index */
+      if(file_read && image_pixel)
+      {
+        r->api7 = api7;
+        ++idx->n;
+      } else
+      {
+        if(r->ext)
+          oyFree_m_( r->ext );
+        memset( r, 0, sizeof(oyraFileReader_s) );
+        if(api && api->release)
+          api->release( (oyStruct_s**)&api );
+      }
+    }
+    oyCMMapiFilters_Release( &apis );
+    if(rank_list)
+      oyFree_m_( rank_list );
+
+    /* publish; a concurrent scan might have been faster */
+    if(idx && !oyAtomicCasPtr_m( &oyra_file_readers_, 0, idx ))
+    {
+      oyraFileReadersRelease_( &idx );
+      idx = oyAtomicGet_m( &oyra_file_readers_ );
+    }
+  }
+
+  *readers = idx ? idx->readers : 0;
+  return idx ? idx->n : 0;
+}
+
+/** @internal
+ *  @brief   select a file reader
+ *
+ *  The file signature rules over the extension. A reader with matching
+ *  extension and signature is taken first. Readers without known
+ *  signatures are trusted by extension. A file with a wrong or missing
+ *  extension goes to the first reader with matching signature.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/11 (Oyranos: 0.3.2)
+ *  @date    2011/10/11
+ */
+static oyCMMapi7_s * oyraFileReaderSelect_ (
+                                       const char        * filename,
+                                       const char        * file_ext,
+                                       oyStruct_s        * object )
+{
+  oyraFileReader_s * readers = 0;
+  int n = oyraFileReadersGet_( &readers ),
+      i, j, pass;
+  uint8_t head[OYRA_MAGIC_LEN];
+  size_t head_len = 0;
+  int * sig_match = 0;
+  FILE * fp;
+  oyCMMapi7_s * api7 = 0;
+
+  if(!n)
+  {
+    oyra_msg( oyMSG_WARN, object,
+             OY_DBG_FORMAT_ "Could not find any file_load plugin.",
+             OY_DBG_ARGS_ );
+    return 0;
+  }
+
+  fp = fopen( filename, "rb" );
+  if(fp)
+  {
+    head_len = fread( head, 1, OYRA_MAGIC_LEN, fp );
+    fclose( fp );
+  }
+
+  oyAllocHelper_m_( sig_match, int, n, 0, return 0 );
+  for(i = 0; i < n; ++i)
+  {
+    /* -1 unknown signature, 0 mismatch, 1 match */
+    sig_match[i] = readers[i].magic_n ? 0 : -1;
+    for(j = 0; j < readers[i].magic_n; ++j)
+      if(readers[i].magic_len[j] <= (int)head_len &&
+         memcmp( readers[i].magic[j], head, readers[i].magic_len[j] ) == 0)
+        sig_match[i] = 1;
+  }
+
+  for(pass = 0; pass < 3 && !api7; ++pass)
+    for(i = 0; i < n && !api7; ++i)
+    {
+      int ext_match = file_ext && readers[i].ext &&
+                      strstr( readers[i].ext, file_ext ) != 0;
+
+      if((pass == 0 && ext_match && sig_match[i] == 1) ||
+         (pass == 1 && ext_match && sig_match[i] == -1) ||
+         (pass == 2 && sig_match[i] == 1))
+        api7 = readers[i].api7;
+    }
+
+  oyDeAllocateFunc_( sig_match );
+
+  return api7;
+}
+
 /** @func    oyraFilterPlug_ImageLoadRun
  *  @brief   implement oyCMMFilter_GetNext_f()
  *
- *  @version Oyranos: 0.1.10
+ *  The reader is selected by a signature index of all file_read modules.
+ *
+ *  @version Oyranos: 0.3.2
  *  @since   2009/07/15 (Oyranos: 0.1.10)
- *  @date    2010/06/24
+ *  @date    2011/10/11
  */
 int      oyraFilterPlug_ImageLoadRun (
                                        oyFilterPlug_s    * requestor_plug,
                                        oyPixelAccess_s   * ticket )
 {
   int result = 0, error = 0;
-  oyFilterSocket_s * socket = requestor_plug->remote_socket_;
-  oyFilterNode_s * node = socket->node;
-  oyImage_s * image = (oyImage_s*)socket->data;
-  oyCMMapiFilter_s * api = 0;
-  oyCMMapiFilters_s * apis = 0;
+  oyFilterSocket_s * socket = 0;
+  oyFilterNode_s * node = 0;
+  oyImage_s * image = 0;
+
+  /* oyConversion_GetImage() asks the input socket directly */
+  if(requestor_plug->type_ == oyOBJECT_FILTER_SOCKET_S)
+    socket = (oyFilterSocket_s*) requestor_plug;
+  else
+    socket = requestor_plug->remote_socket_;
+  node = socket->node;
 
   image = (oyImage_s*)socket->data;
   if(!image)
   {
-    uint32_t i, j, k, n,
-           * rank_list = 0;
+    uint32_t i;
     const char * filename = oyOptions_FindString( node->core->options_, "filename", 0 );
     const char * fileext = 0;
     char * file_ext = 0;
+    oyCMMapi7_s * api7 = 0;
 
     if(filename)
     {
@@ -130,65 +390,14 @@ int      oyraFilterPlug_ImageLoadRun (
       while(file_ext[i]) { file_ext[i] = tolower( file_ext[i] ); ++i; }
     }
 
-    apis = oyCMMsGetFilterApis_( 0,0, "//" OY_TYPE_STD "/file_read", 
-                                 oyOBJECT_CMM_API7_S,
-                                 oyFILTER_REG_MODE_STRIP_IMPLEMENTATION_ATTR,
-                                 &rank_list,0 );
-
-    n = oyCMMapiFilters_Count( apis );
-    if(apis)
-    {
-      for(i = 0; i < n; ++i)
-      {
-        int file_read = 0,
-            image_pixel = 0,
-            found = 0;
-        oyCMMapi7_s * api7;
-        char * api_ext = 0;
-
-        j = 0;
-        api = oyCMMapiFilters_Get( apis, i );
-        api7 = (oyCMMapi7_s*) api;
-
-        if(api7->properties)
-          while(api7->properties[j] && api7->properties[j][0])
-          {
-            if(strcmp( api7->properties[j], "file=read" ) == 0)
-              file_read = 1;
-
-            if(strstr( api7->properties[j], "image=" ) != 0 &&
-               strstr( api7->properties[j], "pixel" ) != 0)
-              image_pixel = 1;
-
-            if(file_ext && strstr( api7->properties[j], "ext=" ) != 0)
-            {
-              STRING_ADD( api_ext,  &api7->properties[j][4] );
-              k = 0;
-              while(api_ext[k]) { api_ext[k] = tolower( api_ext[k] ); ++k; }
-              if(strstr( api_ext, file_ext ) != 0)
-                found = 1;
-              oyFree_m_( api_ext );
-            }
-            ++j;
-          }
-
-
-        if(file_read && image_pixel && found)
-        {
-          result = api7->oyCMMFilterPlug_Run( requestor_plug, ticket );
-          i = n;
-        }
-
-        if(api->release)
-          api->release( (oyStruct_s**)&api );
-      }
-      oyCMMapiFilters_Release( &apis );
-    }
-
-    if( !n )
+    api7 = oyraFileReaderSelect_( filename, file_ext,
+                                  (oyStruct_s*)requestor_plug );
+    if(api7)
+      result = api7->oyCMMFilterPlug_Run( requestor_plug, ticket );
+    else
       oyra_msg( oyMSG_WARN, (oyStruct_s*)requestor_plug,
-             OY_DBG_FORMAT_ "Could not find any file_load plugin.",
-             OY_DBG_ARGS_ );
+             OY_DBG_FORMAT_ "No file_load plugin for: %s",
+             OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
 
     oyFree_m_(file_ext);
   }
@@ -622,7 +831,7 @@ oyCMMapi7_s   oyra_api7_image_rectangles = {
 
   oyOBJECT_CMM_API7_S, /* oyStruct_s::type oyOBJECT_CMM_API7_S */
   0,0,0, /* unused oyStruct_s fileds; keep to zero */
-  (oyCMMapi_s*) & oyra_api4_image_write_ppm, /* oyCMMapi_s * next */
+  (oyCMMapi_s*) & oyra_api4_image_scale, /* oyCMMapi_s * next */
   
   oyraCMMInit, /* oyCMMInit_f */
   oyraCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
@@ -734,6 +943,643 @@ oyCMMapi4_s   oyra_api4_image_rectangles = {
 
 /* OY_IMAGE_REGIONS_REGISTRATION ---------------------------------------------*/
 
+/* OY_IMAGE_SCALE_REGISTRATION -----------------------------------------------*/
+
+
+oyDATATYPE_e oyra_image_scale_data_types[5] = {oyUINT8, oyUINT16,
+                                               oyFLOAT, oyDOUBLE, 0};
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/** @internal
+ *  scale filter kernels; t is in source pixels */
+static double oyraScaleKernel_       ( int                 method,
+                                       double              t )
+{
+  t = fabs(t);
+  switch(method)
+  {
+  case 0: /* box */
+       return t < 0.5 ? 1.0 : (t == 0.5 ? 0.5 : 0.0);
+  case 1: /* bilinear */
+       return t < 1.0 ? 1.0 - t : 0.0;
+  case 2: /* Lanczos3 */
+       if(t < 1e-8)
+         return 1.0;
+       if(t >= 3.0)
+         return 0.0;
+       return 3.0 * sin(M_PI * t) * sin(M_PI * t / 3.0) / (M_PI * M_PI * t*t);
+  }
+  return 0.0;
+}
+
+static const double oyra_scale_support_[3] = { 0.5, 1.0, 3.0 };
+
+/** @internal
+ *  Function oyraScaleWeights_
+ *  @brief   precalculate the filter taps for one dimension
+ *
+ *  @param[in]     method              0 - box, 1 - bilinear, 2 - Lanczos3
+ *  @param[in]     scale               destination / source size
+ *  @param[in]     dst_pos             first destination pixel in image
+ *  @param[in]     dst_n               destination pixels
+ *  @param[in]     src_pos             first source pixel in source array
+ *  @param[in]     src_n               source pixels in array
+ *  @param[out]    start               first tap per destination pixel
+ *  @param[out]    taps                taps per destination pixel
+ *  @param[out]    weights             taps_max normalised weights per pixel
+ *  @return                            taps_max
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/13 (Oyranos: 0.3.2)
+ *  @date    2011/09/13
+ */
+static int   oyraScaleWeights_       ( int                 method,
+                                       double              scale,
+                                       int                 dst_pos,
+                                       int                 dst_n,
+                                       int                 src_pos,
+                                       int                 src_n,
+                                       int              ** start,
+                                       int              ** taps,
+                                       float            ** weights )
+{
+  /* widen the kernel for minification to average all covered pixels */
+  double stretch = scale < 1.0 ? 1.0 / scale : 1.0,
+         support = oyra_scale_support_[method] * stretch;
+  int taps_max = (int)ceil( 2.0 * support ) + 2;
+  int i, j, error = 0;
+
+  oyAllocHelper_m_( *start, int, dst_n, 0, error = 1 );
+  oyAllocHelper_m_( *taps, int, dst_n, 0, error = 1 );
+  oyAllocHelper_m_( *weights, float, dst_n * taps_max, 0, error = 1 );
+  if(error)
+    return 0;
+
+  for(i = 0; i < dst_n; ++i)
+  {
+    double center = (dst_pos + i + 0.5) / scale - 0.5 - src_pos,
+           sum = 0.0;
+    int first = (int)ceil( center - support ),
+        last = (int)floor( center + support );
+    float * w = &(*weights)[i * taps_max];
+
+    if(first < 0) first = 0;
+    if(last >= src_n) last = src_n - 1;
+    if(last - first + 1 > taps_max) last = first + taps_max - 1;
+
+    for(j = first; j <= last; ++j)
+    {
+      w[j - first] = oyraScaleKernel_( method, (j - center) / stretch );
+      sum += w[j - first];
+    }
+
+    if(sum > 0.0 && last >= first)
+      for(j = 0; j <= last - first; ++j)
+        w[j] /= sum;
+    else
+    {
+      /* no coverage at the border; use the nearest pixel */
+      first = OY_ROUND( center );
+      if(first < 0) first = 0;
+      if(first >= src_n) first = src_n - 1;
+      last = first;
+      w[0] = 1.0f;
+    }
+
+    (*start)[i] = first;
+    (*taps)[i] = last - first + 1;
+  }
+
+  return taps_max;
+}
+
+/** @internal
+ *  Function oyraScaleLineToFloat_
+ *  @brief   convert a line of samples for processing
+ */
+static void  oyraScaleLineToFloat_   ( const oyPointer     src,
+                                       oyDATATYPE_e        data_type,
+                                       float             * dst,
+                                       int                 n )
+{
+  int i;
+  switch(data_type)
+  {
+  case oyUINT8:  { const uint8_t * s = (const uint8_t*)src;
+                   for(i = 0; i < n; ++i) dst[i] = s[i]; } break;
+  case oyUINT16: { const uint16_t * s = (const uint16_t*)src;
+                   for(i = 0; i < n; ++i) dst[i] = s[i]; } break;
+  case oyFLOAT:  memcpy( dst, src, n * sizeof(float) ); break;
+  case oyDOUBLE: { const double * s = (const double*)src;
+                   for(i = 0; i < n; ++i) dst[i] = s[i]; } break;
+  default: break;
+  }
+}
+
+/** @internal
+ *  Function oyraScaleLineFromFloat_
+ *  @brief   store processed samples with rounding and clipping
+ */
+static void  oyraScaleLineFromFloat_ ( const float       * src,
+                                       oyDATATYPE_e        data_type,
+                                       oyPointer           dst,
+                                       int                 n )
+{
+  int i;
+  float v;
+  switch(data_type)
+  {
+  case oyUINT8:  { uint8_t * d = (uint8_t*)dst;
+                   for(i = 0; i < n; ++i)
+                   { v = src[i] + 0.5f;
+                     d[i] = v < 0.0f ? 0 : v > 255.0f ? 255 : (uint8_t)v; }
+                 } break;
+  case oyUINT16: { uint16_t * d = (uint16_t*)dst;
+                   for(i = 0; i < n; ++i)
+                   { v = src[i] + 0.5f;
+                     d[i] = v < 0.0f ? 0 : v > 65535.0f ? 65535 : (uint16_t)v; }
+                 } break;
+  case oyFLOAT:  memcpy( dst, src, n * sizeof(float) ); break;
+  case oyDOUBLE: { double * d = (double*)dst;
+                   for(i = 0; i < n; ++i) d[i] = src[i]; } break;
+  default: break;
+  }
+}
+
+/** @internal
+ *  Function oyraScaleArray_
+ *  @brief   resample a array region into a other array
+ *
+ *  The function is separable. Each destination line accumulates
+ *  horizontally filtered source lines with the vertical weights.
+ *
+ *  @param[in]     src                 source array, positioned at src_x/src_y
+ *  @param[in]     src_x               source array position in image pixels
+ *  @param[in]     src_y               source array position in image pixels
+ *  @param[in]     src_w               source pixels per line
+ *  @param[in]     src_h               source lines
+ *  @param[out]    dst                 destination array
+ *  @param[in]     dst_x               destination position in image pixels
+ *  @param[in]     dst_y               destination position in image pixels
+ *  @param[in]     dst_w               destination pixels per line
+ *  @param[in]     dst_h               destination lines
+ *  @param[in]     channels            samples per pixel
+ *  @param[in]     scale               destination / source size
+ *  @param[in]     method              0 - box, 1 - bilinear, 2 - Lanczos3
+ *  @return                            error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/13 (Oyranos: 0.3.2)
+ *  @date    2011/09/13
+ */
+static int   oyraScaleArray_         ( oyArray2d_s       * src,
+                                       int                 src_x,
+                                       int                 src_y,
+                                       int                 src_w,
+                                       int                 src_h,
+                                       oyArray2d_s       * dst,
+                                       int                 dst_x,
+                                       int                 dst_y,
+                                       int                 dst_w,
+                                       int                 dst_h,
+                                       int                 channels,
+                                       double              scale,
+                                       int                 method )
+{
+  int * hstart = 0, * htaps = 0, * vstart = 0, * vtaps = 0;
+  float * hweights = 0, * vweights = 0,
+        * line = 0, * hline = 0, * acc = 0;
+  int htaps_max, vtaps_max;
+  int x, y, k, t, c, error = 0;
+  oyDATATYPE_e data_type = src ? src->t : oyUINT8;
+
+  if(!src || !dst || src->t != dst->t || channels <= 0 || scale <= 0.0 ||
+     method < 0 || method > 2 ||
+     !(data_type == oyUINT8 || data_type == oyUINT16 ||
+       data_type == oyFLOAT || data_type == oyDOUBLE))
+    return 1;
+
+  if(dst_w <= 0 || dst_h <= 0 || src_w <= 0 || src_h <= 0)
+    return 0;
+
+  htaps_max = oyraScaleWeights_( method, scale, dst_x, dst_w, src_x, src_w,
+                                 &hstart, &htaps, &hweights );
+  vtaps_max = oyraScaleWeights_( method, scale, dst_y, dst_h, src_y, src_h,
+                                 &vstart, &vtaps, &vweights );
+  error = !htaps_max || !vtaps_max;
+
+  if(!error)
+  {
+    oyAllocHelper_m_( line, float, src_w * channels, 0, error = 1 );
+    oyAllocHelper_m_( hline, float, dst_w * channels, 0, error = 1 );
+    oyAllocHelper_m_( acc, float, dst_w * channels, 0, error = 1 );
+  }
+
+  if(!error)
+  for(y = 0; y < dst_h; ++y)
+  {
+    memset( acc, 0, sizeof(float) * dst_w * channels );
+
+    for(t = 0; t < vtaps[y]; ++t)
+    {
+      float wv = vweights[y * vtaps_max + t];
+      oyraScaleLineToFloat_( src->array2d[vstart[y] + t], data_type, line,
+                             src_w * channels );
+
+      /* horizontal pass */
+      if(channels == 3 || channels == 4)
+        for(x = 0; x < dst_w; ++x)
+        {
+          const float * w = &hweights[x * htaps_max];
+          const float * s = &line[hstart[x] * channels];
+          float * h = &hline[x * channels];
+          h[0] = h[1] = h[2] = 0.0f;
+          if(channels == 4) h[3] = 0.0f;
+          for(k = 0; k < htaps[x]; ++k)
+            for(c = 0; c < channels; ++c)
+              h[c] += w[k] * s[k * channels + c];
+        }
+      else
+        for(x = 0; x < dst_w; ++x)
+        {
+          const float * w = &hweights[x * htaps_max];
+          const float * s = &line[hstart[x] * channels];
+          float * h = &hline[x * channels];
+          for(c = 0; c < channels; ++c)
+            h[c] = 0.0f;
+          for(k = 0; k < htaps[x]; ++k)
+            for(c = 0; c < channels; ++c)
+              h[c] += w[k] * s[k * channels + c];
+        }
+
+      /* vertical accumulation */
+      for(x = 0; x < dst_w * channels; ++x)
+        acc[x] += wv * hline[x];
+    }
+
+    oyraScaleLineFromFloat_( acc, data_type, dst->array2d[y],
+                             dst_w * channels );
+  }
+
+  oyFree_m_( hstart ); oyFree_m_( htaps ); oyFree_m_( hweights );
+  oyFree_m_( vstart ); oyFree_m_( vtaps ); oyFree_m_( vweights );
+  oyFree_m_( line ); oyFree_m_( hline ); oyFree_m_( acc );
+
+  return error;
+}
+
+/** @func    oyraFilterPlug_ImageScaleRun
+ *  @brief   implement oyCMMFilter_GetNext_f()
+ *
+ *  The node requests only the source region, which covers the ticket's
+ *  output region and the filter support, from its input. Nodes behind this
+ *  one see the scaled image size.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/13 (Oyranos: 0.3.2)
+ *  @date    2011/09/13
+ */
+int      oyraFilterPlug_ImageScaleRun( oyFilterPlug_s    * requestor_plug,
+                                       oyPixelAccess_s   * ticket )
+{
+  int result = 0, error = 0;
+  oyFilterSocket_s * socket = requestor_plug->remote_socket_;
+  oyFilterNode_s * input_node = 0,
+                 * node = socket->node;
+  oyFilterPlug_s * plug = (oyFilterPlug_s *)node->plugs[0];
+  oyImage_s * image = (oyImage_s*)socket->data,
+            * image_input = 0;
+  oyPixelAccess_s * new_ticket = 0;
+  oyRectangle_s src_roi = {oyOBJECT_RECTANGLE_S,0,0,0};
+  double scale = 1.0;
+  int32_t method = 0;
+  int channels, in_w, in_h, out_w, out_h,
+      dst_x, dst_y, dst_w, dst_h,
+      src_x0, src_y0, src_x1, src_y1;
+  double support;
+
+  error = oyOptions_FindDouble( node->core->options_, "scale", 0, &scale );
+  if(error || scale <= 0.0)
+    scale = 1.0;
+  error = oyOptions_FindInt( node->core->options_, "method", 0, &method );
+  if(error || method < 0 || method > 2)
+    method = scale < 1.0 ? 0 : 1;
+  error = 0;
+
+  input_node = plug->remote_socket_->node;
+  image_input = oyImage_Copy( (oyImage_s*)plug->remote_socket_->data, 0 );
+  if(!image_input)
+    image_input = oyFilterPlug_ResolveImage( plug, socket, ticket );
+  if(!image_input)
+    return 1;
+
+  in_w = image_input->width;
+  in_h = image_input->height;
+  out_w = OY_ROUND( in_w * scale );
+  out_h = OY_ROUND( in_h * scale );
+
+  /* describe the scaled image for the following nodes */
+  if(!image || image->width != out_w || image->height != out_h)
+  {
+    image = oyImage_Create( out_w, out_h, 0,
+                            oyImage_PixelLayoutGet( image_input ),
+                            image_input->profile_, node->oy_ );
+    oyFilterNode_DataSet( node, (oyStruct_s*)image, 0, 0 );
+    oyImage_Release( &image );
+  }
+
+  /* nothing to resample */
+  if(scale == 1.0)
+  {
+    oyImage_Release( &image_input );
+    return input_node->api7_->oyCMMFilterPlug_Run( plug, ticket );
+  }
+
+  /* a resolve request without pixels */
+  if(!ticket->output_image || !ticket->array)
+  {
+    oyImage_Release( &image_input );
+    return 0;
+  }
+
+  channels = oyToChannels_m( oyImage_PixelLayoutGet( image_input ) );
+  if(channels != oyToChannels_m( oyImage_PixelLayoutGet(ticket->output_image) ))
+  {
+    oyFilterSocket_Callback( requestor_plug,
+                             oyCONNECTOR_EVENT_INCOMPATIBLE_DATA );
+    oyImage_Release( &image_input );
+    return 1;
+  }
+
+  /* destination region in pixels of the scaled image */
+  dst_x = OY_ROUND( ticket->start_xy[0] * ticket->output_image->width );
+  dst_y = OY_ROUND( ticket->start_xy[1] * ticket->output_image->width );
+  dst_w = OY_ROUND( ticket->output_image_roi->width *
+                    ticket->output_image->width );
+  dst_h = OY_ROUND( ticket->output_image_roi->height *
+                    ticket->output_image->width );
+  dst_w = OY_MIN( dst_w, ticket->array->width / channels );
+  dst_h = OY_MIN( dst_h, ticket->array->height );
+  dst_w = OY_MIN( dst_w, out_w - dst_x );
+  dst_h = OY_MIN( dst_h, out_h - dst_y );
+  if(dst_w <= 0 || dst_h <= 0)
+  {
+    oyImage_Release( &image_input );
+    return 0;
+  }
+
+  /* source region including the filter support */
+  support = oyra_scale_support_[method] * (scale < 1.0 ? 1.0 / scale : 1.0);
+  src_x0 = (int)floor( (dst_x + 0.5) / scale - 0.5 - support );
+  src_y0 = (int)floor( (dst_y + 0.5) / scale - 0.5 - support );
+  src_x1 = (int)ceil( (dst_x + dst_w - 0.5) / scale - 0.5 + support ) + 1;
+  src_y1 = (int)ceil( (dst_y + dst_h - 0.5) / scale - 0.5 + support ) + 1;
+  if(src_x0 < 0) src_x0 = 0;
+  if(src_y0 < 0) src_y0 = 0;
+  if(src_x1 > in_w) src_x1 = in_w;
+  if(src_y1 > in_h) src_y1 = in_h;
+
+  /* a ticket for the unscaled source region */
+  new_ticket = oyPixelAccess_Copy( ticket, ticket->oy_ );
+  oyArray2d_Release( &new_ticket->array );
+  oyImage_Release( &new_ticket->output_image );
+  new_ticket->output_image = oyImage_Copy( image_input, 0 );
+  new_ticket->start_xy[0] = src_x0 / (double) in_w;
+  new_ticket->start_xy[1] = src_y0 / (double) in_w;
+  oyRectangle_SetGeo( new_ticket->output_image_roi, 0,0,
+                      (src_x1 - src_x0) / (double) in_w,
+                      (src_y1 - src_y0) / (double) in_w );
+  oyRectangle_SetGeo( &src_roi, new_ticket->start_xy[0],
+                      new_ticket->start_xy[1],
+                      new_ticket->output_image_roi->width,
+                      new_ticket->output_image_roi->height );
+  error = oyImage_FillArray( image_input, &src_roi, 2, &new_ticket->array,
+                             new_ticket->output_image_roi, 0 );
+
+  if(!error)
+    result = input_node->api7_->oyCMMFilterPlug_Run( plug, new_ticket );
+
+  if(!error && result <= 0)
+    error = oyraScaleArray_( new_ticket->array, src_x0, src_y0,
+                            src_x1 - src_x0, src_y1 - src_y0,
+                            ticket->array, dst_x, dst_y, dst_w, dst_h,
+                            channels, scale, method );
+
+  oyPixelAccess_Release( &new_ticket );
+  oyImage_Release( &image_input );
+
+  if(error)
+    result = error;
+
+  return result;
+}
+
+/** @instance oyra_imageScale_plug
+ *  @brief    the scale node accepts interleaved data of any type except
+ *            oyHALF and oyUINT32
+ */
+oyConnectorImaging_s oyra_imageScale_plug = {
+  oyOBJECT_CONNECTOR_S,0,0,0,
+  oyCMMgetImageConnectorPlugText, /* getText */
+  oy_image_connector_texts, /* texts */
+  "//" OY_TYPE_STD "/image.data", /* connector_type */
+  oyFilterSocket_MatchImagingPlug, /* filterSocket_MatchPlug */
+  1, /* is_plug == oyFilterPlug_s */
+  oyra_image_scale_data_types, /* data_types */
+  4, /* data_types_n; elements in data_types array */
+  -1, /* max_colour_offset */
+  1, /* min_channels_count; */
+  255, /* max_channels_count; */
+  1, /* min_colour_count; */
+  255, /* max_colour_count; */
+  0, /* can_planar; can read separated channels */
+  1, /* can_interwoven; can read continuous channels */
+  1, /* can_swap; can swap colour channels (BGR)*/
+  0, /* can_swap_bytes; non host byte order */
+  1, /* can_revert; revert 1 -> 0 and 0 -> 1 */
+  1, /* can_premultiplied_alpha; */
+  0, /* can_nonpremultiplied_alpha; */
+  0, /* can_subpixel; understand subpixel order */
+  0, /* oyCHANNELTYPE_e    * channel_types; */
+  0, /* count in channel_types */
+  1, /* id; relative to oyFilter_s, e.g. 1 */
+  0  /* is_mandatory; mandatory flag */
+};
+oyConnectorImaging_s *oyra_imageScale_plugs[2] = {&oyra_imageScale_plug,0};
+
+oyConnectorImaging_s oyra_imageScale_socket = {
+  oyOBJECT_CONNECTOR_S,0,0,0,
+  oyCMMgetImageConnectorSocketText, /* getText */
+  oy_image_connector_texts, /* texts */
+  "//" OY_TYPE_STD "/image.data", /* connector_type */
+  oyFilterSocket_MatchImagingPlug, /* filterSocket_MatchPlug */
+  0, /* is_plug == oyFilterPlug_s */
+  oyra_image_scale_data_types, /* data_types */
+  4, /* data_types_n; elements in data_types array */
+  -1, /* max_colour_offset */
+  1, /* min_channels_count; */
+  255, /* max_channels_count; */
+  1, /* min_colour_count; */
+  255, /* max_colour_count; */
+  0, /* can_planar; can read separated channels */
+  1, /* can_interwoven; can read continuous channels */
+  1, /* can_swap; can swap colour channels (BGR)*/
+  0, /* can_swap_bytes; non host byte order */
+  1, /* can_revert; revert 1 -> 0 and 0 -> 1 */
+  1, /* can_premultiplied_alpha; */
+  0, /* can_nonpremultiplied_alpha; */
+  0, /* can_subpixel; understand subpixel order */
+  0, /* oyCHANNELTYPE_e    * channel_types; */
+  0, /* count in channel_types */
+  2, /* id; relative to oyFilter_s, e.g. 1 */
+  0  /* is_mandatory; mandatory flag */
+};
+oyConnectorImaging_s *oyra_imageScale_sockets[2] = {&oyra_imageScale_socket,0};
+
+
+#define OY_IMAGE_SCALE_REGISTRATION OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL OY_SLASH OY_TYPE_STD OY_SLASH "scale"
+/** @instance oyra_api7
+ *  @brief    oyra oyCMMapi7_s implementation
+ *
+ *  a filter resampling the image to a new size
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/13 (Oyranos: 0.3.2)
+ *  @date    2011/09/13
+ */
+oyCMMapi7_s   oyra_api7_image_scale = {
+
+  oyOBJECT_CMM_API7_S, /* oyStruct_s::type oyOBJECT_CMM_API7_S */
+  0,0,0, /* unused oyStruct_s fileds; keep to zero */
+  (oyCMMapi_s*) & oyra_api4_image_write_ppm, /* oyCMMapi_s * next */
+  
+  oyraCMMInit, /* oyCMMInit_f */
+  oyraCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
+
+  /* registration */
+  OY_IMAGE_SCALE_REGISTRATION,
+
+  CMM_VERSION, /* int32_t version[3] */
+  {0,3,0},                  /**< int32_t module_api[3] */
+  0,   /* id_; keep empty */
+  0,   /* api5_; keep empty */
+
+  oyraFilterPlug_ImageScaleRun, /* oyCMMFilterPlug_Run_f */
+  {0}, /* char data_type[8] */
+
+  (oyConnector_s**) oyra_imageScale_plugs,   /* plugs */
+  1,   /* plugs_n */
+  0,   /* plugs_last_add */
+  (oyConnector_s**) oyra_imageScale_sockets,   /* sockets */
+  1,   /* sockets_n */
+  0    /* sockets_last_add */
+};
+
+const char scale_extra_options[] = {
+ "\n\
+  <" OY_TOP_SHARED ">\n\
+   <" OY_DOMAIN_INTERNAL ">\n\
+    <" OY_TYPE_STD ">\n\
+     <" "scale" ">\n\
+      <scale>1.0</scale>\n\
+      <method>-1</method>\n\
+     </" "scale" ">\n\
+    </" OY_TYPE_STD ">\n\
+   </" OY_DOMAIN_INTERNAL ">\n\
+  </" OY_TOP_SHARED ">\n"
+};
+
+const char * oyraApi4UiImageScaleGetText (
+                                       const char        * select,
+                                       oyNAME_e            type,
+                                       oyStruct_s        * context )
+{
+  if(strcmp(select,"name") == 0)
+  {
+    if(type == oyNAME_NICK)
+      return "scale";
+    else if(type == oyNAME_NAME)
+      return _("Scale");
+    else if(type == oyNAME_DESCRIPTION)
+      return _("Scale Image Filter Object");
+  } else if(strcmp(select,"help") == 0)
+  {
+    if(type == oyNAME_NICK)
+      return "help";
+    else if(type == oyNAME_NAME)
+      return _("Resample the image to a new size.");
+    else if(type == oyNAME_DESCRIPTION)
+      return _("The filter expects a \"scale\" option of type double, which gives the destination size in relation to the source size. The \"method\" integer option selects the interpolation: 0 - box, 1 - bilinear, 2 - Lanczos3. The default is box for downsampling and bilinear for upsampling. Place the filter before the \"icc\" node to convert only the displayed pixels.");
+  }
+  return 0;
+}
+const char * oyra_api4_ui_image_scale_texts[] = {"name", "help", 0};
+
+/** @instance oyra_api4_ui_image_scale
+ *  @brief    oyra oyCMMapi4_s::ui implementation
+ *
+ *  The UI for filter image scale.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/13 (Oyranos: 0.3.2)
+ *  @date    2011/09/13
+ */
+oyCMMui_s oyra_api4_ui_image_scale = {
+  oyOBJECT_CMM_DATA_TYPES_S,           /**< oyOBJECT_e       type; */
+  0,0,0,                            /* unused oyStruct_s fields; keep to zero */
+
+  CMM_VERSION,                         /**< int32_t version[3] */
+  {0,3,0},                            /**< int32_t module_api[3] */
+
+  oyraFilter_ImageRootValidateOptions, /* oyCMMFilter_ValidateOptions_f */
+  oyraWidgetEvent, /* oyWidgetEvent_f */
+
+  "Image/Scale", /* category */
+  scale_extra_options,   /* const char * options */
+  0,   /* oyCMMuiGet_f oyCMMuiGet */
+
+  oyraApi4UiImageScaleGetText,  /* oyCMMGetText_f getText */
+  oyra_api4_ui_image_scale_texts  /* (const char**)texts */
+};
+
+/** @instance oyra_api4
+ *  @brief    oyra oyCMMapi4_s implementation
+ *
+ *  a filter resampling the image to a new size
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/13 (Oyranos: 0.3.2)
+ *  @date    2011/09/13
+ */
+oyCMMapi4_s   oyra_api4_image_scale = {
+
+  oyOBJECT_CMM_API4_S, /* oyStruct_s::type oyOBJECT_CMM_API4_S */
+  0,0,0, /* unused oyStruct_s fileds; keep to zero */
+  (oyCMMapi_s*) & oyra_api7_image_scale, /* oyCMMapi_s * next */
+  
+  oyraCMMInit, /* oyCMMInit_f */
+  oyraCMMMessageFuncSet, /* oyCMMMessageFuncSet_f */
+
+  /* registration */
+  OY_IMAGE_SCALE_REGISTRATION,
+
+  CMM_VERSION, /* int32_t version[3] */
+  {0,3,0},                  /**< int32_t module_api[3] */
+  0,   /* id_; keep empty */
+  0,   /* api5_; keep empty */
+
+  oyraFilterNode_ImageRootContextToMem, /* oyCMMFilterNode_ContextToMem_f */
+  0, /* oyCMMFilterNode_ContextToMem_f oyCMMFilterNode_ContextToMem */
+  {0}, /* char context_type[8] */
+
+  &oyra_api4_ui_image_scale            /**< oyCMMui_s *ui */
+};
+
+/* OY_IMAGE_SCALE_REGISTRATION -----------------------------------------------*/
+
 /* OY_IMAGE_ROOT_REGISTRATION ------------------------------------------------*/
 
 
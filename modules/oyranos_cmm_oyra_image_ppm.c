@@ -31,6 +31,9 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#if defined(HAVE_POSIX)
+#include <sys/mman.h>
+#endif
 
 int wread ( unsigned char   *data,    /* read a word */
             size_t  pos,
@@ -88,12 +91,77 @@ oyOptions_s* oyraFilter_ImageOutputPPMValidateOptions
   return 0;
 }
 
+/** @internal
+ *  @func    oyraPPMWriteStrips_
+ *  @brief   convert and write the image strip by strip
+ *
+ *  Only one strip of pixels needs to be held in memory.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/21 (Oyranos: 0.3.2)
+ *  @date    2011/09/21
+ */
+static int oyraPPMWriteStrips_       ( oyFilterPlug_s    * plug,
+                                       oyPixelAccess_s   * ticket,
+                                       oyImage_s         * image,
+                                       const char        * filename,
+                                       const char        * free_text,
+                                       int                 strip_height )
+{
+  oyFilterNode_s * input_node = plug->remote_socket_->node;
+  oyPixelAccess_s * new_ticket = 0;
+  oyRectangle_s roi = {oyOBJECT_RECTANGLE_S,0,0,0};
+  int channels = oyToChannels_m( oyImage_PixelLayoutGet( image ) );
+  oyDATATYPE_e data_type = oyToDataType_m( oyImage_PixelLayoutGet( image ) );
+  int y, height, result = 0, error = 0;
+  FILE * fp = oyImage_PpmWriteOpen( image, filename, free_text );
+
+  if(!fp)
+    return 1;
+
+  for(y = 0; y < image->height && !error; y += strip_height)
+  {
+    height = OY_MIN( strip_height, image->height - y );
+
+    /* a ticket for the actual strip only */
+    new_ticket = oyPixelAccess_Copy( ticket, ticket->oy_ );
+    oyArray2d_Release( &new_ticket->array );
+    new_ticket->start_xy[0] = 0;
+    new_ticket->start_xy[1] = y / (double)image->width;
+    oyRectangle_SetGeo( new_ticket->output_image_roi, 0,0,
+                        1.0, height / (double)image->width );
+    oyRectangle_SetGeo( &roi, 0, new_ticket->start_xy[1],
+                        1.0, new_ticket->output_image_roi->height );
+    error = oyImage_FillArray( image, &roi, 2, &new_ticket->array,
+                               new_ticket->output_image_roi, 0 );
+
+    if(!error)
+      result = input_node->api7_->oyCMMFilterPlug_Run( plug, new_ticket );
+    if(result > 0)
+      error = result;
+
+    if(!error)
+      error = oyPpmWriteLines( fp, (oyPointer*)new_ticket->array->array2d,
+                               height, image->width * channels, data_type );
+
+    oyPixelAccess_Release( &new_ticket );
+  }
+
+  fflush( fp );
+  fclose( fp );
+
+  return error;
+}
+
 /** @func    oyraFilterPlug_ImageOutputPPMWrite
  *  @brief   implement oyCMMFilter_GetNext_f()
  *
- *  @version Oyranos: 0.3.1
+ *  With a "strip_height" option the image is converted and written in
+ *  strips of that many lines.
+ *
+ *  @version Oyranos: 0.3.2
  *  @since   2008/10/07 (Oyranos: 0.1.8)
- *  @date    2011/05/12
+ *  @date    2011/09/21
  */
 int      oyraFilterPlug_ImageOutputPPMWrite (
                                        oyFilterPlug_s    * requestor_plug,
@@ -104,17 +172,27 @@ int      oyraFilterPlug_ImageOutputPPMWrite (
   oyFilterNode_s * input_node = 0,
                  * node = 0;
   int result = 0;
+  int32_t strip_height = 0;
   const char * filename = 0;
 
   node = socket->node;
   plug = (oyFilterPlug_s *)node->plugs[0];
   input_node = plug->remote_socket_->node;
 
+  filename = oyOptions_FindString( node->core->options_, "filename", 0 );
+  if(oyOptions_FindInt( node->core->options_, "strip_height", 0,
+                        &strip_height ) != 0)
+    strip_height = 0;
+
+  if(filename && strip_height > 0 && socket->data && ticket)
+    return oyraPPMWriteStrips_( plug, ticket, (oyImage_s*)socket->data,
+                                filename, node->relatives_, strip_height );
+
   /* to reuse the requestor_plug is a exception for the starting request */
   result = input_node->api7_->oyCMMFilterPlug_Run( plug, ticket );
 
-  if(result <= 0)
-    filename = oyOptions_FindString( node->core->options_, "filename", 0 );
+  if(result > 0)
+    filename = 0;
 
   if(filename && socket)
   {
@@ -132,6 +210,7 @@ const char ppm_write_extra_options[] = {
     <" OY_TYPE_STD ">\n\
      <" "file_write" ">\n\
       <filename></filename>\n\
+      <strip_height.advanced>0</strip_height.advanced>\n\
      </" "file_write" ">\n\
     </" OY_TYPE_STD ">\n\
    </" OY_DOMAIN_INTERNAL ">\n\
@@ -408,12 +487,251 @@ int wread ( unsigned char* data, size_t pos, size_t max, size_t *start, size_t *
   return end_found;
 }
 
+/* --- memory mapped PNM data -------------------------------------------------*/
+
+/** @internal
+ *  @struct  oyraPPMMap_s
+ *  @brief   pixel data of a binary PNM file
+ *
+ *  The file is mapped into memory. Lines are served directly from the
+ *  mapping, if the samples are in host byte order and need no scaling.
+ *  Otherwise a strip around the requested line is converted on its first
+ *  access and kept for later calls. The struct is hold in a oyPointer_s as
+ *  oyImage_s::pixel_data .
+ */
+typedef struct {
+  uint8_t    * data;                   /**< whole file */
+  size_t       size;                   /**< file size */
+  int          mapped;                 /**< data is mmap()ed or else malloc()ed */
+  size_t       offset;                 /**< byte position of the first sample */
+  int          width;                  /**< pixel per line */
+  int          height;                 /**< lines */
+  int          spp;                    /**< samples per pixel */
+  int          byteps;                 /**< bytes per sample */
+  double       maxval;                 /**< PNM maximum value */
+  int          byte_swap;              /**< non host byte order */
+  int          direct;                 /**< serve lines from data */
+  int          strip_height;           /**< lines per converted strip */
+  uint8_t   ** strips;                 /**< converted strips */
+} oyraPPMMap_s;
+
+static int oyraPPMMapRelease_        ( oyPointer         * ptr )
+{
+  oyraPPMMap_s * m;
+  int i;
+
+  if(!ptr || !*ptr)
+    return 1;
+
+  m = (oyraPPMMap_s*) *ptr;
+
+  if(m->strips)
+  {
+    for(i = 0; i < (m->height + m->strip_height - 1) / m->strip_height; ++i)
+      if(m->strips[i])
+        oyDeAllocateFunc_( m->strips[i] );
+    oyDeAllocateFunc_( m->strips );
+  }
+
+#if defined(HAVE_POSIX)
+  if(m->mapped)
+    munmap( m->data, m->size );
+  else
+#endif
+  if(m->data)
+    oyDeAllocateFunc_( m->data );
+
+  oyDeAllocateFunc_( m );
+  *ptr = 0;
+
+  return 0;
+}
+
+/* normalise and byteswap in place */
+static void oyraPPMConvert_          ( oyraPPMMap_s      * m,
+                                       uint8_t           * buf,
+                                       int                 n_samples )
+{
+  int p, n_bytes = n_samples * m->byteps;
+  double maxval = m->maxval;
+  uint8_t  * d_8 = buf;
+  uint16_t * d_16 = (uint16_t*)buf;
+  float    * d_f = (float*)buf;
+
+  if( m->byte_swap )
+  {
+    unsigned char tmp;
+    if (m->byteps == 2) {         /* 16 bit */
+      for (p = 0; p < n_bytes; p += 2)
+      {
+        tmp = buf[p];
+        buf[p] = buf[p+1];
+        buf[p+1] = tmp;
+      }
+    } else if (m->byteps == 4) {  /* float */
+      for (p = 0; p < n_bytes; p += 4)
+      {
+        tmp = buf[p];
+        buf[p] = buf[p+3];
+        buf[p+3] = tmp;
+        tmp = buf[p+1];
+        buf[p+1] = buf[p+2];
+        buf[p+2] = tmp;
+      }
+    }
+  }
+
+  if (m->byteps == 1 && maxval < 255) {         /*  8 bit */
+    for (p = 0; p < n_samples; ++p)
+      d_8[p] = (d_8[p] * 255) / maxval;
+  } else if (m->byteps == 2 && maxval < 65535) {/* 16 bit */
+    for (p = 0; p < n_samples; ++p)
+      d_16 [p] = (d_16[p] * 65535) / maxval;
+  } else if (m->byteps == 4 && maxval != 1.0) {  /* float */
+    for (p = 0; p < n_samples; ++p)
+      d_f[p] = d_f[p] * maxval;
+  }
+}
+
+/** @internal
+ *  @brief   oyImage_GetLine_f for oyraPPMMap_s
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/26 (Oyranos: 0.3.2)
+ *  @date    2011/09/26
+ */
+static oyPointer oyraPPMGetLine_     ( oyImage_s         * image,
+                                       int                 line_y,
+                                       int               * height,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  oyraPPMMap_s * m = (oyraPPMMap_s*) oyPointer_GetPointer(
+                                             (oyPointer_s*)image->pixel_data );
+  size_t line_size;
+  int s, y0, lines;
+  uint8_t * data = 0;
+
+  if(is_allocated) *is_allocated = 0;
+  if(height) *height = 0;
+
+  if(!m || line_y < 0 || line_y >= m->height)
+  {
+    oyra_msg( oyMSG_WARN, (oyStruct_s*)image,
+             OY_DBG_FORMAT_ " line_y out of range: %d/%d",
+             OY_DBG_ARGS_, line_y, m ? m->height : 0 );
+    return 0;
+  }
+
+  line_size = (size_t)m->width * m->spp * m->byteps;
+
+  if(m->direct)
+  {
+    if(height) *height = m->height - line_y;
+    return &m->data[m->offset + line_y * line_size];
+  }
+
+  s = line_y / m->strip_height;
+  y0 = s * m->strip_height;
+  lines = m->height - y0;
+  if(lines > m->strip_height)
+    lines = m->strip_height;
+
+  /* parallel readers fill each strip only once */
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  if(!m->strips[s])
+  {
+    uint8_t * strip = (uint8_t*) oyAllocateFunc_( lines * line_size );
+    if(strip)
+    {
+      memcpy( strip, &m->data[m->offset + y0 * line_size], lines * line_size);
+      oyraPPMConvert_( m, strip, lines * m->width * m->spp );
+      m->strips[s] = strip;
+    }
+  }
+  data = m->strips[s];
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+
+  if(!data)
+    return 0;
+
+  if(height) *height = y0 + lines - line_y;
+  return &data[(line_y - y0) * line_size];
+}
+
+/** @internal
+ *  @brief   oyImage_GetPoint_f for oyraPPMMap_s
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/26 (Oyranos: 0.3.2)
+ *  @date    2011/09/26
+ */
+static oyPointer oyraPPMGetPoint_    ( oyImage_s         * image,
+                                       int                 point_x,
+                                       int                 point_y,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  oyraPPMMap_s * m = (oyraPPMMap_s*) oyPointer_GetPointer(
+                                             (oyPointer_s*)image->pixel_data );
+  uint8_t * line = oyraPPMGetLine_( image, point_y, 0, channel, is_allocated );
+
+  if(!line)
+    return 0;
+  return &line[point_x * m->spp * m->byteps];
+}
+
+/** @internal
+ *  @brief   oyImage_SetLine_f for oyraPPMMap_s
+ *
+ *  Writes go to the private mapping or to a converted strip. The file is
+ *  not touched.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/26 (Oyranos: 0.3.2)
+ *  @date    2011/09/26
+ */
+static int oyraPPMSetLine_           ( oyImage_s         * image,
+                                       int                 point_x,
+                                       int                 point_y,
+                                       int                 pixel_n,
+                                       int                 channel,
+                                       oyPointer           data )
+{
+  oyraPPMMap_s * m = (oyraPPMMap_s*) oyPointer_GetPointer(
+                                             (oyPointer_s*)image->pixel_data );
+  uint8_t * line = oyraPPMGetLine_( image, point_y, 0, channel, 0 );
+  size_t pixel_size;
+
+  if(!line || !data)
+    return 1;
+
+  pixel_size = m->spp * m->byteps;
+  if(pixel_n < 0 || point_x + pixel_n > m->width)
+    pixel_n = m->width - point_x;
+  memcpy( &line[point_x * pixel_size], data, pixel_n * pixel_size );
+
+  return 0;
+}
+
+static int oyraPPMSetPoint_          ( oyImage_s         * image,
+                                       int                 point_x,
+                                       int                 point_y,
+                                       int                 channel,
+                                       oyPointer           data )
+{
+  return oyraPPMSetLine_( image, point_x, point_y, 1, channel, data );
+}
+
 /** @func    oyraFilterPlug_ImageInputPPMRun
  *  @brief   implement oyCMMFilter_GetNext_f()
  *
- *  @version Oyranos: 0.1.10
+ *  Binary files are memory mapped. The lines are obtained on request through
+ *  oyImage_s::getLine, which converts only the touched strips.
+ *
+ *  @version Oyranos: 0.3.2
  *  @since   2009/02/18 (Oyranos: 0.1.10)
- *  @date    2009/02/18
+ *  @date    2011/09/26
  */
 int      oyraFilterPlug_ImageInputPPMRun (
                                        oyFilterPlug_s    * requestor_plug,
@@ -422,7 +740,8 @@ int      oyraFilterPlug_ImageInputPPMRun (
   oyFilterSocket_s * socket = 0;
   oyFilterNode_s * node = 0;
   int error = 0;
-  const char * filename = 0;
+  const char * filename = 0,
+             * fileext = 0;
   FILE * fp = 0;
   oyDATATYPE_e data_type = oyUINT8;
   oyPROFILE_e profile_type = oyEDITING_RGB;
@@ -431,8 +750,9 @@ int      oyraFilterPlug_ImageInputPPMRun (
   oyPixel_t pixel_type = 0;
   int     fsize = 0;
   size_t  fpos = 0;
-  uint8_t * data = 0, * buf = 0;
+  uint8_t * data = 0;
   size_t  mem_n = 0;   /* needed memory in bytes */
+  oyraPPMMap_s * m = 0;
     
   int info_good = 1;
 
@@ -488,19 +808,42 @@ int      oyraFilterPlug_ImageInputPPMRun (
   fsize = ftell(fp);
   rewind(fp);
 
-  oyAllocHelper_m_( data, uint8_t, fsize, 0, return 1);
+  oyAllocHelper_m_( m, oyraPPMMap_s, 1, 0, fclose(fp); return 1);
+
+#if defined(HAVE_POSIX)
+  /* pages are read in only as they get touched; writes stay private */
+  if(fsize > 0)
+    data = (uint8_t*) mmap( 0, fsize, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                            fileno(fp), 0 );
+  if(data == MAP_FAILED)
+    data = 0;
+  else if(data)
+    m->mapped = 1;
+#endif
 
-  fpos = fread( data, sizeof(uint8_t), fsize, fp );
-  if( fpos < fsize ) {
+  if(!data)
+  {
+    oyAllocHelper_m_( data, uint8_t, fsize, 0,
+                      oyraPPMMapRelease_( (oyPointer*)&m ); fclose(fp);
+                      return 1);
+
+    fpos = fread( data, sizeof(uint8_t), fsize, fp );
+  } else
+    fpos = fsize;
+  m->data = data;
+  m->size = fsize;
+
+  if( fpos < fsize || fsize < 2 ) {
     oyra_msg( oyMSG_WARN, (oyStruct_s*)node,
              OY_DBG_FORMAT_ " could not read: %s %d %d",
              OY_DBG_ARGS_, oyNoEmptyString_m_( filename ), fsize, (int)fpos );
-    oyFree_m_( data )
+    oyraPPMMapRelease_( (oyPointer*)&m );
     fclose (fp);
     return FALSE;
   }
 
   fpos = 0;
+  /* a mapping stays valid after closing the file */
   fclose (fp);
   fp = NULL;
 
@@ -632,7 +975,9 @@ int      oyraFilterPlug_ImageInputPPMRun (
     }
   }
 
-  if(strstr(strrchr(filename, '.')+1, "raw"))
+  /* the file type selection reaches this reader without extension too */
+  fileext = strrchr( filename, '.' );
+  if(fileext && strstr( fileext + 1, "raw" ))
   {
     info_good = 1;
     width = atoi(getenv("RAW_WIDTH"));
@@ -723,7 +1068,7 @@ int      oyraFilterPlug_ImageInputPPMRun (
     oyra_msg( oyMSG_WARN, (oyStruct_s*)node,
              OY_DBG_FORMAT_ "failed to get info of %s",
              OY_DBG_ARGS_, oyNoEmptyString_m_( filename ));
-    oyFree_m_( data )
+    oyraPPMMapRelease_( (oyPointer*)&m );
     return FALSE;
   }
 
@@ -737,7 +1082,7 @@ int      oyraFilterPlug_ImageInputPPMRun (
              OY_DBG_FORMAT_ "\n  storage size of %s is too small: %d",
              OY_DBG_ARGS_, oyNoEmptyString_m_( filename ),
              (int)mem_n-fsize-fpos );
-      oyFree_m_( data )
+      oyraPPMMapRelease_( (oyPointer*)&m );
       return FALSE;
     }
 
@@ -752,118 +1097,65 @@ int      oyraFilterPlug_ImageInputPPMRun (
              OY_DBG_FORMAT_ "\n  %s contains bitmap data, which are not handled by this pnm reader",
              OY_DBG_ARGS_, oyNoEmptyString_m_( filename ) );
     }
-    oyFree_m_( data )
+    oyraPPMMapRelease_( (oyPointer*)&m );
     return FALSE;
   }
 
-  oyAllocHelper_m_( buf, uint8_t, mem_n, 0, return 1);
+  m->offset = fpos;
+  m->width = width;
+  m->height = height;
+  m->spp = spp;
+  m->byteps = byteps;
 
-  /* the following code is almost completely taken from ku.b's ppm CP plug-in */
+  if(oyBigEndian())
   {
-    int h, j_h = 0, p, n_samples, n_bytes;
-    int byte_swap = 0;
-    unsigned char *d_8 = 0;
-    unsigned char *src = &data[fpos];
-
-    uint16_t *d_16;
-    float  *d_f;
-
-    if(oyBigEndian())
-    {
-      if(maxval < 0 && byteps == 4)
-        byte_swap = 1;
-    } else
-    {
-      if( (byteps == 2) ||
-        (maxval > 0 && byteps == 4)  ) {
-        byte_swap = 1;
-      }
+    if(maxval < 0 && byteps == 4)
+      m->byte_swap = 1;
+  } else
+  {
+    if( (byteps == 2) ||
+      (maxval > 0 && byteps == 4)  ) {
+      m->byte_swap = 1;
     }
+  }
 
-    maxval = abs(maxval);
-
-    for(h = 0; h < height; ++h)
-    {
-        n_samples = 1 * width * spp;
-        n_bytes = n_samples * byteps;
-
-        d_8  = buf;
-        d_16 = (uint16_t*)buf;
-        d_f  = (float*)buf;
-
-        /*  TODO 1 bit raw and ascii */
-        if (type == 1 || type == 4) {
-
-        /*  TODO ascii  */
-        } else if (type == 2 || type == 3) {
+  m->maxval = fabs(maxval);
 
+  /* samples in host byte order and full range need no conversion */
+  m->direct = !m->byte_swap && fpos % byteps == 0 &&
+              ((byteps == 1 && m->maxval >= 255) ||
+               (byteps == 2 && m->maxval >= 65535) ||
+               (byteps == 4 && m->maxval == 1.0));
 
-        /*  raw and floats */
-        } else if (type == 5 || type == 6 ||
-                   type == -5 || type == -6 ||
-                   type == 7 )
-        {
-          if(byteps == 1) {
-            d_8 = &src[ h * width * spp * byteps ];
-          } else if(byteps == 2) {
-            d_16 = (uint16_t*)& src[ h * width * spp * byteps ];
-          } else if(byteps == 4) {
-            d_f = (float*)&src[ h * width * spp * byteps ];
-          }
-          memcpy (&buf[ h * width * spp * byteps ],
-                  &src[ (j_h + h) * width * spp * byteps ],
-                  1 * width * spp * byteps);
-        }
-
-        /* normalise and byteswap */
-        if( byte_swap )
-        {
-          unsigned char *c_buf = &buf[ h * width * spp * byteps ];
-          char  tmp;
-          if (byteps == 2) {         /* 16 bit */
-            for (p = 0; p < n_bytes; p += 2)
-            {
-              tmp = c_buf[p];
-              c_buf[p] = c_buf[p+1];
-              c_buf[p+1] = tmp;
-            }
-          } else if (byteps == 4) {  /* float */
-            for (p = 0; p < n_bytes; p += 4)
-            {
-              tmp = c_buf[p];
-              c_buf[p] = c_buf[p+3];
-              c_buf[p+3] = tmp;
-              tmp = c_buf[p+1];
-              c_buf[p+1] = c_buf[p+2];
-              c_buf[p+2] = tmp;
-            }
-          }
-        }
-
-        if (byteps == 1 && maxval < 255) {         /*  8 bit */
-          for (p = 0; p < n_samples; ++p)
-            d_8[p] = (d_8[p] * 255) / maxval;
-        } else if (byteps == 2 && maxval < 65535) {/* 16 bit */
-          for (p = 0; p < n_samples; ++p)
-            d_16 [p] = (d_16[p] * 65535) / maxval;
-        } else if (byteps == 4 && maxval != 1.0) {  /* float */
-          for (p = 0; p < n_samples; ++p)
-            d_f[p] = d_f[p] * maxval;
-        }
-    }
-  }
+  m->strip_height = 64;
+  if(!m->direct)
+    oyAllocHelper_m_( m->strips, uint8_t*,
+                      (height + m->strip_height - 1) / m->strip_height, 0,
+                      oyraPPMMapRelease_( (oyPointer*)&m ); return 1);
 
   pixel_type = oyChannels_m(spp) | oyDataType_m(data_type); 
   prof = oyProfile_FromStd( profile_type, 0 );
 
-  image_in = oyImage_Create( width, height, buf, pixel_type, prof, 0 );
+  {
+    oyPointer_s * pixel_data = oyPointer_New( 0 );
+
+    error = oyPointer_Set( pixel_data, 0, "oyraPPMMap_s", m, "oyraPPMMap_s",
+                           oyraPPMMapRelease_ );
+    m = 0;
+    image_in = oyImage_CreateFromData( width, height, pixel_type, prof,
+                                       (oyStruct_s**) &pixel_data,
+                                       oyraPPMGetPoint_, oyraPPMGetLine_, 0,
+                                       oyraPPMSetPoint_, oyraPPMSetLine_, 0,
+                                       0 );
+    oyPointer_Release( &pixel_data );
+  }
+  oyProfile_Release( &prof );
 
   if (!image_in)
   {
       oyra_msg( oyMSG_WARN, (oyStruct_s*)node,
              OY_DBG_FORMAT_ "PNM can't create a new image\n%dx%d %d",
              OY_DBG_ARGS_,  width, height, pixel_type );
-      oyFree_m_ (data)
     return FALSE;
   }
 
@@ -888,7 +1180,6 @@ int      oyraFilterPlug_ImageInputPPMRun (
   }
 
   oyImage_Release( &image_in );
-  oyFree_m_ (data)
 
   /* return an error to cause the graph to retry */
   return 1;
@@ -1070,6 +1361,7 @@ char * oyra_api7_image_input_ppm_properties[] =
   "layers=1",     /* layer count, one for plain images */
   "icc=0",        /* image type ICC profile support */
   "ext=ppm,pnm,pbm,pgm,pfm", /* supported extensions */
+  "magic=5031,5032,5033,5034,5035,5036,5037,5046,5066", /* P1-P7, PF, Pf */
   0
 };
 
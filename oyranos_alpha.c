@@ -38,6 +38,9 @@
 #include "oyranos_texts.h"
 #ifdef HAVE_POSIX
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 #include <math.h>
 #include <locale.h>   /* LC_NUMERIC */
@@ -2263,9 +2266,9 @@ oyStructList_s * oy_cmm_filter_cache_ = 0;
  *  @param[in]   registration          point'.' separated list of identifiers
  *  @param[in]   type                  CMM API
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2008/12/15 (Oyranos: 0.1.9)
- *  @date    2008/06/02
+ *  @date    2011/11/04
  */
 oyCMMapiFilter_s *oyCMMsGetFilterApi_( const char        * cmm_required,
                                        const char        * registration,
@@ -2274,6 +2277,7 @@ oyCMMapiFilter_s *oyCMMsGetFilterApi_( const char        * cmm_required,
   oyCMMapiFilter_s * api = 0;
   oyCMMapiFilters_s * apis = 0;
   oyHash_s * entry = 0;
+  oyObject_s entry_oy = 0;
 #ifndef NO_OPT
   int len = oyStrlen_(registration);
   char * hash_text = oyAllocateFunc_( len + 10 );
@@ -2282,9 +2286,15 @@ oyCMMapiFilter_s *oyCMMsGetFilterApi_( const char        * cmm_required,
   oySprintf_( hash_text, "%s.%c_", registration, api_char ? api_char:' ');
   entry = oyCMMCacheListGetEntry_( hash_text );
   oyDeAllocateFunc_( hash_text ); hash_text = 0;
+  entry_oy = entry ? ((oyStruct_s*)entry)->oy_ : 0;
+  oyObject_Lock( entry_oy, __FILE__, __LINE__ );
   api = (oyCMMapiFilter_s*) oyHash_GetPointer( entry, type );
+  oyObject_UnLock( entry_oy, __FILE__, __LINE__ );
   if(api)
+  {
+    oyHash_Release( &entry );
     return api;
+  }
 #endif
 
   apis = oyCMMsGetFilterApis_( 0,cmm_required, registration, type, 
@@ -2299,10 +2309,16 @@ oyCMMapiFilter_s *oyCMMsGetFilterApi_( const char        * cmm_required,
     if(api->copy)
       api = api->copy
 #endif
-    oyHash_SetPointer( entry, (oyStruct_s*) api );
+    /* an other thread might have filled the entry meanwhile */
+    oyObject_Lock( entry_oy, __FILE__, __LINE__ );
+    if(!oyHash_GetPointer( entry, type ))
+      oyHash_SetPointer( entry, (oyStruct_s*) api );
+    oyObject_UnLock( entry_oy, __FILE__, __LINE__ );
 #endif
   }
 
+  oyHash_Release( &entry );
+
   return api;
 }
 
@@ -2895,8 +2911,7 @@ oyStructList_s * oy_cmm_cache_ = 0;
  */
 oyHash_s *   oyCMMCacheListGetEntry_ ( const char        * hash_text)
 {
-  if(!oy_cmm_cache_)
-    oy_cmm_cache_ = oyStructList_New( 0 );
+  oyCacheListCreate_( &oy_cmm_cache_ );
 
   return oyCacheListGetEntry_(oy_cmm_cache_, 0, hash_text);
 }
@@ -4607,9 +4622,9 @@ OYAPI oyArray2d_s * OYEXPORT
  *  @param[in]     obj                 struct object
  *  @param         object              the optional object
  *
- *  @version Oyranos: 0.1.8
+ *  @version Oyranos: 0.3.2
  *  @since   2008/08/23 (Oyranos: 0.1.8)
- *  @date    2008/08/23
+ *  @date    2011/11/24
  */
 oyArray2d_s * oyArray2d_Copy_
                                      ( oyArray2d_s       * obj,
@@ -4624,7 +4639,8 @@ oyArray2d_s * oyArray2d_Copy_
   if(!obj || !object)
     return s;
 
-  s = oyArray2d_Create( 0, obj->height, 0, obj->t, object );
+  /* the lines are allocated one by one below */
+  s = oyArray2d_Create_( obj->width, obj->height, obj->t, object );
   error = !s;
 
   if(error <= 0)
@@ -5542,6 +5558,223 @@ oyImage_s *    oyImage_Create         ( int               width,
   return s;
 }
 
+/** @brief   create a image around a custom pixel data module
+ *  @memberof oyImage_s
+ *
+ *  Unlike oyImage_Create() no pixel memory is allocated. The image obtains
+ *  its samples only through the passed accessors, e.g. from a file mapping
+ *  or a decoder, which fills lines on request. pixel_data is moved in as
+ *  with oyImage_DataSet().
+ *
+ *  @param[in]     width               image width
+ *  @param[in]     height              image height
+ *  @param[in]     pixel_layout        i.e. oyTYPE_123_16 for 16-bit RGB data
+ *  @param[in]     profile             colour space description
+ *  @param[in,out] pixel_data          data struct will be moved in
+ *  @param[in]     getPoint            interface function
+ *  @param[in]     getLine             interface function
+ *  @param[in]     getTile             interface function
+ *  @param[in]     setPoint            interface function
+ *  @param[in]     setLine             interface function
+ *  @param[in]     setTile             interface function
+ *  @param[in]     object              the optional base
+ *  @return                            the new image
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/28 (Oyranos: 0.3.2)
+ *  @date    2011/10/07
+ */
+oyImage_s *    oyImage_CreateFromData( int                 width,
+                                       int                 height,
+                                       oyPixel_t           pixel_layout,
+                                       oyProfile_s       * profile,
+                                       oyStruct_s       ** pixel_data,
+                                       oyImage_GetPoint_f  getPoint,
+                                       oyImage_GetLine_f   getLine,
+                                       oyImage_GetTile_f   getTile,
+                                       oyImage_SetPoint_f  setPoint,
+                                       oyImage_SetLine_f   setLine,
+                                       oyImage_SetTile_f   setTile,
+                                       oyObject_s          object )
+{
+  /* a empty image has no array allocated */
+  oyImage_s * s = oyImage_Create( 0, 0, 0, pixel_layout, profile, object );
+  int error = !s;
+
+  if(error <= 0)
+  {
+    s->width = width;
+    s->height = height;
+    if(s->width != 0.0)
+      s->viewport = oyRectangle_NewWith( 0, 0, 1.0,
+                                   (double)s->height/(double)s->width, s->oy_ );
+
+    /* drop the array accessors from oyImage_Create(), as there is no array */
+    s->getPoint = 0; s->getLine = 0; s->getTile = 0;
+    s->setPoint = 0; s->setLine = 0; s->setTile = 0;
+    error = oyImage_DataSet( s, pixel_data, getPoint, getLine, getTile,
+                                setPoint, setLine, setTile );
+  }
+
+  /* update the ID to the real geometry */
+  if(error <= 0)
+    error = oyImage_CombinePixelLayout2Mask_ ( s, pixel_layout );
+
+  if(error > 0)
+    oyImage_Release( &s );
+
+  return s;
+}
+
+#ifdef HAVE_POSIX
+/** @internal
+ *  @brief   a file mapping behind a oyArray2d_s */
+typedef struct {
+  oyPointer    data;                   /**< mapped file */
+  size_t       size;                   /**< mapped bytes */
+} oyImageMap_s;
+
+static int   oyImageMapRelease_      ( oyPointer         * ptr )
+{
+  oyImageMap_s * m;
+
+  if(!ptr || !*ptr)
+    return 1;
+
+  m = (oyImageMap_s*) *ptr;
+  /* the kernel writes back the remaining dirty pages on its own */
+  munmap( m->data, m->size );
+  oyDeAllocateFunc_( m );
+  *ptr = 0;
+
+  return 0;
+}
+#endif
+
+/** @brief   create a image inside a memory mapped file
+ *  @memberof oyImage_s
+ *
+ *  The file is created or truncated to the header and the pixel body in
+ *  pixel_layout and mapped shared into memory. The image writes go to the
+ *  page cache and thus into the file. After oyConversion_RunPixels() the
+ *  file is complete without a separate write pass. The heap holds only the
+ *  row pointers. The mapping lives as long as the image pixel array.
+ *
+ *  The header is written unchanged, e.g. a PAM header. For samples larger
+ *  than one byte, its length should be a multiple of the sample size.
+ *  The samples are stored in host byte order unless the pixel_layout
+ *  requests otherwise.
+ *
+ *  @param[in]     filename            the file to create
+ *  @param[in]     width               image width
+ *  @param[in]     height              image height
+ *  @param[in]     header              optional text in front of the samples
+ *  @param[in]     pixel_layout        i.e. oyTYPE_123_16 for 16-bit RGB data
+ *  @param[in]     profile             colour space description
+ *  @param[in]     object              the optional base
+ *  @return                            the new image or zero on error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/09 (Oyranos: 0.3.2)
+ *  @date    2011/10/09
+ */
+oyImage_s *    oyImage_CreateMapped  ( const char        * filename,
+                                       int                 width,
+                                       int                 height,
+                                       const char        * header,
+                                       oyPixel_t           pixel_layout,
+                                       oyProfile_s       * profile,
+                                       oyObject_s          object )
+{
+  oyImage_s * s = 0;
+#ifdef HAVE_POSIX
+  int fd = -1, error = !filename || width <= 0 || height <= 0;
+  size_t header_size = header ? strlen( header ) : 0,
+         size = 0;
+  uint8_t * data = 0;
+  oyImageMap_s * m = 0;
+  oyPointer_s * ptr = 0;
+  oyOption_s * o = 0;
+  oyArray2d_s * a = 0;
+
+  if(!error)
+  {
+    size = header_size + (size_t)width * height *
+           oyToChannels_m( pixel_layout ) *
+           oySizeofDatatype( oyToDataType_m( pixel_layout ) );
+    fd = open( filename, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    error = fd < 0;
+  }
+
+  /* a sparse file; pages get allocated as they are written */
+  if(!error)
+    error = ftruncate( fd, (off_t)size ) != 0;
+
+  if(!error)
+  {
+    data = (uint8_t*) mmap( 0, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                            fd, 0 );
+    if(data == MAP_FAILED)
+    {
+      data = 0;
+      error = 1;
+    }
+  }
+
+  if(fd >= 0)
+    close( fd );
+
+  if(error)
+  {
+    WARNc2_S( "%s %s", _("Could not map file:"), oyNoEmptyString_m_(filename) );
+    return 0;
+  }
+
+  if(header_size)
+    memcpy( data, header, header_size );
+
+  oyAllocHelper_m_( m, oyImageMap_s, 1, oyAllocateFunc_,
+                    munmap( data, size ); return 0 );
+  m->data = data;
+  m->size = size;
+
+  s = oyImage_Create( width, height, &data[header_size], pixel_layout,
+                      profile, object );
+  if(s && s->pixel_data && s->pixel_data->type_ == oyOBJECT_ARRAY2D_S)
+    a = (oyArray2d_s*) s->pixel_data;
+
+  /* tie the mapping to the array, which might live longer than the image */
+  if(a)
+  {
+    ptr = oyPointer_New( 0 );
+    oyPointer_Set( ptr, 0, "oyImageMap_s", m, "oyImageMapRelease_",
+                   oyImageMapRelease_ );
+    m = 0;
+    o = oyOption_FromRegistration( OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL
+                     OY_SLASH OY_TYPE_STD OY_SLASH "oyArray2d_s/mapping", 0 );
+    error = oyOption_StructMoveIn( o, (oyStruct_s**)&ptr );
+    oyPointer_Release( &ptr );
+    if(!error && !a->oy_->handles_)
+      a->oy_->handles_ = oyOptions_New( 0 );
+    if(!error)
+      error = oyOptions_MoveIn( a->oy_->handles_, &o, -1 );
+    oyOption_Release( &o );
+  } else
+    error = 1;
+
+  if(error)
+  {
+    oyImage_Release( &s );
+    if(m)
+      oyImageMapRelease_( (oyPointer*)&m );
+  }
+#else
+  WARNc1_S( "%s", _("No memory mapping available") );
+#endif
+
+  return s;
+}
+
 /** @brief   collect infos about a image for showing one a display
  *  @memberof oyImage_s
 
@@ -5778,6 +6011,235 @@ int            oyImage_SetCritical    ( oyImage_s       * image,
   return error;
 }
 
+#define OY_IMAGE_TILE_CACHE_N 8
+#define OY_IMAGE_TILE_CACHE_REG OY_TOP_SHARED OY_SLASH OY_DOMAIN_INTERNAL \
+                             OY_SLASH OY_TYPE_STD OY_SLASH "oyImage_s/tile_cache"
+/** @internal
+ *  @brief   a allocated tile as kept in oyImageTileCache_s */
+typedef struct {
+  int          tile_x;                 /**< tile column */
+  int          tile_y;                 /**< tile row */
+  oyPointer  * tile;                   /**< the tile; zero for unused slots */
+  int          users;                  /**< running oyImage_FillArray calls */
+  unsigned int age;                    /**< last use */
+} oyImageTile_s;
+
+/** @internal
+ *  @brief   the last allocated tiles of a oyImage_s
+ *
+ *  The cache is held in the image object handles. Only allocated tiles are
+ *  kept, as others are owned by the image data module anyway.
+ */
+typedef struct {
+  oyStruct_s * pixel_data;             /**< the tiles source */
+  oyDeAlloc_f  deallocateFunc;         /**< the tiles deallocator */
+  unsigned int age;                    /**< use counter */
+  oyImageTile_s tiles[OY_IMAGE_TILE_CACHE_N];
+} oyImageTileCache_s;
+
+/* release all unused tiles */
+static void  oyImageTileCache_Flush_ ( oyImageTileCache_s* cache )
+{
+  int i;
+
+  for(i = 0; i < OY_IMAGE_TILE_CACHE_N; ++i)
+    if(cache->tiles[i].tile && !cache->tiles[i].users)
+    {
+      cache->deallocateFunc( cache->tiles[i].tile );
+      cache->tiles[i].tile = 0;
+    }
+}
+
+static int   oyImageTileCache_Release_(oyPointer         * ptr )
+{
+  oyImageTileCache_s * cache;
+
+  if(!ptr || !*ptr)
+    return 1;
+
+  cache = (oyImageTileCache_s*) *ptr;
+  oyImageTileCache_Flush_( cache );
+  oyDeAllocateFunc_( cache );
+  *ptr = 0;
+
+  return 0;
+}
+
+/* call with the image locked */
+static oyImageTileCache_s * oyImage_TileCacheGet_ (
+                                       oyImage_s         * image,
+                                       int                 create )
+{
+  oyImageTileCache_s * cache = 0;
+  oyPointer_s * ptr = 0;
+  oyOption_s * o = oyOptions_Find( image->oy_->handles_,
+                                   OY_IMAGE_TILE_CACHE_REG );
+
+  if(o)
+  {
+    ptr = (oyPointer_s*) oyOption_StructGet( o, oyOBJECT_POINTER_S );
+    cache = (oyImageTileCache_s*) oyPointer_GetPointer( ptr );
+    oyPointer_Release( &ptr );
+  } else if(create)
+  {
+    int error = 0;
+
+    oyAllocHelper_m_( cache, oyImageTileCache_s, 1, oyAllocateFunc_,
+                      error = 1 );
+    if(!error)
+    {
+      cache->deallocateFunc = image->oy_->deallocateFunc_;
+      ptr = oyPointer_New( 0 );
+      oyPointer_Set( ptr, 0, "oyImageTileCache_s", cache,
+                     "oyImageTileCache_Release_", oyImageTileCache_Release_ );
+      o = oyOption_FromRegistration( OY_IMAGE_TILE_CACHE_REG, 0 );
+      error = oyOption_StructMoveIn( o, (oyStruct_s**)&ptr );
+      oyPointer_Release( &ptr );
+    }
+    if(!error && !image->oy_->handles_)
+      image->oy_->handles_ = oyOptions_New( 0 );
+    if(!error)
+      error = oyOptions_MoveIn( image->oy_->handles_, &o, -1 );
+    /* the cache is released along with the option */
+    if(error)
+      cache = 0;
+  }
+  oyOption_Release( &o );
+
+  /* the image got new pixels */
+  if(cache && cache->pixel_data != image->pixel_data)
+  {
+    oyImageTileCache_Flush_( cache );
+    cache->pixel_data = image->pixel_data;
+  }
+
+  return cache;
+}
+
+/** @internal
+ *  Function oyImage_TileGet_
+ *  @memberof oyImage_s
+ *  @brief   obtain a tile through the image tile cache
+ *
+ *  Each tile must be given back by oyImage_TilePut_().
+ *
+ *  @param[in]     image               the image with getTile interface
+ *  @param[in]     tile_x              tile column
+ *  @param[in]     tile_y              tile row
+ *  @param[out]    is_allocated        the tile did not fit into the cache
+ *  @return                            the tile rows
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/07 (Oyranos: 0.3.2)
+ *  @date    2011/10/07
+ */
+static oyPointer * oyImage_TileGet_  ( oyImage_s         * image,
+                                       int                 tile_x,
+                                       int                 tile_y,
+                                       int               * is_allocated )
+{
+  oyImageTileCache_s * cache;
+  oyImageTile_s * t = 0;
+  oyPointer * tile = 0;
+  int i;
+
+  *is_allocated = 0;
+
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  cache = oyImage_TileCacheGet_( image, 0 );
+  for(i = 0; cache && i < OY_IMAGE_TILE_CACHE_N; ++i)
+    if(cache->tiles[i].tile &&
+       cache->tiles[i].tile_x == tile_x && cache->tiles[i].tile_y == tile_y)
+    {
+      t = &cache->tiles[i];
+      ++t->users;
+      t->age = ++cache->age;
+      tile = t->tile;
+      break;
+    }
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+
+  if(tile)
+    return tile;
+
+  tile = image->getTile( image, tile_x, tile_y, -1, is_allocated );
+  if(!tile || !*is_allocated)
+    return tile;
+
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  cache = oyImage_TileCacheGet_( image, 1 );
+  for(i = 0; cache && i < OY_IMAGE_TILE_CACHE_N; ++i)
+  {
+    oyImageTile_s * c = &cache->tiles[i];
+
+    /* a other thread was faster */
+    if(c->tile && c->tile_x == tile_x && c->tile_y == tile_y)
+    {
+      image->oy_->deallocateFunc_( tile );
+      tile = c->tile;
+      t = c;
+      break;
+    }
+    /* a empty or the least recently used slot */
+    if(!c->users && (!t || !c->tile || (t->tile && c->age < t->age)))
+      t = c;
+  }
+  if(t)
+  {
+    if(t->tile != tile)
+    {
+      if(t->tile)
+        cache->deallocateFunc( t->tile );
+      t->tile = tile;
+      t->tile_x = tile_x;
+      t->tile_y = tile_y;
+      t->users = 0;
+    }
+    ++t->users;
+    t->age = ++cache->age;
+    *is_allocated = 0;
+  }
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+
+  return tile;
+}
+
+/** @internal
+ *  Function oyImage_TilePut_
+ *  @memberof oyImage_s
+ *  @brief   give back a tile from oyImage_TileGet_()
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/10/07 (Oyranos: 0.3.2)
+ *  @date    2011/10/07
+ */
+static void  oyImage_TilePut_        ( oyImage_s         * image,
+                                       oyPointer         * tile,
+                                       int                 is_allocated )
+{
+  oyImageTileCache_s * cache;
+  int i;
+
+  if(!tile)
+    return;
+
+  if(is_allocated)
+  {
+    image->oy_->deallocateFunc_( tile );
+    return;
+  }
+
+  oyObject_Lock( image->oy_, __FILE__, __LINE__ );
+  cache = oyImage_TileCacheGet_( image, 0 );
+  for(i = 0; cache && i < OY_IMAGE_TILE_CACHE_N; ++i)
+    if(cache->tiles[i].tile == tile && cache->tiles[i].users)
+    {
+      --cache->tiles[i].users;
+      break;
+    }
+  oyObject_UnLock( image->oy_, __FILE__, __LINE__ );
+}
+
 /** Function oyImage_SetData
  *  @memberof oyImage_s
  *  @brief   set a custom image data module
@@ -5902,6 +6364,11 @@ int          oyArray2d_SetFocus      ( oyArray2d_s       * array,
  *  A given array will be filled. Allocation of a new array2d object happens as
  *  needed.
  *
+ *  Images with the getTile interface and a tile size are read from the tiles
+ *  covering the rectangle. Allocated tiles are kept in a small per image
+ *  cache for subsequent calls. Images with only a getPoint interface are
+ *  read point by point.
+ *
  *  @param[in]     image               the image
  *  @param[in]     rectangle           the image rectangle in a relative unit
  *                                     a rectangle in the source image
@@ -5920,9 +6387,9 @@ int          oyArray2d_SetFocus      ( oyArray2d_s       * array,
  *                                     The unit is relative to the image.
  *  @param[in]     obj                 the optional user object
  *
- *  @version Oyranos: 0.3.0
+ *  @version Oyranos: 0.3.2
  *  @since   2008/10/02 (Oyranos: 0.1.8)
- *  @date    2011/05/02
+ *  @date    2011/10/07
  */
 int            oyImage_FillArray     ( oyImage_s         * image,
                                        oyRectangle_s     * rectangle,
@@ -5997,7 +6464,7 @@ int            oyImage_FillArray     ( oyImage_s         * image,
       if(!error)
       {
         /* allocate each single line */
-        if(allocate_method == 1 || allocate_method == 2)
+        if(allocate_method == 1 || allocate_method == 2 || !image->getLine)
         {
           a->own_lines = 2;
 
@@ -6063,6 +6530,51 @@ int            oyImage_FillArray     ( oyImage_s         * image,
 
   if(a && !error)
   {
+  if(image->getTile && image->tile_width > 0 && image->tile_height > 0 &&
+     !(allocate_method == 0 && image->getLine))
+  {
+    /* gather only the tiles covering the rectangle */
+    int channels = image->layout_[oyCHANS],
+        pixel_size = channels * data_size,
+        x0 = OY_ROUND(image_roi_pix.x) / channels,
+        y0 = OY_ROUND(image_roi_pix.y),
+        x1 = x0 + OY_ROUND(image_roi_pix.width) / channels,
+        y1 = y0 + OY_ROUND(image_roi_pix.height),
+        tw = image->tile_width,
+        th = image->tile_height,
+        tx, ty, x, y;
+
+    if(x1 > image->width) x1 = image->width;
+    if(y1 > image->height) y1 = image->height;
+    if(y1 - y0 > array_roi_pix.height) y1 = y0 + array_roi_pix.height;
+
+    if(allocate_method != 2)
+    for(ty = y0 / th; ty * th < y1 && !error; ++ty)
+      for(tx = x0 / tw; tx * tw < x1 && !error; ++tx)
+      {
+        int xs = x0 > tx * tw ? x0 : tx * tw,
+            xe = x1 < (tx + 1) * tw ? x1 : (tx + 1) * tw,
+            ys = y0 > ty * th ? y0 : ty * th,
+            ye = y1 < (ty + 1) * th ? y1 : (ty + 1) * th;
+        oyPointer * tile = oyImage_TileGet_( image, tx, ty, &is_allocated );
+
+        if(!tile)
+        {
+          WARNc2_S("image->getTile failed: %d,%d", tx, ty)
+          error = 1;
+          break;
+        }
+
+        x = (xs - tx * tw) * pixel_size;
+        for(y = ys; y < ye; ++y)
+          memcpy( &a->array2d[y - y0][(xs - x0) * pixel_size],
+                  &((unsigned char*)tile[y - ty * th])[x],
+                  (xe - xs) * pixel_size );
+
+        oyImage_TilePut_( image, tile, is_allocated );
+      }
+
+  } else
   if(image->getLine)
   {
     oyPointer src, dst;
@@ -6102,11 +6614,36 @@ int            oyImage_FillArray     ( oyImage_s         * image,
   } else
   if(image->getPoint)
   {
-    WARNc_S("image->getPoint  not yet supported")
+    int channels = image->layout_[oyCHANS],
+        pixel_size = channels * data_size,
+        x0 = OY_ROUND(image_roi_pix.x) / channels,
+        n = OY_ROUND(image_roi_pix.width) / channels,
+        x;
+    unsigned char * point;
+
+    if(allocate_method != 2)
+    for( i = 0; i < image_roi_pix.height && i < array_roi_pix.height &&
+                !error; ++i )
+      for( x = 0; x < n; ++x )
+      {
+        is_allocated = 0;
+        point = image->getPoint( image, x0 + x, image_roi_pix.y + i, -1,
+                                 &is_allocated );
+        if(!point)
+        {
+          WARNc2_S("image->getPoint failed: %d,%d", x0 + x,
+                   (int)image_roi_pix.y + i)
+          error = 1;
+          break;
+        }
+        memcpy( &a->array2d[i][x * pixel_size], point, pixel_size );
+        if(is_allocated)
+          image->oy_->deallocateFunc_( point );
+      }
   } else
   if(image->getTile)
   {
-    WARNc_S("image->getTile  not yet supported")
+    WARNc_S("image->getTile needs oyImage_s::tile_width and tile_height")
     error = 1;
   }
   }
@@ -6261,203 +6798,946 @@ oyOptions_s *  oyImage_TagsGet       ( oyImage_s         * image )
   return oyOptions_Copy( s->tags, 0 );
 }
 
-/**
- *  @internal
- *  @func    oyImage_PpmWrite
- *  @memberof oyArray2d_s
- *  @brief   implement oyCMMFilter_GetNext_f()
+/** Function oyImage_TagsClear
+ *  @memberof oyImage_s
+ *  @brief   remove all tags matching a registration
  *
- *  @param[in]     image               the image
- *  @param[in]     file_name           a writeable file name, The file can 
- *                                     contain "%d" to include the image ID.
- *  @param[in]     free_text           A text to include as comment.
+ *  @param[in,out] image               the image
+ *  @param[in]     registration        the tag registration pattern
+ *  @return                            number of removed tags
  *
- *  @version Oyranos: 0.3.1
- *  @since   2008/10/07 (Oyranos: 0.1.8)
- *  @date    2011/05/12
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
  */
-int          oyImage_PpmWrite        ( oyImage_s         * image,
-                                       const char        * file_name,
-                                       const char        * free_text )
+int            oyImage_TagsClear     ( oyImage_s         * image,
+                                       const char        * registration )
 {
-  int error = !file_name;
-  FILE * fp = 0;
-  char * filename = 0;
   oyImage_s * s = image;
+  oyOption_s * o = 0;
+  int i, n, removed = 0;
 
-  oyCheckType__m( oyOBJECT_IMAGE_S, return 1 )
+  if(!s || !registration)
+    return 0;
 
-  if(!error)
-    oyAllocHelper_m_( filename, char, strlen(file_name)+80, 0, return 1 );
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 0 )
 
-  if(!error)
+  n = oyOptions_Count( s->tags );
+  for(i = n - 1; i >= 0; --i)
   {
-    if(strstr(file_name, "%d"))
-      sprintf( filename, file_name, oyStruct_GetId( (oyStruct_s*)s ) );
-    else
-      strcpy(filename,file_name);
+    o = oyOptions_Get( s->tags, i );
+    if(oyFilterRegistrationMatch( oyOption_GetRegistration( o ),
+                                  registration, 0 ))
+    {
+      oyOptions_ReleaseAt( s->tags, i );
+      ++removed;
+    }
+    oyOption_Release( &o );
   }
 
-  if(filename)
-    fp = fopen( filename, "wb" );
-  else
-    error = 2;
-
-  if(fp)
-  {
-      size_t pt = 0;
-      char text[128];
-      char * t = 0;
-      int  len = 0;
-      int  i,j,k,l, n;
-      char bytes[48];
+  return removed;
+}
 
-      int cchan_n = oyProfile_GetChannelsCount( image->profile_ );
-      int channels = oyToChannels_m( image->layout_[0] );
-      oyDATATYPE_e data_type = oyToDataType_m( image->layout_[0] );
-      int alpha = channels - cchan_n;
-      int byteps = oySizeofDatatype( data_type );
-      const char * colourspacename = oyProfile_GetText( image->profile_,
-                                                        oyNAME_DESCRIPTION );
-      char * vs = oyVersionString(1,malloc);
-      uint8_t * out_values = 0;
-      const uint8_t * u8;
-      double * dbls;
-      float flt;
+/** @internal
+ *  Function oyImage_PyramidKey_
+ *  @brief   registration of a pyramid level in the image tags
+ */
+static void    oyImage_PyramidKey_   ( int                 level,
+                                       char              * key )
+{
+  oySprintf_( key, "//" OY_TYPE_STD "/pyramid/level_%d", level );
+}
 
-            fputc( 'P', fp );
-      if(alpha) 
-            fputc( '7', fp );
-      else
-      {
-        if(byteps == 1 ||
-           byteps == 2)
-        {
-          if(channels == 1)
-            fputc( '5', fp );
-          else
-            fputc( '6', fp );
-        } else
-        if (byteps == 4 || byteps == 8)
-        {
-          if(channels == 1)
-            fputc( 'f', fp ); /* PFM gray */
-          else
-            fputc( 'F', fp ); /* PFM rgb */
-        }
-      }
+/** Function oyImage_PyramidClear
+ *  @memberof oyImage_s
+ *  @brief   remove all cached pyramid levels from a image
+ *
+ *  Call this function when the graph, which has generated the levels,
+ *  becomes dirty.
+ *
+ *  @param[in,out] image               the image
+ *  @return                            0 - success, >= 1 - error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/09/16
+ */
+int            oyImage_PyramidClear  ( oyImage_s         * image )
+{
+  oyImage_s * s = image;
+  oyOption_s * o = 0;
+  int i, n;
+
+  if(!s)
+    return 1;
+
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 1 )
+
+  n = oyOptions_Count( s->tags );
+  for(i = n - 1; i >= 0; --i)
+  {
+    o = oyOptions_Get( s->tags, i );
+    if(oyFilterRegistrationMatch( oyOption_GetRegistration( o ),
+                                  "//" OY_TYPE_STD "/pyramid", 0 ))
+      oyOptions_ReleaseAt( s->tags, i );
+    oyOption_Release( &o );
+  }
+
+  return 0;
+}
+
+/** Function oyImage_PyramidLevelSet
+ *  @memberof oyImage_s
+ *  @brief   cache a converted and downsampled version of a image
+ *
+ *  The levels are stored as image tags. Each level is meant to hold the
+ *  image with the size divided by 2^level. The hash_text identifies the
+ *  processing, typical the text of the ICC node, which is used for the
+ *  device link hash. Setting a level with a different hash_text drops all
+ *  previously stored levels.
+ *
+ *  @param[in,out] image               the image to attach the level to
+ *  @param[in]     hash_text           identifier of the processing
+ *  @param[in]     level               the level; 0 means full size
+ *  @param[in]     level_image         the level data; a reference is held
+ *  @return                            0 - success, >= 1 - error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/09/16
+ */
+int            oyImage_PyramidLevelSet(oyImage_s         * image,
+                                       const char        * hash_text,
+                                       int                 level,
+                                       oyImage_s         * level_image )
+{
+  oyImage_s * s = image;
+  oyImage_s * l = 0;
+  const char * old_hash = 0;
+  char key[80];
+  int error = !s || !hash_text || !level_image || level < 0;
+
+  if(error)
+    return error;
+
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 1 )
+
+  old_hash = oyOptions_FindString( s->tags, "//" OY_TYPE_STD "/pyramid/hash",
+                                   0 );
+  if(!old_hash || strcmp( old_hash, hash_text ) != 0)
+  {
+    oyImage_PyramidClear( s );
+    error = oyOptions_SetFromText( &s->tags, "//" OY_TYPE_STD "/pyramid/hash",
+                                   hash_text, OY_CREATE_NEW );
+  }
+
+  if(error <= 0)
+  {
+    oyImage_PyramidKey_( level, key );
+    l = oyImage_Copy( level_image, 0 );
+    error = oyOptions_MoveInStruct( &s->tags, key, (oyStruct_s**)&l,
+                                    OY_CREATE_NEW );
+  }
+
+  return error;
+}
+
+/** Function oyImage_PyramidLevelGet
+ *  @memberof oyImage_s
+ *  @brief   obtain a cached pyramid level
+ *
+ *  @param[in]     image               the image with the levels
+ *  @param[in]     hash_text           identifier of the processing; levels
+ *                                     from a other processing are not
+ *                                     returned
+ *  @param[in]     level               the level
+ *  @return                            the level image or zero
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/16 (Oyranos: 0.3.2)
+ *  @date    2011/09/16
+ */
+oyImage_s *    oyImage_PyramidLevelGet(oyImage_s         * image,
+                                       const char        * hash_text,
+                                       int                 level )
+{
+  oyImage_s * s = image;
+  const char * old_hash = 0;
+  char key[80];
+
+  if(!s || !hash_text || level < 0)
+    return 0;
+
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 0 )
+
+  old_hash = oyOptions_FindString( s->tags, "//" OY_TYPE_STD "/pyramid/hash",
+                                   0 );
+  if(!old_hash || strcmp( old_hash, hash_text ) != 0)
+    return 0;
+
+  oyImage_PyramidKey_( level, key );
+
+  return (oyImage_s*) oyOptions_GetType( s->tags, -1, key, oyOBJECT_IMAGE_S );
+}
+
+/* pixel layouts can hold up to 255 channels */
+#define oyCHANNELS_MAX_ 256
+
+/** @internal
+ *  Function oyPixelExtraChannels_
+ *  @brief   list the non colour channel positions of a interleaved pixel
+ *
+ *  @return                            number of extra channels or -1
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/05 (Oyranos: 0.3.2)
+ *  @date    2011/09/05
+ */
+static int   oyPixelExtraChannels_   ( oyPixel_t           pixel_layout,
+                                       int                 colour_channels,
+                                       int               * positions,
+                                       int                 max )
+{
+  int chan_n = oyToChannels_m( pixel_layout ),
+      coff = oyToColourOffset_m( pixel_layout ),
+      i, n = 0;
+
+  if(oyToPlanar_m( pixel_layout ) || colour_channels > chan_n)
+    return -1;
+
+  for(i = 0; i < chan_n && n < max; ++i)
+    if(i < coff || i >= coff + colour_channels)
+      positions[n++] = i;
+
+  return n;
+}
+
+/* normalised sample reading and writing for the mixed type copy path */
+static double oyPixelSampleGet_      ( const oyPointer     data,
+                                       oyDATATYPE_e        data_type,
+                                       size_t              pos )
+{
+  switch(data_type)
+  {
+  case oyUINT8:  return ((const uint8_t*)data)[pos] / 255.0;
+  case oyUINT16: return ((const uint16_t*)data)[pos] / 65535.0;
+  case oyFLOAT:  return ((const float*)data)[pos];
+  case oyDOUBLE: return ((const double*)data)[pos];
+  default:       return 0.0;
+  }
+}
+static void   oyPixelSampleSet_      ( oyPointer           data,
+                                       oyDATATYPE_e        data_type,
+                                       size_t              pos,
+                                       double              v )
+{
+  switch(data_type)
+  {
+  case oyUINT8:  v = v * 255.0 + 0.5;
+                 ((uint8_t*)data)[pos] = v < 0 ? 0 : v > 255 ? 255 : (uint8_t)v;
+                 break;
+  case oyUINT16: v = v * 65535.0 + 0.5;
+                 ((uint16_t*)data)[pos] = v < 0 ? 0 : v > 65535 ? 65535 :
+                                          (uint16_t)v;
+                 break;
+  case oyFLOAT:  ((float*)data)[pos] = v; break;
+  case oyDOUBLE: ((double*)data)[pos] = v; break;
+  default:       break;
+  }
+}
+
+/* strided copy of one channel; the constant strides let the compiler unroll
+ * and vectorise the common RGBA cases */
+#define oyALPHA_COPY_m( type, src_, dst_, s_pos, d_pos, s_n, d_n, n ) \
+{ \
+  const type * s_ = (const type*)(src_) + (s_pos); \
+  type * d_ = (type*)(dst_) + (d_pos); \
+  int i_; \
+  if((s_n) == 4 && (d_n) == 4) \
+    for(i_ = 0; i_ < (n); ++i_) d_[i_*4] = s_[i_*4]; \
+  else if((s_n) == 2 && (d_n) == 2) \
+    for(i_ = 0; i_ < (n); ++i_) d_[i_*2] = s_[i_*2]; \
+  else \
+    for(i_ = 0; i_ < (n); ++i_) d_[i_*(d_n)] = s_[i_*(s_n)]; \
+}
+
+/** Function oyPixelAlphaCopy
+ *  @ingroup objects_image
+ *  @brief   copy extra channels between two pixel lines
+ *
+ *  Colour transforms do usually only touch the profile described colour
+ *  channels. This function passes alpha and other extra channels from the
+ *  source to the destination line without routing them through a CMM.
+ *  Extra channels are the ones outside the colour offset range. Both lines
+ *  must be interleaved. Integer and floating point types are scaled to the
+ *  destination range.
+ *
+ *  @param[in]     src                 source line
+ *  @param[in]     src_layout          source pixel layout
+ *  @param[in]     src_colours         colour channels in src
+ *  @param[out]    dst                 destination line
+ *  @param[in]     dst_layout          destination pixel layout
+ *  @param[in]     dst_colours         colour channels in dst
+ *  @param[in]     pixel_n             pixels to process
+ *  @return                            0 - success, 1 - error, -1 nothing to do
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/05 (Oyranos: 0.3.2)
+ *  @date    2011/09/05
+ */
+int            oyPixelAlphaCopy      ( const oyPointer     src,
+                                       oyPixel_t           src_layout,
+                                       int                 src_colours,
+                                       oyPointer           dst,
+                                       oyPixel_t           dst_layout,
+                                       int                 dst_colours,
+                                       int                 pixel_n )
+{
+  int s_pos[oyCHANNELS_MAX_], d_pos[oyCHANNELS_MAX_];
+  int s_n = oyToChannels_m( src_layout ),
+      d_n = oyToChannels_m( dst_layout );
+  oyDATATYPE_e s_t = oyToDataType_m( src_layout ),
+               d_t = oyToDataType_m( dst_layout );
+  int extra_n, e, i;
+
+  if(!src || !dst || pixel_n <= 0)
+    return 1;
+
+  if(oyToByteswap_m( src_layout ) != oyToByteswap_m( dst_layout ))
+    return 1;
+
+  extra_n = oyPixelExtraChannels_( src_layout, src_colours, s_pos,
+                                   oyCHANNELS_MAX_ );
+  e = oyPixelExtraChannels_( dst_layout, dst_colours, d_pos, oyCHANNELS_MAX_ );
+  if(extra_n < 0 || e < 0)
+    return 1;
+  extra_n = OY_MIN( extra_n, e );
+  if(!extra_n)
+    return -1;
+
+  for(e = 0; e < extra_n; ++e)
+  {
+    if(s_t == d_t)
+    switch(s_t)
+    {
+    case oyUINT8:
+         oyALPHA_COPY_m( uint8_t, src,dst, s_pos[e],d_pos[e], s_n,d_n, pixel_n)
+         break;
+    case oyUINT16:
+    case oyHALF:
+         oyALPHA_COPY_m( uint16_t, src,dst, s_pos[e],d_pos[e], s_n,d_n, pixel_n)
+         break;
+    case oyUINT32:
+    case oyFLOAT:
+         oyALPHA_COPY_m( uint32_t, src,dst, s_pos[e],d_pos[e], s_n,d_n, pixel_n)
+         break;
+    case oyDOUBLE:
+         oyALPHA_COPY_m( double, src,dst, s_pos[e],d_pos[e], s_n,d_n, pixel_n)
+         break;
+    }
+    else if(s_t == oyUINT16 && d_t == oyUINT8)
+    {
+      /* the typical display path */
+      const uint16_t * s = (const uint16_t*)src + s_pos[e];
+      uint8_t * d = (uint8_t*)dst + d_pos[e];
+      for(i = 0; i < pixel_n; ++i)
+        d[i*d_n] = (s[i*s_n] * 255u + 32895u) >> 16;
+    }
+    else if(s_t == oyUINT8 && d_t == oyUINT16)
+    {
+      const uint8_t * s = (const uint8_t*)src + s_pos[e];
+      uint16_t * d = (uint16_t*)dst + d_pos[e];
+      for(i = 0; i < pixel_n; ++i)
+        d[i*d_n] = s[i*s_n] * 257;
+    }
+    else if(s_t == oyHALF || d_t == oyHALF || s_t == oyUINT32 || d_t == oyUINT32)
+      return 1;
+    else
+      for(i = 0; i < pixel_n; ++i)
+        oyPixelSampleSet_( dst, d_t, (size_t)i*d_n + d_pos[e],
+                      oyPixelSampleGet_( src, s_t, (size_t)i*s_n + s_pos[e] ) );
+  }
+
+  return 0;
+}
+
+#define oyALPHA_MULTIPLY_INT_m( type, max, line_, a_pos, c_pos, c_n, chan_n, n, un ) \
+{ \
+  type * p_ = (type*)(line_); \
+  int i_, c_; \
+  for(i_ = 0; i_ < (n); ++i_) \
+  { \
+    type * px_ = &p_[i_ * (chan_n)]; \
+    uint32_t a_ = px_[a_pos]; \
+    if(un) \
+    { \
+      if(a_ == 0) \
+        for(c_ = 0; c_ < (c_n); ++c_) px_[(c_pos)+c_] = 0; \
+      else if(a_ != (max)) \
+        for(c_ = 0; c_ < (c_n); ++c_) \
+        { \
+          uint32_t v_ = (px_[(c_pos)+c_] * (uint64_t)(max) + a_/2) / a_; \
+          px_[(c_pos)+c_] = v_ > (max) ? (max) : v_; \
+        } \
+    } else \
+      for(c_ = 0; c_ < (c_n); ++c_) \
+        px_[(c_pos)+c_] = (px_[(c_pos)+c_] * (uint64_t)a_ + (max)/2) / (max); \
+  } \
+}
+
+#define oyALPHA_MULTIPLY_FLT_m( type, line_, a_pos, c_pos, c_n, chan_n, n, un ) \
+{ \
+  type * p_ = (type*)(line_); \
+  int i_, c_; \
+  for(i_ = 0; i_ < (n); ++i_) \
+  { \
+    type * px_ = &p_[i_ * (chan_n)]; \
+    type a_ = px_[a_pos]; \
+    if(un) \
+      a_ = a_ > 0 ? 1 / a_ : 0; \
+    for(c_ = 0; c_ < (c_n); ++c_) \
+      px_[(c_pos)+c_] *= a_; \
+  } \
+}
+
+/** Function oyPixelAlphaMultiply
+ *  @ingroup objects_image
+ *  @brief   premultiply or unpremultiply colour channels by alpha
+ *
+ *  The first extra channel is considered as alpha. The line is modified in
+ *  place. Use unpremultiply before sending premultiplied pixels through a
+ *  colour transform and premultiply afterwards.
+ *
+ *  @param[in,out] line                interleaved pixel line
+ *  @param[in]     layout              pixel layout of line
+ *  @param[in]     colours             colour channels in line
+ *  @param[in]     pixel_n             pixels to process
+ *  @param[in]     unpremultiply       0 - premultiply, 1 - unpremultiply
+ *  @return                            0 - success, 1 - error, -1 no alpha
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/05 (Oyranos: 0.3.2)
+ *  @date    2011/09/05
+ */
+int            oyPixelAlphaMultiply  ( oyPointer           line,
+                                       oyPixel_t           layout,
+                                       int                 colours,
+                                       int                 pixel_n,
+                                       int                 unpremultiply )
+{
+  int pos[oyCHANNELS_MAX_];
+  int chan_n = oyToChannels_m( layout ),
+      coff = oyToColourOffset_m( layout );
+  oyDATATYPE_e t = oyToDataType_m( layout );
+  int extra_n;
+
+  if(!line || pixel_n <= 0 || oyToByteswap_m( layout ))
+    return 1;
+
+  extra_n = oyPixelExtraChannels_( layout, colours, pos, oyCHANNELS_MAX_ );
+  if(extra_n < 0)
+    return 1;
+  if(!extra_n)
+    return -1;
+
+  switch(t)
+  {
+  case oyUINT8:
+       oyALPHA_MULTIPLY_INT_m( uint8_t, 255, line, pos[0], coff, colours,
+                               chan_n, pixel_n, unpremultiply )
+       break;
+  case oyUINT16:
+       oyALPHA_MULTIPLY_INT_m( uint16_t, 65535, line, pos[0], coff, colours,
+                               chan_n, pixel_n, unpremultiply )
+       break;
+  case oyFLOAT:
+       oyALPHA_MULTIPLY_FLT_m( float, line, pos[0], coff, colours,
+                               chan_n, pixel_n, unpremultiply )
+       break;
+  case oyDOUBLE:
+       oyALPHA_MULTIPLY_FLT_m( double, line, pos[0], coff, colours,
+                               chan_n, pixel_n, unpremultiply )
+       break;
+  default:
+       return 1;
+  }
+
+  return 0;
+}
+
+/* 8x8 Bayer matrix for ordered dithering */
+static const uint8_t oy_dither_bayer8_[8][8] = {
+  { 0, 32,  8, 40,  2, 34, 10, 42},
+  {48, 16, 56, 24, 50, 18, 58, 26},
+  {12, 44,  4, 36, 14, 46,  6, 38},
+  {60, 28, 52, 20, 62, 30, 54, 22},
+  { 3, 35, 11, 43,  1, 33,  9, 41},
+  {51, 19, 59, 27, 49, 17, 57, 25},
+  {15, 47,  7, 39, 13, 45,  5, 37},
+  {63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+/** Function oyPixelDither16To8
+ *  @ingroup objects_image
+ *  @brief   quantise 16-bit samples to 8-bit with ordered dithering
+ *
+ *  The threshold depends only on the absolute image position. Lines,
+ *  tiles and threads can therefore be processed independently without
+ *  visible seams.
+ *
+ *  @param[in]     src                 interleaved 16-bit line
+ *  @param[out]    dst                 interleaved 8-bit line
+ *  @param[in]     channels            samples per pixel
+ *  @param[in]     pixel_n             pixels to process
+ *  @param[in]     x                   image position of the first pixel
+ *  @param[in]     y                   image line
+ *  @return                            error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/09 (Oyranos: 0.3.2)
+ *  @date    2011/09/09
+ */
+int            oyPixelDither16To8    ( const uint16_t    * src,
+                                       uint8_t           * dst,
+                                       int                 channels,
+                                       int                 pixel_n,
+                                       int                 x,
+                                       int                 y )
+{
+  uint32_t t[8];
+  int i, c;
 
-      fputc( '\n', fp );
+  if(!src || !dst || channels <= 0 || pixel_n < 0)
+    return 1;
 
-      oyStringAddPrintf_( &t, oyAllocateFunc_, oyDeAllocateFunc_,
-                "# CREATOR: Oyranos-%s\n%s\n",
-                oyNoEmptyString_m_(vs), 
-                free_text?free_text:"" );
-      if(vs) free(vs); vs = 0;
-      len = strlen( t );
-      do { fputc ( t[pt] , fp); if(t[pt] == '\n') fputc( '#', fp ); pt++; } while (--len); pt = 0;
-      fputc( '\n', fp );
-      oyFree_m_( t );
+  /* thresholds spread over the 1/65536 range of one 8-bit step;
+   * v*255 + v/256 maps 65535 exactly to 255 << 16 */
+  for(i = 0; i < 8; ++i)
+    t[i] = oy_dither_bayer8_[y & 7][(x + i) & 7] * 1024 + 512;
 
+  if(channels == 3)
+    for(i = 0; i < pixel_n; ++i)
+    {
+      uint32_t ti = t[i & 7];
+      const uint16_t * s = &src[i*3];
+      uint8_t * d = &dst[i*3];
+      d[0] = (s[0] * 255u + (s[0] >> 8) + ti) >> 16;
+      d[1] = (s[1] * 255u + (s[1] >> 8) + ti) >> 16;
+      d[2] = (s[2] * 255u + (s[2] >> 8) + ti) >> 16;
+    }
+  else if(channels == 4)
+    for(i = 0; i < pixel_n; ++i)
+    {
+      uint32_t ti = t[i & 7];
+      const uint16_t * s = &src[i*4];
+      uint8_t * d = &dst[i*4];
+      d[0] = (s[0] * 255u + (s[0] >> 8) + ti) >> 16;
+      d[1] = (s[1] * 255u + (s[1] >> 8) + ti) >> 16;
+      d[2] = (s[2] * 255u + (s[2] >> 8) + ti) >> 16;
+      d[3] = (s[3] * 255u + (s[3] >> 8) + ti) >> 16;
+    }
+  else
+    for(i = 0; i < pixel_n; ++i)
+    {
+      uint32_t ti = t[i & 7];
+      for(c = 0; c < channels; ++c)
       {
-        time_t  cutime;         /* Time since epoch */
-        struct tm       *gmt;
-        char time_str[24];
-
-        cutime = time(NULL); /* time right NOW */
-        gmt = gmtime(&cutime);
-        strftime(time_str, 24, "%Y/%m/%d %H:%M:%S", gmt);
-        snprintf( text, 128, "# DATE/TIME: %s\n", time_str );
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
+        uint32_t v = src[i*channels + c];
+        dst[i*channels + c] = (v * 255u + (v >> 8) + ti) >> 16;
       }
+    }
 
-      snprintf( text, 128, "# COLORSPACE: %s\n", colourspacename ?
-                colourspacename : "--" );
-      len = strlen( text );
-      do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
+  return 0;
+}
 
-      if(byteps == 1)
-        snprintf( bytes, 48, "255" );
-      else
-      if(byteps == 2)
-        snprintf( bytes, 48, "65535" );
+/** Function oyImage_IsPremultiplied
+ *  @memberof oyImage_s
+ *  @brief   check if the colour channels are premultiplied by alpha
+ *
+ *  The information is taken from oyImage_s::channel_layout.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/05 (Oyranos: 0.3.2)
+ *  @date    2011/09/05
+ */
+int            oyImage_IsPremultiplied(oyImage_s         * image )
+{
+  oyImage_s * s = image;
+  int i;
+
+  if(!s)
+    return 0;
+
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 0 )
+
+  if(!s->channel_layout)
+    return 0;
+
+  for(i = 0; s->channel_layout[i] != oyCHANNELTYPE_UNDEFINED; ++i)
+    if(s->channel_layout[i] == oyCHANNELTYPE_COLOUR_LIGHTNESS_PREMULTIPLIED)
+      return 1;
+
+  return 0;
+}
+
+/**
+ *  @internal
+ *  @func    oyPpmSwap16_
+ *  @brief   copy 16-bit samples in big endian byte order
+ *
+ *  The loop is kept simple for compiler vectorisation.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/21 (Oyranos: 0.3.2)
+ *  @date    2011/09/21
+ */
+static void  oyPpmSwap16_            ( const uint16_t    * src,
+                                       uint16_t          * dst,
+                                       int                 n )
+{
+  int i;
+  for(i = 0; i < n; ++i)
+    dst[i] = (uint16_t)((src[i] << 8) | (src[i] >> 8));
+}
+
+/**
+ *  @internal
+ *  @func    oyPpmWriteLines
+ *  @brief   write pixel lines into a PPM, PAM or PFM stream
+ *
+ *  The lines are written with one fwrite() call. 8-bit and float samples
+ *  are written directly, if the lines are continuous in memory. 16-bit
+ *  samples are swapped to big endian and double samples are converted to
+ *  float in a strip buffer. Use this function to stream strips behind
+ *  oyImage_PpmWriteHeader().
+ *
+ *  @param[in]     fp                  the open file
+ *  @param[in]     lines               line pointers
+ *  @param[in]     line_n              number of lines
+ *  @param[in]     samples             samples per line
+ *  @param[in]     data_type           the sample type
+ *  @return                            0 - success, >= 1 - error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/21 (Oyranos: 0.3.2)
+ *  @date    2011/09/21
+ */
+int          oyPpmWriteLines         ( FILE              * fp,
+                                       oyPointer         * lines,
+                                       int                 line_n,
+                                       int                 samples,
+                                       oyDATATYPE_e        data_type )
+{
+  int byteps = oySizeofDatatype( data_type );
+  int out_byteps = byteps == 8 ? 4 : byteps;
+  size_t len = (size_t)samples * out_byteps;
+  int continous = 1,
+      convert = byteps == 8 || (byteps == 2 && !oyBigEndian());
+  uint8_t * buf = 0;
+  int i, k, error = !fp || !lines || samples <= 0 ||
+                    !(data_type == oyUINT8 || data_type == oyUINT16 ||
+                      data_type == oyFLOAT || data_type == oyDOUBLE);
+
+  if(error || line_n <= 0)
+    return error;
+
+  for(k = 1; k < line_n; ++k)
+    if((uint8_t*)lines[k] != (uint8_t*)lines[k-1] + len)
+      continous = 0;
+
+  if(!convert && continous)
+    return fwrite( lines[0], len, line_n, fp ) != (size_t)line_n;
+
+  if(!convert)
+  {
+    for(k = 0; k < line_n && !error; ++k)
+      error = fwrite( lines[k], len, 1, fp ) != 1;
+    return error;
+  }
+
+  oyAllocHelper_m_( buf, uint8_t, len * line_n, 0, return 1 );
+
+  for(k = 0; k < line_n; ++k)
+  {
+    if(byteps == 2)
+      oyPpmSwap16_( (const uint16_t*)lines[k], (uint16_t*)&buf[k * len],
+                    samples );
+    else
+    {
+      const double * dbls = (const double*)lines[k];
+      float * flts = (float*)&buf[k * len];
+      for(i = 0; i < samples; ++i)
+        flts[i] = dbls[i];
+    }
+  }
+
+  error = fwrite( buf, len, line_n, fp ) != (size_t)line_n;
+
+  oyFree_m_( buf );
+
+  return error;
+}
+
+/**
+ *  @internal
+ *  @func    oyImage_PpmWriteHeader
+ *  @memberof oyImage_s
+ *  @brief   write the PPM, PAM or PFM header of a image
+ *
+ *  @param[in]     image               the image
+ *  @param[in]     fp                  the open file
+ *  @param[in]     free_text           A text to include as comment.
+ *  @return                            0 - success, >= 1 - error
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/21 (Oyranos: 0.3.2)
+ *  @date    2011/09/21
+ */
+int          oyImage_PpmWriteHeader  ( oyImage_s         * image,
+                                       FILE              * fp,
+                                       const char        * free_text )
+{
+  char text[128];
+  char * t = 0,
+       * header = 0;
+  const char * line, * end;
+  char bytes[48];
+  int  error = 0;
+  size_t len;
+
+  int cchan_n = oyProfile_GetChannelsCount( image->profile_ );
+  int channels = oyToChannels_m( image->layout_[0] );
+  oyDATATYPE_e data_type = oyToDataType_m( image->layout_[0] );
+  int alpha = channels - cchan_n;
+  int byteps = oySizeofDatatype( data_type );
+  const char * colourspacename = oyProfile_GetText( image->profile_,
+                                                    oyNAME_DESCRIPTION );
+  char * vs = oyVersionString(1,malloc);
+
+  if(alpha)
+    STRING_ADD( header, "P7" );
+  else
+  {
+    if(byteps == 1 ||
+       byteps == 2)
+    {
+      if(channels == 1)
+        STRING_ADD( header, "P5" );
       else
-      if (byteps == 4 || byteps == 8) 
-      {
-        if(oyBigEndian())
-          snprintf( bytes, 48, "1.0" );
-        else
-          snprintf( bytes, 48, "-1.0" );
-      }
+        STRING_ADD( header, "P6" );
+    } else
+    if (byteps == 4 || byteps == 8)
+    {
+      if(channels == 1)
+        STRING_ADD( header, "Pf" ); /* PFM gray */
       else
-        oyMessageFunc_p( oyMSG_WARN, (oyStruct_s*)image,
-             OY_DBG_FORMAT_ " byteps: %d",
-             OY_DBG_ARGS_, byteps );
+        STRING_ADD( header, "PF" ); /* PFM rgb */
+    } else
+      STRING_ADD( header, "P" );
+  }
 
+  STRING_ADD( header, "\n" );
 
-      if(alpha)
-      {
-        const char *tupl = "RGB_ALPHA";
+  oyStringAddPrintf_( &t, oyAllocateFunc_, oyDeAllocateFunc_,
+            "# CREATOR: Oyranos-%s\n%s\n",
+            oyNoEmptyString_m_(vs), 
+            free_text?free_text:"" );
+  if(vs) free(vs); vs = 0;
+  /* continue each comment line with a hash sign */
+  line = t;
+  while((end = strchr( line, '\n' )) != 0)
+  {
+    oyStringAddPrintf_( &header, oyAllocateFunc_, oyDeAllocateFunc_,
+                        "%.*s#", (int)(end - line + 1), line );
+    line = end + 1;
+  }
+  STRING_ADD( header, line );
+  STRING_ADD( header, "\n" );
+  oyFree_m_( t );
 
-        if(channels == 2)
-          tupl = "GRAYSCALE_ALPHA";
-        snprintf( text, 128, "WIDTH %d\nHEIGHT %d\nDEPTH %d\nMAXVAL "
-                  "%s\nTUPLTYPE %s\nENDHDR\n",
-                  image->width, image->height,
-                  channels, bytes, tupl );
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
+  {
+    time_t  cutime;         /* Time since epoch */
+    struct tm       *gmt;
+    char time_str[24];
 
-      }
-      else
-      {
-        snprintf( text, 128, "%d %d\n", image->width,
-                                       image->height);
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
-
-        snprintf( text, 128, "%s\n", bytes );
-        len = strlen( text );
-        do { fputc ( text[pt++] , fp); } while (--len); pt = 0;
-      }
+    cutime = time(NULL); /* time right NOW */
+    gmt = gmtime(&cutime);
+    strftime(time_str, 24, "%Y/%m/%d %H:%M:%S", gmt);
+    snprintf( text, 128, "# DATE/TIME: %s\n", time_str );
+    STRING_ADD( header, text );
+  }
+
+  snprintf( text, 128, "# COLORSPACE: %s\n", colourspacename ?
+            colourspacename : "--" );
+  STRING_ADD( header, text );
+
+  if(byteps == 1)
+    snprintf( bytes, 48, "255" );
+  else
+  if(byteps == 2)
+    snprintf( bytes, 48, "65535" );
+  else
+  if (byteps == 4 || byteps == 8) 
+  {
+    if(oyBigEndian())
+      snprintf( bytes, 48, "1.0" );
+    else
+      snprintf( bytes, 48, "-1.0" );
+  }
+  else
+  {
+    bytes[0] = 0;
+    oyMessageFunc_p( oyMSG_WARN, (oyStruct_s*)image,
+         OY_DBG_FORMAT_ " byteps: %d",
+         OY_DBG_ARGS_, byteps );
+  }
+
+
+  if(alpha)
+  {
+    const char *tupl = "RGB_ALPHA";
+
+    if(channels == 2)
+      tupl = "GRAYSCALE_ALPHA";
+    snprintf( text, 128, "WIDTH %d\nHEIGHT %d\nDEPTH %d\nMAXVAL "
+              "%s\nTUPLTYPE %s\nENDHDR\n",
+              image->width, image->height,
+              channels, bytes, tupl );
+    STRING_ADD( header, text );
+  }
+  else
+  {
+    snprintf( text, 128, "%d %d\n%s\n", image->width, image->height, bytes );
+    STRING_ADD( header, text );
+  }
+
+  len = strlen( header );
+  error = fwrite( header, 1, len, fp ) != len;
+  oyFree_m_( header );
+
+  return error;
+}
+
+/**
+ *  @internal
+ *  @func    oyImage_PpmWriteOpen
+ *  @memberof oyImage_s
+ *  @brief   create a PPM, PAM or PFM file and write its header
+ *
+ *  Pixels can follow strip by strip with oyPpmWriteLines().
+ *
+ *  @param[in]     image               the image
+ *  @param[in]     file_name           a writeable file name, The file can 
+ *                                     contain "%d" to include the image ID.
+ *  @param[in]     free_text           A text to include as comment.
+ *  @return                            the open file or zero
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/09/21 (Oyranos: 0.3.2)
+ *  @date    2011/09/21
+ */
+FILE *       oyImage_PpmWriteOpen    ( oyImage_s         * image,
+                                       const char        * file_name,
+                                       const char        * free_text )
+{
+  int error = !file_name;
+  FILE * fp = 0;
+  char * filename = 0;
+  oyImage_s * s = image;
 
-      n = image->width * channels;
-      if(byteps == 8)
-        u8 = (uint8_t*) &flt;
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 0 )
+
+  if(!error)
+    oyAllocHelper_m_( filename, char, strlen(file_name)+80, 0, return 0 );
+
+  if(!error)
+  {
+    if(strstr(file_name, "%d"))
+      sprintf( filename, file_name, oyStruct_GetId( (oyStruct_s*)s ) );
+    else
+      strcpy(filename,file_name);
+  }
+
+  if(filename)
+    fp = fopen( filename, "wb" );
 
-      for( k = 0; k < image->height; ++k)
+  if(fp && oyImage_PpmWriteHeader( image, fp, free_text ))
+  {
+    fclose( fp );
+    fp = 0;
+  }
+
+  oyFree_m_( filename );
+
+  return fp;
+}
+
+/**
+ *  @internal
+ *  @func    oyImage_PpmWrite
+ *  @memberof oyArray2d_s
+ *  @brief   implement oyCMMFilter_GetNext_f()
+ *
+ *  The pixels are written in strips of lines as obtained from
+ *  oyImage_s::getLine.
+ *
+ *  @param[in]     image               the image
+ *  @param[in]     file_name           a writeable file name, The file can 
+ *                                     contain "%d" to include the image ID.
+ *  @param[in]     free_text           A text to include as comment.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2008/10/07 (Oyranos: 0.1.8)
+ *  @date    2011/09/21
+ */
+int          oyImage_PpmWrite        ( oyImage_s         * image,
+                                       const char        * file_name,
+                                       const char        * free_text )
+{
+  int error = 0;
+  FILE * fp = 0;
+  oyImage_s * s = image;
+
+  oyCheckType__m( oyOBJECT_IMAGE_S, return 1 )
+
+  fp = oyImage_PpmWriteOpen( image, file_name, free_text );
+  error = !fp;
+
+  if(fp)
+  {
+      int channels = oyToChannels_m( image->layout_[0] );
+      oyDATATYPE_e data_type = oyToDataType_m( image->layout_[0] );
+      int byteps = oySizeofDatatype( data_type );
+      int n = image->width * channels;
+      int  k, l;
+      uint8_t * out_values = 0;
+      oyPointer strip[64];
+
+      for( k = 0; k < image->height && !error; ++k)
       {
         int height = 0,
             is_allocated = 0;
         out_values = image->getLine( image, k, &height, -1, 
                                             &is_allocated );
-        len = n * byteps;
-
-        for( l = 0; l < height; ++l )
+        if(!out_values)
         {
-          if(byteps == 8)
-          {
-            dbls = (double*)out_values;
-            for(i = 0; i < n; ++i)
-            {
-              flt = dbls[l * len + i];
-              for(j = 0; j < 4; ++j)
-                fputc ( u8[j], fp);
-            }
-          } else 
-          for(i = 0; i < len; ++i)
-          {
-            if(!oyBigEndian() && (byteps == 2))
-            { if(i%2)
-                fputc ( out_values[l * len + i - 1] , fp);
-              else
-                fputc ( out_values[l * len + i + 1] , fp);
-            } else
-              fputc ( out_values[l * len + i] , fp);
-          }
+          error = 1;
+          break;
         }
 
+        if(height < 1)
+          height = 1;
+        if(height > 64)
+          height = 64;
+        if(k + height > image->height)
+          height = image->height - k;
+
+        for( l = 0; l < height; ++l )
+          strip[l] = &out_values[l * n * byteps];
+
+        error = oyPpmWriteLines( fp, strip, height, n, data_type );
+        k += height - 1;
+
         if(is_allocated)
           image->oy_->deallocateFunc_(out_values);
       }
@@ -7243,282 +8523,6 @@ char *         oyFilterRegistrationToText (
 }
 
 
-#if USE_OLD_STRING_API
-/** Function oyFilterRegistrationMatch
- *  @brief   analyse registration string and compare with a given pattern
- *
- *  The rules are described in the @ref module_api overview.
- *  The function is intensively used.
- *
- *  @param         registration        registration string to analise
- *  @param         pattern             pattern or key name to compare with
- *  @param         api_number          select object type
- *
- *  @version Oyranos: 0.1.10
- *  @since   2008/06/26 (Oyranos: 0.1.8)
- *  @date    2009/04/13
- */
-int    oyFilterRegistrationMatch     ( const char        * registration,
-                                       const char        * pattern,
-                                       oyOBJECT_e          api_number )
-{
-  char ** reg_texts = 0;
-  int     reg_texts_n = 0;
-  char ** regc_texts = 0;
-  int     regc_texts_n = 0;
-  int     regc_texts_pos[3] = {0,0,0};
-  char  * reg_text = 0;
-  char ** p_texts = 0;
-  int     p_texts_n = 0;
-  char ** pc_texts = 0;
-  int     pc_texts_n = 0;
-  char  * pc_text = 0;
-  int     match = 0, match_tmp = 0, i,j,k, api_num = oyOBJECT_NONE, pc_api_num;
-  char    pc_match_type = '+';
-  char  * key_tmp = 0,
-        * max_segment = 0;
- 
-  if(registration && pattern)
-  {
-    api_num = oyCMMapiNumberToChar(api_number);
-    match_tmp = 1;
-    reg_texts = oyStringSplit_( registration, OY_SLASH_C, &reg_texts_n,
-                                oyAllocateFunc_);
-    p_texts = oyStringSplit_( pattern, OY_SLASH_C, &p_texts_n, oyAllocateFunc_);
-
-    for( i = 0; i < reg_texts_n && i < p_texts_n; ++i)
-    {
-      regc_texts_n = 0;
-
-      /* allow a key only in *pattern to filter from *registration */
-      if(p_texts_n == 1)
-      {
-        key_tmp = oyFilterRegistrationToText( registration, oyFILTER_REG_MAX,0);
-        regc_texts = oyStringSplit_( key_tmp,'.',&regc_texts_n,
-                                     oyAllocateFunc_);
-        /*if(oyStringSegment_(key_tmp, '.', &regc_texts_n, &regc_texts_pos,
-                            &max_segment ))
-          return 0;*/
-        oyFree_m_( key_tmp );
-        pc_texts = oyStringSplit_( p_texts[i],'.',&pc_texts_n, oyAllocateFunc_);
-        i = reg_texts_n;
-      } else
-      /* level by level comparision */
-      {
-        regc_texts = oyStringSplit_( reg_texts[i],'.',&regc_texts_n,
-                                     oyAllocateFunc_);
-        pc_texts = oyStringSplit_( p_texts[i],'.',&pc_texts_n, oyAllocateFunc_);
-      }
-
-      if(match_tmp && pc_texts_n && regc_texts_n)
-      {
-        for( j = 0; j < pc_texts_n; ++j)
-        {
-          match_tmp = 0;
-          pc_api_num = 0;
-          pc_match_type = '+';
-          pc_text = pc_texts[j];
-
-          if(pc_text[0] == '4' ||
-             pc_text[0] == '5' ||
-             pc_text[0] == '6' ||
-             pc_text[0] == '7')
-          {
-            pc_api_num = pc_text[0];
-            ++ pc_text;
-            pc_match_type = pc_text[0];
-            ++ pc_text;
-          }
-
-          for( k = 0; k < regc_texts_n; ++k )
-          {
-            reg_text = regc_texts[k];
-            if((!pc_api_num || (pc_api_num && api_num == pc_api_num)) &&
-               oyStrcmp_( reg_text, pc_text ) == 0)
-            {
-              if(pc_match_type == '+' ||
-                 pc_match_type == '_')
-              {
-                ++ match;
-                match_tmp = 1;
-              } else /* if(pc_match_type == '-') */
-                goto clean_up;
-            }
-          }
-
-          if(pc_match_type == '+' && !match_tmp)
-            goto clean_up;
-        }
-      }
-
-      oyStringListRelease_( &pc_texts, pc_texts_n, oyDeAllocateFunc_ );
-      oyStringListRelease_( &regc_texts, regc_texts_n, oyDeAllocateFunc_ );
-    }
-    oyStringListRelease_( &reg_texts, reg_texts_n, oyDeAllocateFunc_ );
-    oyStringListRelease_( &p_texts, p_texts_n, oyDeAllocateFunc_ );
-  }
-
-  if(match_tmp == 1 && !match)
-    match = 1;
-
-  return match;
-
-
-  clean_up:
-    oyStringListRelease_( &pc_texts, pc_texts_n, oyDeAllocateFunc_ );
-    oyStringListRelease_( &regc_texts, regc_texts_n, oyDeAllocateFunc_ );
-    oyStringListRelease_( &reg_texts, reg_texts_n, oyDeAllocateFunc_ );
-    oyStringListRelease_( &p_texts, p_texts_n, oyDeAllocateFunc_ );
-  return 0;
-}
-#else
-/** Function oyFilterRegistrationMatch 
- *  @brief   analyse registration string and compare with a given pattern
- *
- *  The rules are described in the @ref module_api overview.
- *  The function is intensively used.
- *
- *  @param         registration        registration string to analise
- *  @param         pattern             pattern or key name to compare with
- *  @param         api_number          select object type
- *  @return                            match, useable for ranking
- *
- *  @version Oyranos: 0.1.10
- *  @since   2008/06/26 (Oyranos: 0.1.8)
- *  @date    2009/07/16
- */
-int    oyFilterRegistrationMatch     ( const char        * registration,
-                                       const char        * pattern,
-                                       oyOBJECT_e          api_number )
-{
-  char  * reg_text = 0;
-  int     reg_n = 0;
-  int     reg_len = 0;
-  char  * regc_text = 0;
-  int     regc_n = 0;
-  int     regc_len = 0;
-  char  * p_text = 0;
-  int     p_n = 0;
-  int     p_len = 0;
-  char  * pc_text = 0;
-  int     pc_n = 0;
-  int     pc_len = 0;
-  int     match = 0, match_tmp = 0, i,j,k, api_num = oyOBJECT_NONE, pc_api_num;
-  char    pc_match_type = '+';
- 
-  if(registration && pattern)
-  {
-    api_num = oyCMMapiNumberToChar(api_number);
-    match_tmp = 1;
-    reg_n = oyStringSegments_(registration, OY_SLASH_C);
-    p_n = oyStringSegments_(pattern, OY_SLASH_C);
-
-    for( i = 0; i < reg_n && i < p_n; ++i)
-    {
-      regc_n = 0;
-
-      /* allow a key only in *pattern to filter from *registration */
-      if(p_n == 1)
-      {
-        reg_text = oyFilterRegistrationToSTextField( registration,
-                                                    oyFILTER_REG_MAX, &reg_len);
-        regc_n = oyStringSegmentsN_( reg_text, reg_len, '.' );
-        /*if(oyStringSegment_(key_tmp, '.', &regc_n, &regc_texts_pos,
-                              &max_segment ))
-          return 0;*/
-        p_text = oyStringSegment_( (char*)pattern, OY_SLASH_C, i, &p_len );
-        pc_n = oyStringSegmentsN_( p_text, p_len, '.' );
-        i = reg_n;
-      } else
-      /* level by level comparision */
-      {
-        reg_text = oyStringSegment_( (char*)registration,
-                                        OY_SLASH_C, i, &reg_len );
-        regc_n = oyStringSegmentsN_( reg_text, reg_len, '.' );
-        p_text = oyStringSegment_( (char*)pattern, OY_SLASH_C, i, &p_len );
-        pc_n = oyStringSegmentsN_( p_text, p_len, '.' );
-      }
-
-      if(match_tmp && pc_n && regc_n)
-      {
-        for( j = 0; j < pc_n; ++j)
-        {
-          match_tmp = 0;
-          pc_api_num = 0;
-          pc_match_type = '+';
-          pc_text = oyStringSegmentN_( p_text, p_len, '.', j, &pc_len );
-
-          if(pc_text[0] == '4' ||
-             pc_text[0] == '5' ||
-             pc_text[0] == '6' ||
-             pc_text[0] == '7' ||
-             pc_text[0] == '8' ||
-             pc_text[0] == '9')
-          {
-            pc_api_num = pc_text[0];
-            ++ pc_text;
-            pc_match_type = pc_text[0];
-            ++ pc_text;
-            pc_len -= 2;
-          } else
-          if(pc_text[0] == '_' ||
-             pc_text[0] == '-')
-          {
-            pc_match_type = pc_text[0];
-            ++ pc_text;
-            -- pc_len;
-          }
-
-          for( k = 0; k < regc_n; ++k )
-          {
-            regc_text = oyStringSegmentN_( reg_text, reg_len, '.', k,
-                                              &regc_len );
-            if(regc_text[0] == '4' ||
-               regc_text[0] == '5' ||
-               regc_text[0] == '6' ||
-               regc_text[0] == '7' ||
-               regc_text[0] == '8' ||
-               regc_text[0] == '9')
-            {
-              ++ regc_text;
-              ++ regc_text;
-              regc_len -= 2;
-            } else
-            if(regc_text[0] == '_' ||
-               regc_text[0] == '-')
-            {
-              ++ regc_text;
-              -- regc_len;
-            }
-
-            if((!pc_api_num || (pc_api_num && api_num == pc_api_num)) &&
-               memcmp( regc_text, pc_text, OY_MIN(regc_len,pc_len) ) == 0 &&
-	       (regc_len == pc_len || !regc_len || !pc_len))
-            {
-              if(pc_match_type == '+' ||
-                 pc_match_type == '_')
-              {
-                ++ match;
-                match_tmp = 1;
-              } else /* if(pc_match_type == '-') */
-                return 0;
-            }
-          }
-
-          if(pc_match_type == '+' && !match_tmp)
-            return 0;
-        }
-      }
-    }
-  }
-
-  if(match_tmp == 1 && !match)
-    match = 1;
-
-  return match;
-}
-#endif
-
 /** Function oyFilterRegistrationMatchKey
  *  @brief   compare two registration strings, skip key attributes
  *
@@ -12065,6 +13069,7 @@ int      oyActivateMonitorProfiles   ( const char        * display_name )
 /** @} *//* monitor_api */
 
 extern oyStructList_s_ * oy_profile_s_file_cache_;
+extern oyStructList_s * oy_options_text_cache_;
 
 /** @internal
  *
@@ -12078,4 +13083,5 @@ void     oyAlphaFinish_              ( int                 unused )
   oyStructList_Release( &oy_meta_module_cache_ );
   oyStructList_Release( &oy_cmm_cache_ );
   oyStructList_Release_( &oy_profile_s_file_cache_ );
+  oyStructList_Release( &oy_options_text_cache_ );
 }
@@ -75,7 +75,12 @@ typedef oyPointer (*oyImage_GetLine_f) ( oyImage_s       * image,
                                          int             * height,
                                          int               channel,
                                          int             * is_allocated );
-/** param[out]     is_allocated          are the tiles always newly allocated */
+/** The tile position is counted in oyImage_s::tile_width and
+ *  oyImage_s::tile_height units. The returned array holds the tile rows.
+ *  A allocated tile is one block of the image allocator, containing the row
+ *  array and the rows, and is released with the image deallocator.
+ *
+ *  param[out]     is_allocated          are the tiles always newly allocated */
 typedef oyPointer*(*oyImage_GetTile_f) ( oyImage_s       * image,
                                          int               tile_x,
                                          int               tile_y,
@@ -293,22 +298,6 @@ OYAPI const char ** OYEXPORT
            oyConfDomain_GetTexts     ( oyConfDomain_s    * obj );
 
 
-/** @typedef oyIO_t
-    parametric type as shorthand for IO flags \n
-
-    should fit into a 32bit type, usual unsigned int or uint32_t \n
-
-    ------ W R \n
-
-    R  no cache read \n
-    W  no cache write \n
-
- */
-#define OY_NO_CACHE_READ            0x01        /** read not from cache */
-#define OY_NO_CACHE_WRITE           0x02        /** write not from cache */
-/* decode */
-#define oyToNoCacheRead_m(r)        ((r)&1)
-#define oyToNoCacheWrite_m(w)       (((w) >> 1)&1)
 #if 0
 OYAPI oyPointer OYEXPORT
                    oyProfile_Align   ( oyProfile_s     * profile,
@@ -649,6 +638,25 @@ oyImage_s *    oyImage_Create        ( int                 width,
                                        oyPixel_t           pixel_layout,
                                        oyProfile_s       * profile,
                                        oyObject_s          object);
+oyImage_s *    oyImage_CreateFromData( int                 width,
+                                       int                 height,
+                                       oyPixel_t           pixel_layout,
+                                       oyProfile_s       * profile,
+                                       oyStruct_s       ** pixel_data,
+                                       oyImage_GetPoint_f  getPoint,
+                                       oyImage_GetLine_f   getLine,
+                                       oyImage_GetTile_f   getTile,
+                                       oyImage_SetPoint_f  setPoint,
+                                       oyImage_SetLine_f   setLine,
+                                       oyImage_SetTile_f   setTile,
+                                       oyObject_s          object );
+oyImage_s *    oyImage_CreateMapped  ( const char        * filename,
+                                       int                 width,
+                                       int                 height,
+                                       const char        * header,
+                                       oyPixel_t           pixel_layout,
+                                       oyProfile_s       * profile,
+                                       oyObject_s          object );
 oyImage_s *    oyImage_CreateForDisplay ( int              width,
                                        int                 height, 
                                        oyPointer           channels,
@@ -689,6 +697,36 @@ int            oyImage_ReadArray     ( oyImage_s         * image,
 oyPixel_t      oyImage_PixelLayoutGet( oyImage_s         * image );
 oyProfile_s *  oyImage_ProfileGet    ( oyImage_s         * image );
 oyOptions_s *  oyImage_TagsGet       ( oyImage_s         * image );
+int            oyImage_TagsClear     ( oyImage_s         * image,
+                                       const char        * registration );
+int            oyImage_IsPremultiplied(oyImage_s         * image );
+int            oyImage_PyramidLevelSet(oyImage_s         * image,
+                                       const char        * hash_text,
+                                       int                 level,
+                                       oyImage_s         * level_image );
+oyImage_s *    oyImage_PyramidLevelGet(oyImage_s         * image,
+                                       const char        * hash_text,
+                                       int                 level );
+int            oyImage_PyramidClear  ( oyImage_s         * image );
+
+int            oyPixelAlphaCopy      ( const oyPointer     src,
+                                       oyPixel_t           src_layout,
+                                       int                 src_colours,
+                                       oyPointer           dst,
+                                       oyPixel_t           dst_layout,
+                                       int                 dst_colours,
+                                       int                 pixel_n );
+int            oyPixelAlphaMultiply  ( oyPointer           line,
+                                       oyPixel_t           layout,
+                                       int                 colours,
+                                       int                 pixel_n,
+                                       int                 unpremultiply );
+int            oyPixelDither16To8    ( const uint16_t    * src,
+                                       uint8_t           * dst,
+                                       int                 channels,
+                                       int                 pixel_n,
+                                       int                 x,
+                                       int                 y );
 
 
 
@@ -22,6 +22,8 @@
 #include "oyranos_cmm.h"
 #include "oyObject_s_.h"
 
+#include <stdio.h>  /* FILE */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -86,6 +88,17 @@ int    oyOptions_SetRegistrationTextKey_(
 int          oyImage_PpmWrite        ( oyImage_s         * image_output,
                                        const char        * file_name,
                                        const char        * free_text );
+FILE *       oyImage_PpmWriteOpen    ( oyImage_s         * image,
+                                       const char        * file_name,
+                                       const char        * free_text );
+int          oyImage_PpmWriteHeader  ( oyImage_s         * image,
+                                       FILE              * fp,
+                                       const char        * free_text );
+int          oyPpmWriteLines         ( FILE              * fp,
+                                       oyPointer         * lines,
+                                       int                 line_n,
+                                       int                 samples,
+                                       oyDATATYPE_e        data_type );
 
 const char *   oyContextCollectData_ ( oyStruct_s        * s,
                                        oyOptions_s       * opts,
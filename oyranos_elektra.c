@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <kdb.h>
 
 #include "config.h"
@@ -39,7 +40,11 @@
 #include "oyranos_sentinel.h"
 #include "oyranos_string.h"
 #include "oyranos_xml.h"
+#include "lookup3.h" /* oy_hashlittle */
 
+#if defined(HAVE_POSIX)
+#include <pthread.h>
+#endif
 
 #ifdef HAVE_POSIX
 #include <unistd.h> /* geteuid() */
@@ -113,7 +118,8 @@ void oyClose_() { /*kdbClose( &oy_handle_ );*/ }
 /* @todo make oyOpen unnecessary */
 void oyOpen  (void) { oyOpen_(); }
 void oyClose (void) { oyClose_(); }
-void oyCloseReal__() { kdbClose( oy_handle_ );
+void oyCloseReal__() { oyKeyCacheReset_();
+                       kdbClose( oy_handle_ );
                        oy_handle_ = 0;
                        oyranos_init = 0; }
 
@@ -395,6 +401,7 @@ oyAddKey_valueComment_ (const char* keyName,
   if(rc < 0)
     oyMessageFunc_p( oyMSG_WARN, 0, OY_DBG_FORMAT_ "code:%d %s name:%s",
                      OY_DBG_ARGS_, rc, kdbStrError(rc), name);
+  oyKeyCacheReset_();
   oyClose_();
   keyDel( key );
 
@@ -639,6 +646,7 @@ oySetProfile_      (const char* name, oyPROFILE_e type, const char* comment)
               if(!oy_handle_)
                 return 1;
               kdbRemove ( oy_handle_, value );
+              oyKeyCacheReset_();
               break;
             }
           }
@@ -720,6 +728,275 @@ oyPointer  oyGetKeyBinary__          ( const char        * full_key_name,
   return ptr;
 }
 
+/** @internal
+ *  a cached Elektra key, the name follows the header in the same block
+ *
+ *  Entries with oyKEY_CACHE_DIR_ mark a key directory as read. A missing key
+ *  below such a directory needs no further Elektra lookup.
+ */
+typedef struct oyKeyCache_s_ oyKeyCache_s_;
+struct oyKeyCache_s_ {
+  oyKeyCache_s_      * next;           /**< next in the hash bucket */
+  uint32_t             hash;           /**< oy_hashlittle() of name and type */
+  int                  type;           /**< oyKEY_CACHE_VALUE_ or _DIR_ */
+  char               * value;          /**< the string value or NULL */
+  char                 name[1];        /**< key name without user/ or system/ */
+};
+#define oyKEY_CACHE_VALUE_ 0
+#define oyKEY_CACHE_DIR_   1
+
+/* seconds a snapshot is served before it is read again from Elektra, so
+ * changes from other processes become visible */
+#define OY_KEY_CACHE_TTL_  2
+
+static oyKeyCache_s_ ** oy_key_cache_ = NULL;
+static uint32_t oy_key_cache_size_ = 0;
+static uint32_t oy_key_cache_n_ = 0;
+static time_t oy_key_cache_time_ = 0;  /* first read into the snapshot */
+#if defined(HAVE_POSIX)
+static pthread_mutex_t oy_key_cache_mutex_ = PTHREAD_MUTEX_INITIALIZER;
+#define oyKeyCacheLock_m() \
+        pthread_mutex_lock( &oy_key_cache_mutex_ )
+#define oyKeyCacheUnLock_m() \
+        pthread_mutex_unlock( &oy_key_cache_mutex_ )
+#else
+#define oyKeyCacheLock_m()
+#define oyKeyCacheUnLock_m()
+#endif
+
+static uint32_t    oyKeyCacheHash_   ( const char        * name,
+                                       int                 len,
+                                       int                 type )
+{
+  return oy_hashlittle( name, len, type );
+}
+
+/* needs the lock */
+static oyKeyCache_s_ * oyKeyCacheFind_(const char        * name,
+                                       int                 len,
+                                       int                 type )
+{
+  uint32_t hash = oyKeyCacheHash_( name, len, type );
+  oyKeyCache_s_ * e = 0;
+
+  if(oy_key_cache_size_)
+    for(e = oy_key_cache_[hash & (oy_key_cache_size_ - 1)]; e; e = e->next)
+      if(e->hash == hash && e->type == type &&
+         strncmp( e->name, name, len ) == 0 && e->name[len] == 0)
+        break;
+
+  return e;
+}
+
+/* double the bucket count; needs the lock */
+static int         oyKeyCacheGrow_   ( void )
+{
+  uint32_t size = oy_key_cache_size_ ? oy_key_cache_size_ * 2 : 256,
+           i;
+  oyKeyCache_s_ ** table = 0, * e, * next;
+
+  oyAllocHelper_m_( table, oyKeyCache_s_*, size, oyAllocateFunc_, return 1 );
+
+  for(i = 0; i < oy_key_cache_size_; ++i)
+    for(e = oy_key_cache_[i]; e; e = next)
+    {
+      next = e->next;
+      e->next = table[e->hash & (size - 1)];
+      table[e->hash & (size - 1)] = e;
+    }
+
+  if(oy_key_cache_)
+    oyDeAllocateFunc_( oy_key_cache_ );
+  oy_key_cache_ = table;
+  oy_key_cache_size_ = size;
+
+  return 0;
+}
+
+/* find or add a entry; needs the lock */
+static oyKeyCache_s_ * oyKeyCacheAdd_( const char        * name,
+                                       int                 len,
+                                       int                 type )
+{
+  oyKeyCache_s_ * e = oyKeyCacheFind_( name, len, type );
+
+  if(e)
+    return e;
+
+  if(oy_key_cache_n_ >= oy_key_cache_size_ && oyKeyCacheGrow_())
+    return 0;
+
+  e = (oyKeyCache_s_*) oyAllocateFunc_( sizeof(oyKeyCache_s_) + len );
+  if(!e)
+    return 0;
+
+  e->hash = oyKeyCacheHash_( name, len, type );
+  e->type = type;
+  e->value = 0;
+  memcpy( e->name, name, len );
+  e->name[len] = 0;
+  e->next = oy_key_cache_[e->hash & (oy_key_cache_size_ - 1)];
+  oy_key_cache_[e->hash & (oy_key_cache_size_ - 1)] = e;
+  ++oy_key_cache_n_;
+
+  return e;
+}
+
+/* read all string keys of one directory in one go; needs the lock
+ *
+ * The user value wins. A system value fills only empty or missing user keys.
+ */
+static int         oyKeyCacheReadDir_( const char        * dir,
+                                       int                 len )
+{
+  const char * base[2] = { OY_USER, OY_SYS };
+  char * dir_name = 0,
+       * key_name = 0,
+       * value = 0;
+  KeySet * ks = 0;
+  Key * current = 0;
+  oyKeyCache_s_ * e = 0;
+  int i, rc = 0, error = !oy_handle_;
+
+  if(error)
+    return error;
+
+  oyAllocHelper_m_( dir_name, char, MAX_PATH, 0, return 1 );
+  oyAllocHelper_m_( key_name, char, MAX_PATH, 0, return 1 );
+  oyAllocHelper_m_( value, char, MAX_PATH, 0, return 1 );
+
+  for(i = 0; i < 2; ++i)
+  {
+    int base_len = oyStrlen_( base[i] );
+
+    snprintf( dir_name, MAX_PATH, "%s%.*s", base[i], len, dir );
+    ks = ksNew(0);
+    rc = kdbGetChildKeys( oy_handle_, dir_name, ks, KDB_O_SORT );
+    if(rc > 0)
+      WARNc1_S("kdbGetChildKeys returned with %d", rc);
+
+    FOR_EACH_IN_KDBKEYSET( current, ks )
+    {
+      if(!keyIsString( current ))
+        continue;
+
+      keyGetName( current, key_name, MAX_PATH );
+      if(memcmp( key_name, base[i], base_len ) != 0)
+        continue;
+
+      value[0] = 0;
+      keyGetString( current, value, MAX_PATH );
+
+      e = oyKeyCacheAdd_( &key_name[base_len],
+                          oyStrlen_( &key_name[base_len] ), oyKEY_CACHE_VALUE_ );
+      if(e && (i == 0 || !e->value || !e->value[0]))
+      {
+        if(e->value)
+          oyDeAllocateFunc_( e->value );
+        e->value = oyStringCopy_( value, oyAllocateFunc_ );
+      }
+    }
+    ksDel( ks ); ks = 0;
+  }
+
+  if(!oyKeyCacheAdd_( dir, len, oyKEY_CACHE_DIR_ ))
+    error = 1;
+
+  oyFree_m_( dir_name );
+  oyFree_m_( key_name );
+  oyFree_m_( value );
+
+  return error;
+}
+
+/* read a single key without a directory part; needs the lock */
+static int         oyKeyCacheReadKey_( const char        * key_name )
+{
+  const char * base[2] = { OY_USER, OY_SYS };
+  char * full_key_name = 0,
+       * value = 0;
+  Key * key = 0;
+  oyKeyCache_s_ * e = 0;
+  int i;
+
+  if(!oy_handle_)
+    return 1;
+
+  e = oyKeyCacheAdd_( key_name, oyStrlen_(key_name), oyKEY_CACHE_VALUE_ );
+  if(!e)
+    return 1;
+
+  oyAllocHelper_m_( full_key_name, char, MAX_PATH, 0, return 1 );
+  oyAllocHelper_m_( value, char, MAX_PATH, 0, return 1 );
+
+  for(i = 0; i < 2 && (!e->value || !e->value[0]); ++i)
+  {
+    sprintf( full_key_name, "%s%s", base[i], key_name );
+    key = keyNew( full_key_name, KEY_END );
+    kdbGetKey( oy_handle_, key );
+    value[0] = 0;
+    if(keyIsString( key ))
+      keyGetString( key, value, MAX_PATH );
+    keyDel( key ); key = 0;
+
+    if(value[0] || !e->value)
+    {
+      if(e->value)
+        oyDeAllocateFunc_( e->value );
+      e->value = oyStringCopy_( value, oyAllocateFunc_ );
+    }
+  }
+
+  oyFree_m_( full_key_name );
+  oyFree_m_( value );
+
+  return 0;
+}
+
+/* drop the snapshot; needs the lock */
+static void        oyKeyCacheClear_  ( void )
+{
+  uint32_t i;
+  oyKeyCache_s_ * e, * next;
+
+  for(i = 0; i < oy_key_cache_size_; ++i)
+    for(e = oy_key_cache_[i]; e; e = next)
+    {
+      next = e->next;
+      if(e->value)
+        oyDeAllocateFunc_( e->value );
+      oyDeAllocateFunc_( e );
+    }
+
+  if(oy_key_cache_)
+    oyDeAllocateFunc_( oy_key_cache_ );
+  oy_key_cache_ = 0;
+  oy_key_cache_size_ = 0;
+  oy_key_cache_n_ = 0;
+  oy_key_cache_time_ = 0;
+}
+
+/** @internal
+ *  @brief   reload the key values
+ *
+ *  Drops the in memory snapshot of oyGetKeyString_(). The next request
+ *  reads again from Elektra. A snapshot is dropped as well, when it is
+ *  older than OY_KEY_CACHE_TTL_ seconds. Call this to see changes of
+ *  other processes at once. Oyranos calls it after each own write and from
+ *  oyCloseReal__(), which is reached through oyExportReset_(EXPORT_SETTING)
+ *  on changed settings.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/27 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+void               oyKeyCacheReset_  ( void )
+{
+  oyKeyCacheLock_m();
+  oyKeyCacheClear_();
+  oyKeyCacheUnLock_m();
+}
+
 /* public API implementation */
 
 oyPointer  oyGetKeyBinary_           ( const char        * key_name,
@@ -765,68 +1042,68 @@ oyPointer  oyGetKeyBinary_           ( const char        * key_name,
  *
  *  1. ask user
  *  2. if user has no setting ask system
+ *
+ *  The values are served from a in memory snapshot. The first request to a
+ *  key directory reads all of its keys in one Elektra call. The snapshot is
+ *  read again after OY_KEY_CACHE_TTL_ seconds or after oyKeyCacheReset_().
+ *
+ *  @version Oyranos: 0.3.2
+ *  @date    2011/11/28
+ *  @since   2004/11/25 (Oyranos: 0.1.x)
  */
 char*
 oyGetKeyString_ ( const char       *key_name,
                  oyAlloc_f         allocate_func )
 {
   char* name = 0;
-  char* full_key_name = 0;
-  int rc = 0;
-  Key * key = 0;
-  int success = 0;
+  const char * dir = 0;
+  oyKeyCache_s_ * e = 0;
+  int len, error = 0;
+  time_t now;
 
   if( !key_name || strlen( key_name ) > MAX_PATH-1 )
   { WARNc_S("wrong string format given");
-    goto clean3;
+    return 0;
   }
 
-  name = (char*) oyAllocateWrapFunc_( MAX_PATH, allocate_func );
-  full_key_name = (char*) oyAllocateFunc_ (MAX_PATH);
-
-  if( !name || !full_key_name )
-    goto clean3;
-
-  sprintf( full_key_name, "%s%s", OY_USER, key_name );
-
-  name[0] = 0;
   if(!oy_handle_)
-    goto clean3;
+    return 0;
 
-  /** check if the key is a binary one */
-  key = keyNew( full_key_name, KEY_END );
-  rc=kdbGetKey( oy_handle_, key );
-  success = keyIsString(key);
+  len = oyStrlen_( key_name );
+  dir = oyStrrchr_( key_name, OY_SLASH_C );
 
-  if(success)
-    rc = keyGetString ( key, name, MAX_PATH );
-  keyDel( key ); key = 0;
+  oyKeyCacheLock_m();
 
-  if( rc || !strlen( name ))
+  /* other processes may have changed the DB meanwhile */
+  now = time( NULL );
+  if(oy_key_cache_time_ && now - oy_key_cache_time_ >= OY_KEY_CACHE_TTL_)
+    oyKeyCacheClear_();
+  if(!oy_key_cache_time_)
+    oy_key_cache_time_ = now;
+
+  e = oyKeyCacheFind_( key_name, len, oyKEY_CACHE_VALUE_ );
+  if(!e && dir)
   {
-    sprintf( full_key_name, "%s%s", OY_SYS, key_name );
-    key = keyNew( full_key_name, KEY_END );
-    if(success)
-      rc = keyGetString( key, name, MAX_PATH );
-    keyDel( key ); key = 0;
+    if(!oyKeyCacheFind_( key_name, dir - key_name, oyKEY_CACHE_DIR_ ))
+    {
+      error = oyKeyCacheReadDir_( key_name, dir - key_name );
+      e = oyKeyCacheFind_( key_name, len, oyKEY_CACHE_VALUE_ );
+    }
+  } else if(!e)
+  {
+    error = oyKeyCacheReadKey_( key_name );
+    e = oyKeyCacheFind_( key_name, len, oyKEY_CACHE_VALUE_ );
   }
 
+  if(!error)
+    name = oyStringCopy_( e && e->value ? e->value : "",
+                          allocate_func ? allocate_func : oyAllocateFunc_ );
 
-  oyDeAllocateFunc_( full_key_name );
+  oyKeyCacheUnLock_m();
 
   DBG_PROG_S((name))
   DBG_PROG_ENDE
-  if(rc)
-    return name;
-  else
-    return 0;
-
-  clean3:
-  if(name)
-    oyDeAllocateFunc_(name);
-  if(full_key_name)
-    oyDeAllocateFunc_( full_key_name );
-  return 0;
+  return name;
 }
 
 
@@ -1194,6 +1471,7 @@ oyEraseDeviceProfile_              (const char* manufacturer,
        strstr(value, profile_name) != 0) {
       DBG_PROG_S((value))
       kdbRemove ( oy_handle_, value ); 
+      oyKeyCacheReset_();
       break;
     }
   }
@@ -1223,6 +1501,8 @@ int                oyEraseKey_       ( const char        * key_name )
   if(!oy_handle_)
     return 1;
 
+  oyKeyCacheReset_();
+
   oyAllocHelper_m_( name, char, MAX_PATH, 0, return 1 )
 
   oySprintf_( name, "%s%s", oySelectUserSys_(), key_name );
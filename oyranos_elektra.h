@@ -115,6 +115,8 @@ char*   oySearchEmptyKeyname_        ( const char        * keyParentName );
 char **            oyKeySetGetNames_ ( const char        * key_parent_name,
                                        int               * n );
 int                oyEraseKey_       ( const char        * key_name );
+/* reload the key values of oyGetKeyString_() */
+void               oyKeyCacheReset_  ( void );
 
 
 #ifdef __cplusplus
@@ -25,172 +25,136 @@
 
 #include <stdio.h>
 #include <string.h>
+#if defined(HAVE_POSIX)
+#include <pthread.h>
+#endif
 
 intptr_t oy_observe_pointer_ = 0;
 
 /* --- internal API definition --- */
-static int oy_alloc_count_ = 0;
-static int oy_allocs_count_ = 0;
 int oy_debug_memory = 0;
 int oy_debug_signals = 0;
 const char * oy_backtrace = 0;
-#ifndef NO_OPT
-#define OY_USE_ALLOCATE_FUNC_POOL_ 0
-#endif
 
-#if OY_USE_ALLOCATE_FUNC_POOL_
-#define OY_ALLOCATE_FUNC_POOL_CHUNK_ 128
-#define OY_ALLOCATE_FUNC_POOL_SIZE_ 64
-static int oy_allocate_func_pool_used_[OY_ALLOCATE_FUNC_POOL_SIZE_] = {
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 64
-            ,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0
-#endif
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 100
-       ,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0
-#endif
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 128
-,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0
-#endif
-};
-static size_t oy_allocate_func_pool_size_[OY_ALLOCATE_FUNC_POOL_SIZE_] = {
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 64
-            ,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0
-#endif
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 100
-       ,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0
-#endif
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 128
-,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0
-#endif
-};
-static oyPointer oy_allocate_func_pool_[OY_ALLOCATE_FUNC_POOL_SIZE_] = {
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 64
-            ,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0
-#endif
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 100
-       ,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0
-#endif
-#if OY_ALLOCATE_FUNC_POOL_SIZE_ >= 128
-,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0,0,0,
-0,0,0,0,0, 0,0,0
+/* Per thread size class cache for small blocks.
+ *
+ * Blocks stay ordinary malloc() blocks. So memory from oyAllocateFunc_() can
+ * be given to free() and malloc()ed memory to oyDeAllocateFunc_(). The size
+ * class of a released block is derived from malloc_usable_size(), which
+ * needs glibc. Other C libraries use plain malloc()/free().
+ */
+#if defined(__GLIBC__) && defined(HAVE_POSIX) && !defined(NO_OPT)
+#define OY_USE_ALLOCATE_FUNC_CACHE_ 1
+#include <malloc.h>   /* malloc_usable_size() */
+#include <pthread.h>
+#else
+#define OY_USE_ALLOCATE_FUNC_CACHE_ 0
 #endif
-};
+
+/* counters for OYRANOS_DEBUG_MEMORY */
+static oyAllocCounts_s oy_alloc_counts_ = {0,0,0,0,0,0};
+#if defined(__GNUC__)
+#define oyAllocCount_m( counter, n ) \
+  __sync_add_and_fetch( &oy_alloc_counts_.counter, n )
+#else
+#define oyAllocCount_m( counter, n ) oy_alloc_counts_.counter += n
 #endif
 
-/* internal memory handling */
-void* oyAllocateFunc_           (size_t        size)
+#if OY_USE_ALLOCATE_FUNC_CACHE_
+#define OY_ALLOC_CLASS_MIN_   16   /* smallest size class in byte */
+#define OY_ALLOC_CLASSES_N_   7    /* 16, 32, ... 1024 byte */
+#define OY_ALLOC_CLASS_MAX_   (OY_ALLOC_CLASS_MIN_ << (OY_ALLOC_CLASSES_N_-1))
+#define OY_ALLOC_CACHE_DEPTH_ 64   /* free blocks kept per class and thread */
+
+typedef struct {
+  void * free_[OY_ALLOC_CLASSES_N_];  /* single linked through the blocks */
+  int    count_[OY_ALLOC_CLASSES_N_];
+} oyAllocCache_s;
+
+static __thread oyAllocCache_s * oy_alloc_cache_ = 0;
+static pthread_key_t oy_alloc_cache_key_;
+static pthread_once_t oy_alloc_cache_once_ = PTHREAD_ONCE_INIT;
+
+static void  oyAllocCacheRelease_    ( void              * ptr )
 {
-  /* we have most often to work with text arrays, so initialise with 0 */
-  void *ptr = 0;
-#if OY_USE_ALLOCATE_FUNC_POOL_
-  int empty = -1;
+  oyAllocCache_s * cache = (oyAllocCache_s*) ptr;
   int i;
 
-  if(size <= OY_ALLOCATE_FUNC_POOL_CHUNK_ || size == 512 || size == 1024)
-  {
-    for(i = 0; i < OY_ALLOCATE_FUNC_POOL_SIZE_; ++i)
-      if(oy_allocate_func_pool_size_[i] == size &&
-         oy_allocate_func_pool_used_[i] <= 0)
-      {
-        ptr = oy_allocate_func_pool_[i];
-        oy_allocate_func_pool_used_[i] = 1;
-        if(oy_debug_memory)
-          printf( "%s:%d pos:%d size=%d reused\n", __FILE__,__LINE__,
-                  i, (int)size );
-        return ptr;
-      } else if(oy_allocate_func_pool_size_[i] == 0)
-      {
-        empty = i;
-        break;
-      }
+  if(!cache)
+    return;
 
-    if(ptr == 0)
+  for(i = 0; i < OY_ALLOC_CLASSES_N_; ++i)
+    while(cache->free_[i])
     {
-      if(empty >= 0)
-      {
-        oy_allocate_func_pool_size_[empty]= size <= OY_ALLOCATE_FUNC_POOL_CHUNK_
-                                            ? OY_ALLOCATE_FUNC_POOL_CHUNK_:size;
-        oy_allocate_func_pool_[empty] = ptr =
-                                   malloc( oy_allocate_func_pool_size_[empty] );
-        oy_allocate_func_pool_used_[empty] = 1;
-      } else
-      {
-        /* Clear the pool. Following strategies are possible at different cost:
-           a) free all unused and loose all used pointers
-           b) free all double occurences of unused pointers
-           c) observe all pointers for several times and remove unused ones
-         */
-
-        /* (a) */
-        int n = 0;
-        for(i = 0; i < OY_ALLOCATE_FUNC_POOL_SIZE_; ++i)
-          if(oy_allocate_func_pool_used_[i] <= 0)
-          {
-            free(oy_allocate_func_pool_[i]);
-            ++n;
-          }
-
-        if(oy_debug_memory)
-        {
-          oy_allocs_count_ -= n;
-          printf( "%s:%d %d pointers freed in pool clear => %d\n",
-                  __FILE__,__LINE__, n, oy_allocs_count_);
-        }
-
-        memset( oy_allocate_func_pool_, 0,
-                sizeof(oyPointer) * OY_ALLOCATE_FUNC_POOL_SIZE_);
-        memset( oy_allocate_func_pool_size_, 0,
-                sizeof(size_t) * OY_ALLOCATE_FUNC_POOL_SIZE_);
-        memset( oy_allocate_func_pool_used_, 0,
-                sizeof(int) * OY_ALLOCATE_FUNC_POOL_SIZE_);
-      }
+      void * block = cache->free_[i];
+      cache->free_[i] = *(void**)block;
+      free( block );
     }
+
+  if(cache == oy_alloc_cache_)
+    oy_alloc_cache_ = 0;
+  free( cache );
+}
+
+static void  oyAllocCacheKeyCreate_  ( void )
+{
+  pthread_key_create( &oy_alloc_cache_key_, oyAllocCacheRelease_ );
+}
+
+static oyAllocCache_s * oyAllocCacheGet_ ( void )
+{
+  if(!oy_alloc_cache_)
+  {
+    pthread_once( &oy_alloc_cache_once_, oyAllocCacheKeyCreate_ );
+    oy_alloc_cache_ = (oyAllocCache_s*) calloc( 1, sizeof(oyAllocCache_s) );
+    if(oy_alloc_cache_)
+      pthread_setspecific( oy_alloc_cache_key_, oy_alloc_cache_ );
   }
 
+  return oy_alloc_cache_;
+}
+
+/* smallest class which holds size */
+static int   oyAllocClassUp_         ( size_t              size )
+{
+  int c = 0;
+  size_t s = OY_ALLOC_CLASS_MIN_;
+  while(s < size) { s <<= 1; ++c; }
+  return c;
+}
 
+/* largest class which fits into size */
+static int   oyAllocClassDown_       ( size_t              size )
+{
+  int c = 0;
+  size_t s = OY_ALLOC_CLASS_MIN_ << 1;
+  while(s <= size && c < OY_ALLOC_CLASSES_N_-1) { s <<= 1; ++c; }
+  return c;
+}
+#endif /* OY_USE_ALLOCATE_FUNC_CACHE_ */
+
+
+/* internal memory handling */
+void* oyAllocateFunc_           (size_t        size)
+{
+  /* Blocks are not initialised. Use oyAllocHelper_m_() for zeroed memory. */
+  void *ptr = 0;
+#if OY_USE_ALLOCATE_FUNC_CACHE_
+  if(size <= OY_ALLOC_CLASS_MAX_)
+  {
+    int c = oyAllocClassUp_( size );
+    oyAllocCache_s * cache = oyAllocCacheGet_();
 
-  if(ptr == 0)
+    if(cache && cache->free_[c])
+    {
+      ptr = cache->free_[c];
+      cache->free_[c] = *(void**)ptr;
+      --cache->count_[c];
+      if(oy_debug_memory)
+        oyAllocCount_m( cache_hits, 1 );
+    } else
+      ptr = malloc( OY_ALLOC_CLASS_MIN_ << c );
+  } else
 #endif
     ptr = malloc (size);
 
@@ -200,10 +164,8 @@ void* oyAllocateFunc_           (size_t        size)
   }
     else if(oy_debug_memory != 0)
   {
-    oy_alloc_count_ += size;
-    printf( "%s:%d %d allocate %d  %d\n", __FILE__,__LINE__,
-            oy_allocs_count_, (int)size, oy_alloc_count_ );
-    ++oy_allocs_count_;
+    oyAllocCount_m( allocs, 1 );
+    oyAllocCount_m( bytes, (long)size );
   }
 
   return ptr;
@@ -211,32 +173,400 @@ void* oyAllocateFunc_           (size_t        size)
 
 void  oyDeAllocateFunc_           (void*       block)
 {
-#if OY_USE_ALLOCATE_FUNC_POOL_
+  if( !block ) {
+    WARNc_S( "Memory block is empty." )
+    return;
+  }
+
+  if(oy_debug_memory != 0)
+    oyAllocCount_m( deallocs, 1 );
+
+#if OY_USE_ALLOCATE_FUNC_CACHE_
+  {
+    size_t size = malloc_usable_size( block );
+
+    if(OY_ALLOC_CLASS_MIN_ <= size && size < OY_ALLOC_CLASS_MAX_ * 2)
+    {
+      int c = oyAllocClassDown_( size );
+      oyAllocCache_s * cache = oyAllocCacheGet_();
+
+      if(cache && cache->count_[c] < OY_ALLOC_CACHE_DEPTH_)
+      {
+        *(void**)block = cache->free_[c];
+        cache->free_[c] = block;
+        ++cache->count_[c];
+        return;
+      }
+    }
+  }
+#endif
+
+  free( block );
+}
+
+/** @internal
+ *  @brief   read the memory counters
+ *
+ *  The counters are updated while oy_debug_memory is set, e.g. through the
+ *  OYRANOS_DEBUG_MEMORY environment variable.
+ *
+ *  @param[out]    counts              the counters summed over all threads
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/05 (Oyranos: 0.3.2)
+ *  @date    2011/11/05
+ */
+void  oyAllocCountsGet_         (oyAllocCounts_s * counts)
+{
+  if(counts)
+    *counts = oy_alloc_counts_;
+}
+
+/** @internal
+ *  @brief   free the small block cache of the calling thread
+ *
+ *  Other threads free their cache on exit through the pthread key
+ *  destructor. The main thread normally does not reach that destructor, so
+ *  oyFinish_() calls this function. Later allocations start a new cache.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+void  oyAllocCacheFinish_       (void)
+{
+#if OY_USE_ALLOCATE_FUNC_CACHE_
+  if(oy_alloc_cache_)
+  {
+    pthread_setspecific( oy_alloc_cache_key_, 0 );
+    oyAllocCacheRelease_( oy_alloc_cache_ );
+  }
+#endif
+}
+
+/* Per thread arena for short living objects.
+ *
+ * A arena scope is opened with oyArenaBegin_() and closed with oyArenaEnd_().
+ * Inside a scope oyArenaAllocateFunc_() hands out memory by bumping a offset
+ * in large blocks and oyArenaDeAllocateFunc_() does nothing. Closing the
+ * outermost scope recycles everything at once. Both functions can be given
+ * to oyObject_NewWithAllocators(). Objects built on such a oyObject_s and
+ * their members live in the arena. They must be released before the scope
+ * ends and must not be cached or handed over to other threads.
+ *
+ * Blocks are aligned to OY_ARENA_UNIT_ and their units are looked up in a
+ * small hash, which finds the block of a pointer in constant time. Blocks
+ * are not given back before the thread exits. So a pointer of a closed
+ * scope, which is released late, still points into arena memory; it is
+ * recognised by the scope generation and ignored. Requests larger than the
+ * block size are served from the heap and freed individually.
+ */
+#define OY_ARENA_UNIT_        65536    /* block alignment, a power of two */
+#define OY_ARENA_ALIGN_       16
+
+typedef struct oyArenaBlock_s_ oyArenaBlock_s_;
+struct oyArenaBlock_s_ {
+  oyArenaBlock_s_ * next;
+  void            * raw;               /* allocation start */
+  size_t            size;              /* usable byte after the header */
+  size_t            used;
+  long              generation;        /* scope which uses the block */
+  double            align_;            /* keep data aligned */
+};
+
+typedef struct {
+  uintptr_t         unit;              /* address / OY_ARENA_UNIT_ */
+  oyArenaBlock_s_ * block;
+} oyArenaUnit_s_;
+
+typedef struct {
+  oyArenaBlock_s_ * blocks;            /* current block first */
+  oyArenaBlock_s_ * spare;             /* blocks of closed scopes */
+  size_t            block_size;
+  int               depth;             /* nested scopes */
+  long              generation;        /* counts closed outermost scopes */
+  oyArenaUnit_s_  * units;             /* open addressing hash */
+  size_t            units_n;           /* hash size, a power of two */
+  size_t            units_used;
+} oyArena_s_;
+
+#if defined(__GNUC__)
+static __thread oyArena_s_ oy_arena_ = {0,0,0,0,0,0,0,0};
+#else
+static oyArena_s_ oy_arena_ = {0,0,0,0,0,0,0,0};
+#endif
+
+#define oyArenaBlockData_m( block ) ((char*)(block) + sizeof(oyArenaBlock_s_))
+#define oyArenaUnitHash_m( unit, n ) \
+  (size_t)(((unit) * (uintptr_t)2654435761u) & ((n) - 1))
+
+/* free all blocks of a thread */
+static void  oyArenaRelease_         ( void              * ptr )
+{
+  oyArena_s_ * arena = (oyArena_s_*) ptr;
+  oyArenaBlock_s_ * lists[2], * block;
   int i;
 
-  /* here is a constant work done */
-  for(i = 0; i < OY_ALLOCATE_FUNC_POOL_SIZE_; ++i)
-    if(oy_allocate_func_pool_[i] == block)
+  if(!arena)
+    return;
+
+  lists[0] = arena->blocks;
+  lists[1] = arena->spare;
+  for(i = 0; i < 2; ++i)
+    while(lists[i])
     {
-      memset( block, 0, oy_allocate_func_pool_size_[i] );
-      oy_allocate_func_pool_used_[i] = 0;
+      block = lists[i];
+      lists[i] = block->next;
+      free( block->raw );
+    }
+  arena->blocks = arena->spare = 0;
 
-      if(oy_debug_memory)
-        printf( "%s:%d found block with pos:%d size=%d\n", __FILE__,__LINE__,
-                i, (int)oy_allocate_func_pool_size_[i] );
+  free( arena->units );
+  arena->units = 0;
+  arena->units_n = arena->units_used = 0;
+}
+
+#if defined(HAVE_POSIX)
+static pthread_key_t oy_arena_key_;
+static pthread_once_t oy_arena_once_ = PTHREAD_ONCE_INIT;
+
+static void  oyArenaKeyCreate_       ( void )
+{
+  pthread_key_create( &oy_arena_key_, oyArenaRelease_ );
+}
+#endif
+
+static void  oyArenaUnitAdd_         ( oyArenaUnit_s_    * units,
+                                       size_t              units_n,
+                                       uintptr_t           unit,
+                                       oyArenaBlock_s_   * block )
+{
+  size_t h = oyArenaUnitHash_m( unit, units_n );
+
+  while(units[h].block)
+    h = (h + 1) & (units_n - 1);
+  units[h].unit = unit;
+  units[h].block = block;
+}
+
+/* register all units of a new block */
+static int   oyArenaBlockAdd_        ( oyArenaBlock_s_   * block )
+{
+  uintptr_t first = (uintptr_t)block / OY_ARENA_UNIT_,
+            last = ((uintptr_t)oyArenaBlockData_m( block ) + block->size - 1)
+                   / OY_ARENA_UNIT_,
+            unit;
+  size_t n = (size_t)(last - first + 1), i;
+
+  if((oy_arena_.units_used + n) * 2 > oy_arena_.units_n)
+  {
+    size_t units_n = oy_arena_.units_n ? oy_arena_.units_n : 64;
+    oyArenaUnit_s_ * units;
+
+    while((oy_arena_.units_used + n) * 2 > units_n)
+      units_n *= 2;
+    units = (oyArenaUnit_s_*) calloc( units_n, sizeof(oyArenaUnit_s_) );
+    if(!units)
+      return 1;
+    for(i = 0; i < oy_arena_.units_n; ++i)
+      if(oy_arena_.units[i].block)
+        oyArenaUnitAdd_( units, units_n, oy_arena_.units[i].unit,
+                         oy_arena_.units[i].block );
+    free( oy_arena_.units );
+    oy_arena_.units = units;
+    oy_arena_.units_n = units_n;
+  }
+
+  for(unit = first; unit <= last; ++unit)
+    oyArenaUnitAdd_( oy_arena_.units, oy_arena_.units_n, unit, block );
+  oy_arena_.units_used += n;
+
+  return 0;
+}
 
-      return;
+/* the block, which holds ptr, or zero for foreign memory */
+static oyArenaBlock_s_ * oyArenaBlockFind_ ( void        * ptr )
+{
+  uintptr_t unit = (uintptr_t)ptr / OY_ARENA_UNIT_;
+  size_t h;
+
+  if(!oy_arena_.units_n)
+    return 0;
+
+  h = oyArenaUnitHash_m( unit, oy_arena_.units_n );
+  while(oy_arena_.units[h].block)
+  {
+    if(oy_arena_.units[h].unit == unit)
+    {
+      oyArenaBlock_s_ * block = oy_arena_.units[h].block;
+      char * data = oyArenaBlockData_m( block );
+      if(data <= (char*)ptr && (char*)ptr < data + block->size)
+        return block;
+      return 0;
     }
+    h = (h + 1) & (oy_arena_.units_n - 1);
+  }
+
+  return 0;
+}
+
+static oyArenaBlock_s_ * oyArenaBlockNew_ ( size_t       block_size )
+{
+  oyArenaBlock_s_ * block = 0;
+  size_t total = (sizeof(oyArenaBlock_s_) + block_size + OY_ARENA_UNIT_ - 1)
+                 & ~(size_t)(OY_ARENA_UNIT_ - 1);
+  void * raw = 0;
+
+#if defined(HAVE_POSIX)
+  if(posix_memalign( &raw, OY_ARENA_UNIT_, total ) != 0)
+    raw = 0;
+  block = (oyArenaBlock_s_*) raw;
+#else
+  raw = malloc( total + OY_ARENA_UNIT_ );
+  if(raw)
+    block = (oyArenaBlock_s_*)(((uintptr_t)raw + OY_ARENA_UNIT_ - 1)
+                               & ~(uintptr_t)(OY_ARENA_UNIT_ - 1));
 #endif
+  if(!block)
+    return 0;
 
-  if( !block ) {
-    WARNc_S( "Memory block is empty." )
-  } else
+  block->raw = raw;
+  block->size = total - sizeof(oyArenaBlock_s_);
+  block->used = 0;
+  block->next = 0;
+
+  if(oyArenaBlockAdd_( block ))
   {
-    free( block );
-    if(oy_debug_memory != 0)
-      printf( "%s:%d %d deallocated\n", __FILE__,__LINE__,--oy_allocs_count_ );
+    free( raw );
+    return 0;
   }
+
+#if defined(HAVE_POSIX)
+  /* the blocks of the thread are freed, when it exits */
+  pthread_once( &oy_arena_once_, oyArenaKeyCreate_ );
+  pthread_setspecific( oy_arena_key_, &oy_arena_ );
+#endif
+
+  return block;
+}
+
+/** @internal
+ *  @brief   open a arena scope for the calling thread
+ *
+ *  @param[in]     block_size          size of the arena blocks, 0 for default
+ *  @return                            the scope depth
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/06 (Oyranos: 0.3.2)
+ *  @date    2011/11/06
+ */
+int   oyArenaBegin_             (size_t        block_size)
+{
+  if(!oy_arena_.depth)
+    oy_arena_.block_size = block_size ? block_size :
+                           OY_ARENA_UNIT_ - sizeof(oyArenaBlock_s_);
+
+  return ++oy_arena_.depth;
+}
+
+/** @internal
+ *  @brief   close a arena scope of the calling thread
+ *
+ *  Leaving the outermost scope recycles all memory of the arena. The blocks
+ *  are kept for the next scope and freed when the thread exits.
+ *
+ *  @return                            the remaining scope depth
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/06 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+int   oyArenaEnd_               (void)
+{
+  oyArenaBlock_s_ * block;
+
+  if(oy_arena_.depth <= 0)
+  {
+    WARNc_S( "no arena scope open" );
+    return 0;
+  }
+
+  if(--oy_arena_.depth)
+    return oy_arena_.depth;
+
+  while(oy_arena_.blocks)
+  {
+    block = oy_arena_.blocks;
+    oy_arena_.blocks = block->next;
+    block->used = 0;
+    block->next = oy_arena_.spare;
+    oy_arena_.spare = block;
+  }
+  ++oy_arena_.generation;
+
+  return 0;
+}
+
+void* oyArenaAllocateFunc_      (size_t        size)
+{
+  oyArenaBlock_s_ * block = oy_arena_.blocks;
+  void * ptr;
+
+  if(!oy_arena_.depth)
+    return oyAllocateFunc_( size );
+
+  size = (size + OY_ARENA_ALIGN_ - 1) & ~(size_t)(OY_ARENA_ALIGN_ - 1);
+
+  /* large requests are released individually */
+  if(size > oy_arena_.block_size)
+    return oyAllocateFunc_( size );
+
+  if(!block || block->used + size > block->size)
+  {
+    oyArenaBlock_s_ ** spare = &oy_arena_.spare;
+
+    while(*spare && (*spare)->size < size)
+      spare = &(*spare)->next;
+
+    block = *spare;
+    if(block)
+      *spare = block->next;
+    else
+      block = oyArenaBlockNew_( oy_arena_.block_size );
+    if(!block)
+    {
+      WARNc1_S( "Can not allocate %d byte.", (int)oy_arena_.block_size );
+      return 0;
+    }
+    block->generation = oy_arena_.generation;
+    block->next = oy_arena_.blocks;
+    oy_arena_.blocks = block;
+  }
+
+  ptr = oyArenaBlockData_m( block ) + block->used;
+  block->used += size;
+
+  if(oy_debug_memory != 0)
+    oyAllocCount_m( arena_allocs, 1 );
+
+  return ptr;
+}
+
+void  oyArenaDeAllocateFunc_    (void        * ptr)
+{
+  oyArenaBlock_s_ * block = ptr ? oyArenaBlockFind_( ptr ) : 0;
+
+  if(block)
+  {
+    /* arena memory is recycled with the scope; a pointer of a closed scope
+     * is ignored as well */
+    if((block->generation != oy_arena_.generation || !oy_arena_.depth) &&
+       oy_debug_memory != 0)
+      oyAllocCount_m( arena_stale, 1 );
+    return;
+  }
+
+  oyDeAllocateFunc_( ptr );
 }
 
 void* oyAllocateWrapFunc_       (size_t        size,
@@ -43,6 +43,24 @@ void* oyAllocateWrapFunc_       (size_t        size,
                                  oyAlloc_f     allocate_func);
 void  oyDeAllocateFunc_         (void *        data);
 
+/* memory counters, filled while oy_debug_memory is set */
+typedef struct {
+  long allocs;                       /* oyAllocateFunc_() calls */
+  long deallocs;                     /* oyDeAllocateFunc_() calls */
+  long cache_hits;                   /* served from the thread cache */
+  long bytes;                        /* requested byte */
+  long arena_allocs;                 /* oyArenaAllocateFunc_() in a scope */
+  long arena_stale;                  /* released after the scope closed */
+} oyAllocCounts_s;
+void  oyAllocCountsGet_         (oyAllocCounts_s * counts);
+void  oyAllocCacheFinish_       (void);
+
+/* arena scopes for short living objects, see oyranos_helper.c */
+int   oyArenaBegin_             (size_t        block_size);
+int   oyArenaEnd_               (void);
+void* oyArenaAllocateFunc_      (size_t        size);
+void  oyArenaDeAllocateFunc_    (void        * ptr);
+
 
 extern intptr_t oy_observe_pointer_;
 extern int oy_debug_memory;
@@ -92,6 +92,8 @@ int oyExportReset_(int export_check)
 void     oyFinish_                   ( int                 unused )
 {
   oyI18Nreset_();
+  oyKeyCacheReset_();
   oyAlphaFinish_( unused );
+  oyAllocCacheFinish_();
 }
 
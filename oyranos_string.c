@@ -33,6 +33,11 @@
 #include "oyranos_xml.h"
 #include "oyranos_alpha.h"
 #include "oyranos_string.h"
+#include "lookup3.h" /* oy_hashlittle */
+
+#if defined(HAVE_POSIX)
+#include <pthread.h>
+#endif
 
 /* --- Helpers  --- */
 
@@ -749,3 +754,191 @@ size_t oyStrblen_            (const char * start)
   return 0;
 }
 
+
+/** @internal
+ *  a interned string, the text follows the header in the same block */
+typedef struct oyStringInterned_s_ oyStringInterned_s_;
+struct oyStringInterned_s_ {
+  oyStringInterned_s_ * next;          /**< next in the hash bucket */
+  uint32_t             hash;           /**< oy_hashlittle() of text */
+  long                 refs;           /**< counted references, -1 kept */
+  char                 text[1];        /**< the zero terminated string */
+};
+
+static oyStringInterned_s_ ** oy_string_interned_ = NULL;
+static uint32_t oy_string_interned_size_ = 0;
+static uint32_t oy_string_interned_n_ = 0;
+#if defined(HAVE_POSIX)
+static pthread_mutex_t oy_string_interned_mutex_ = PTHREAD_MUTEX_INITIALIZER;
+#define oyStringInternedLock_m() \
+        pthread_mutex_lock( &oy_string_interned_mutex_ )
+#define oyStringInternedUnLock_m() \
+        pthread_mutex_unlock( &oy_string_interned_mutex_ )
+#else
+#define oyStringInternedLock_m()
+#define oyStringInternedUnLock_m()
+#endif
+
+/* double the bucket count; needs the lock */
+static int         oyStringInternedGrow_( void )
+{
+  uint32_t size = oy_string_interned_size_ ? oy_string_interned_size_ * 2 :
+                                             256,
+           i;
+  oyStringInterned_s_ ** table = 0, * e, * next;
+
+  oyAllocHelper_m_( table, oyStringInterned_s_*, size, oyAllocateFunc_,
+                    return 1 );
+
+  for(i = 0; i < oy_string_interned_size_; ++i)
+    for(e = oy_string_interned_[i]; e; e = next)
+    {
+      next = e->next;
+      e->next = table[e->hash & (size - 1)];
+      table[e->hash & (size - 1)] = e;
+    }
+
+  if(oy_string_interned_)
+    oyDeAllocateFunc_( oy_string_interned_ );
+  oy_string_interned_ = table;
+  oy_string_interned_size_ = size;
+
+  return 0;
+}
+
+/* look up or add text; needs the lock */
+static oyStringInterned_s_ * oyStringInternedGet_ ( const char  * text )
+{
+  size_t len = strlen( text );
+  uint32_t hash = oy_hashlittle( text, len, 0 );
+  oyStringInterned_s_ * e = 0;
+  int error = 0;
+
+  if(oy_string_interned_size_)
+    for(e = oy_string_interned_[hash & (oy_string_interned_size_ - 1)];
+        e; e = e->next)
+      if(e->hash == hash && strcmp( e->text, text ) == 0)
+        return e;
+
+  if(oy_string_interned_n_ >= oy_string_interned_size_)
+    error = oyStringInternedGrow_();
+
+  if(!error)
+  {
+    e = oyAllocateFunc_( sizeof(oyStringInterned_s_) + len );
+    if(e)
+    {
+      e->hash = hash;
+      e->refs = 0;
+      memcpy( e->text, text, len + 1 );
+      e->next = oy_string_interned_[hash & (oy_string_interned_size_ - 1)];
+      oy_string_interned_[hash & (oy_string_interned_size_ - 1)] = e;
+      ++oy_string_interned_n_;
+    }
+  }
+
+  return e;
+}
+
+/** @internal
+ *  @brief   obtain the process wide single copy of a string
+ *
+ *  Equal strings are mapped to the same address. Thus two interned strings
+ *  can be compared by pointer. The result is valid until the process ends
+ *  and must not be modified or released. Use it for strings from static
+ *  and module tables. Strings which are generated at run time should use
+ *  oyStringInternCopy_().
+ *
+ *  @param[in]     text                the string to intern
+ *  @return                            the interned string or NULL
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/08 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+const char *       oyStringIntern_   ( const char        * text )
+{
+  oyStringInterned_s_ * e = 0;
+
+  if(!text)
+    return NULL;
+
+  oyStringInternedLock_m();
+  e = oyStringInternedGet_( text );
+  if(e)
+    e->refs = -1;
+  oyStringInternedUnLock_m();
+
+  if(!e)
+    WARNc_S( "could not intern string" );
+
+  return e ? e->text : NULL;
+}
+
+/** @internal
+ *  @brief   obtain a counted reference to the single copy of a string
+ *
+ *  Like oyStringIntern_(), but the string is freed with its last
+ *  oyStringInternRelease_(). A string, which is as well interned through
+ *  oyStringIntern_(), is kept until the process ends.
+ *
+ *  @param[in]     text                the string to intern
+ *  @return                            the interned string or NULL
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+const char *       oyStringInternCopy_(const char        * text )
+{
+  oyStringInterned_s_ * e = 0;
+
+  if(!text)
+    return NULL;
+
+  oyStringInternedLock_m();
+  e = oyStringInternedGet_( text );
+  if(e && e->refs >= 0)
+    ++e->refs;
+  oyStringInternedUnLock_m();
+
+  if(!e)
+    WARNc_S( "could not intern string" );
+
+  return e ? e->text : NULL;
+}
+
+/** @internal
+ *  @brief   release a reference from oyStringInternCopy_()
+ *
+ *  @param[in]     text                the interned string or NULL
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/24 (Oyranos: 0.3.2)
+ *  @date    2011/11/24
+ */
+void               oyStringInternRelease_(
+                                       const char        * text )
+{
+  oyStringInterned_s_ * e, ** prev;
+
+  if(!text)
+    return;
+
+  e = (oyStringInterned_s_*)(text - offsetof( oyStringInterned_s_, text ));
+
+  oyStringInternedLock_m();
+  if(e->refs > 0 && --e->refs == 0)
+  {
+    prev = &oy_string_interned_[e->hash & (oy_string_interned_size_ - 1)];
+    while(*prev && *prev != e)
+      prev = &(*prev)->next;
+    if(*prev)
+    {
+      *prev = e->next;
+      --oy_string_interned_n_;
+      oyDeAllocateFunc_( e );
+    }
+  }
+  oyStringInternedUnLock_m();
+}
@@ -37,6 +37,10 @@ char*              oyStringCopy_     ( const char        * text,
                                        oyAlloc_f           allocateFunc );
 void               oyStringFree_     ( char             ** text,
                                        oyDeAlloc_f         deallocFunc );
+const char *       oyStringIntern_   ( const char        * text );
+const char *       oyStringInternCopy_(const char        * text );
+void               oyStringInternRelease_(
+                                       const char        * text );
 char*              oyStringAppend_   ( const char        * text,
                                        const char        * append,
                                        oyAlloc_f           allocateFunc );
@@ -32,14 +32,17 @@ oyObject_s   oyObject_SetAllocators_  ( oyObject_s        object,
  *  @memberof oyObject_s
  *  @brief   increase the ref counter and return the above zero ref value
  *
- *  @version Oyranos: 0.1.8
- *  @date    2011/02/02
+ *  The counter is changed atomically without taking the object lock.
+ *
+ *  @version Oyranos: 0.3.2
+ *  @date    2011/11/02
  *  @since   2008/02/07 (Oyranos: 0.1.8)
  */
 int          oyObject_Ref            ( oyObject_s          obj )
 {
   oyObject_s s = obj;
   int error = !s;
+  int ref = 0;
 
   if( s->type_ != oyOBJECT_OBJECT_S)
   {
@@ -48,29 +51,25 @@ int          oyObject_Ref            ( oyObject_s          obj )
     return 1;
   }
 
+#if !defined(OY_HAVE_ATOMIC_INT)
   if(error <= 0)
     oyObject_Lock( s, __FILE__, __LINE__ );
+#endif
 
   if(error <= 0)
-  {
-    ++s->ref_;
-  }
+    ref = oyAtomicInc_m( &s->ref_ );
+
 #   if DEBUG_OBJECT
     WARNc3_S("%s   ID: %d refs: %d",
-             oyStructTypeToText( s->parent_types_[s->parent_types_[0]] ), s->id_, s->ref_)
+             oyStructTypeToText( s->parent_types_[s->parent_types_[0]] ), s->id_, ref)
 #   endif
 
-  if(obj->parent_types_[obj->parent_types_[0]] == oyOBJECT_NAMED_COLOURS_S)
-  {
-    int e_a = error;
-    error = pow(e_a,2.1);
-    error = e_a;
-  }
-
+#if !defined(OY_HAVE_ATOMIC_INT)
   if(error <= 0)
     oyObject_UnLock( s, __FILE__, __LINE__ );
+#endif
 
-  return s->ref_;
+  return ref;
 }
 
 /** @internal
@@ -173,3 +173,257 @@ int        oyStruct_ObserverRemove_  ( oyStructList_s    * list,
   }
   return error;
 }
+
+oyObserverCounts_s oy_observer_counts_ = {0,0,0,0,0};
+
+/** @internal
+ *  a held back signal; the oyObserver_s is searched again on dispatch, as it
+ *  might have been removed from its model meanwhile */
+typedef struct {
+  oyStruct_s         * model;          /**< referenced model */
+  oyStruct_s         * observer;       /**< referenced observing object */
+  oyObserver_Signal_f  signal;         /**< the observers signal function */
+  oySIGNAL_e           signal_type;
+  oyStruct_s         * signal_data;    /**< referenced, the last one wins */
+} oyObserverQueued_s_;
+
+typedef struct {
+  int                  depth;          /**< nested batches */
+  oyObserverQueued_s_* queue;
+  int                  n;
+  int                  reserved;
+  int                * index;          /**< hash of queue positions + 1 */
+  int                  index_n;        /**< power of two > 2 * reserved */
+} oyObserverBatch_s_;
+
+#if defined(__GNUC__)
+static __thread oyObserverBatch_s_ oy_observer_batch_ = {0,0,0,0,0,0};
+#else
+static oyObserverBatch_s_ oy_observer_batch_ = {0,0,0,0,0,0};
+#endif
+
+#define OY_OBSERVER_BATCH_ROUNDS_MAX_ 64
+
+static uint32_t    oyObserverQueuedHash_( oyStruct_s     * model,
+                                       oyStruct_s        * observer,
+                                       oyObserver_Signal_f signal,
+                                       oySIGNAL_e          signal_type )
+{
+  uintptr_t h = (uintptr_t)model >> 3;
+  h = h * 31 + ((uintptr_t)observer >> 3);
+  h = h * 31 + (uintptr_t)signal;
+  h = h * 31 + signal_type;
+  return (uint32_t)(h ^ (h >> 16));
+}
+
+/* resize the queue and rebuild the hash of positions */
+static int         oyObserverBatchGrow_( oyObserverBatch_s_ * b )
+{
+  int reserved = b->reserved ? b->reserved * 2 : 32,
+      index_n = reserved * 4,
+      i;
+  oyObserverQueued_s_ * queue = 0;
+  int * index = 0;
+
+  oyAllocHelper_m_( queue, oyObserverQueued_s_, reserved, oyAllocateFunc_,
+                    return 1 );
+  oyAllocHelper_m_( index, int, index_n, oyAllocateFunc_,
+                    oyDeAllocateFunc_( queue ); return 1 );
+
+  if(b->n)
+    memcpy( queue, b->queue, sizeof(oyObserverQueued_s_) * b->n );
+
+  for(i = 0; i < b->n; ++i)
+  {
+    oyObserverQueued_s_ * q = &queue[i];
+    uint32_t pos = oyObserverQueuedHash_( q->model, q->observer, q->signal,
+                                          q->signal_type ) & (index_n - 1);
+    while(index[pos])
+      pos = (pos + 1) & (index_n - 1);
+    index[pos] = i + 1;
+  }
+
+  if(b->queue)
+    oyDeAllocateFunc_( b->queue );
+  if(b->index)
+    oyDeAllocateFunc_( b->index );
+  b->queue = queue;
+  b->reserved = reserved;
+  b->index = index;
+  b->index_n = index_n;
+
+  return 0;
+}
+
+/** Function  oyObserverBatchAdd_
+ *  @memberof oyObserver_s
+ *  @brief    Hold a signal back for oyObserverBatchEnd()
+ *  @internal
+ *
+ *  A signal with the same model, observer, signal function and signal type
+ *  is sent only once. The signal data of the last call is kept.
+ *
+ *  @param[in]     obs                 the observer to signal
+ *  @param[in]     signal_type         the basic signal type to emit
+ *  @param[in]     signal_data         the advanced signal information
+ *  @return                            0 - not queued; 1 - queued
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/28 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+int        oyObserverBatchAdd_       ( oyObserver_s      * obs,
+                                       oySIGNAL_e          signal_type,
+                                       oyStruct_s        * signal_data )
+{
+  oyObserverBatch_s_ * b = &oy_observer_batch_;
+  oyObserverQueued_s_ * q = 0;
+  uint32_t pos;
+
+  if(!b->depth || !obs || !obs->model || !obs->observer)
+    return 0;
+
+  if(b->n >= b->reserved && oyObserverBatchGrow_( b ))
+    return 0;
+
+  pos = oyObserverQueuedHash_( obs->model, obs->observer, obs->signal,
+                               signal_type ) & (b->index_n - 1);
+  while(b->index[pos])
+  {
+    q = &b->queue[b->index[pos] - 1];
+    if(q->model == obs->model && q->observer == obs->observer &&
+       q->signal == obs->signal && q->signal_type == signal_type)
+      break;
+    q = 0;
+    pos = (pos + 1) & (b->index_n - 1);
+  }
+
+  if(q)
+  {
+    if(oyToSignalCount_m( oyObserverFlagsGet() ))
+      oyObserverCount_m( coalesced, 1 );
+    if(q->signal_data)
+      q->signal_data->release( &q->signal_data );
+  } else
+  {
+    q = &b->queue[b->n];
+    b->index[pos] = ++b->n;
+    q->model = obs->model->copy( obs->model, 0 );
+    q->observer = obs->observer->copy( obs->observer, 0 );
+    q->signal = obs->signal;
+    q->signal_type = signal_type;
+
+    if(oyToSignalCount_m( oyObserverFlagsGet() ))
+      oyObserverCount_m( queued, 1 );
+  }
+
+  if(signal_data && signal_data->copy)
+    q->signal_data = signal_data->copy( signal_data, 0 );
+  else
+    q->signal_data = 0;
+
+  return 1;
+}
+
+/* send all held back signals; signals emitted by the observers meanwhile
+ * are collected again and sent in a next round */
+static int oyObserverBatchDispatch_  ( void )
+{
+  oyObserverBatch_s_ * b = &oy_observer_batch_;
+  oyObserverQueued_s_ * queue;
+  int n, i, j, rounds = 0, sent = 0;
+
+  while(b->n)
+  {
+    /* take the queue; new signals go into a fresh one */
+    queue = b->queue; n = b->n;
+    if(b->index)
+      oyDeAllocateFunc_( b->index );
+    b->queue = 0; b->n = b->reserved = 0;
+    b->index = 0; b->index_n = 0;
+
+    for(i = 0; i < n; ++i)
+    {
+      oyObserverQueued_s_ * q = &queue[i];
+      oyOption_s * o = 0;
+      oyStructList_s * observers = 0;
+      oyObserver_s * obs;
+      int obs_n;
+
+      if(rounds < OY_OBSERVER_BATCH_ROUNDS_MAX_ && q->model->oy_)
+        o = oyOptions_Find( q->model->oy_->handles_, OY_SIGNAL_OBSERVERS );
+      if(o)
+        observers = (oyStructList_s*) oyOption_StructGet( o,
+                                                     oyOBJECT_STRUCT_LIST_S );
+      obs_n = oyStructList_Count( observers );
+      for(j = 0; j < obs_n; ++j)
+      {
+        obs = (oyObserver_s*) oyStructList_GetType( observers,
+                                                    j, oyOBJECT_OBSERVER_S );
+        if(obs && obs->model == q->model && obs->observer == q->observer &&
+           obs->signal == q->signal)
+        {
+          oyObserver_SignalSend( obs, q->signal_type, q->signal_data );
+          ++sent;
+          break;
+        }
+      }
+      oyOption_Release( &o );
+
+      q->model->release( &q->model );
+      q->observer->release( &q->observer );
+      if(q->signal_data)
+        q->signal_data->release( &q->signal_data );
+    }
+    oyDeAllocateFunc_( queue );
+
+    if(++rounds == OY_OBSERVER_BATCH_ROUNDS_MAX_)
+      WARNc1_S( "%s", _("Signals are cycling; dropping them") );
+  }
+
+  return sent;
+}
+
+/** Function  oyObserverBatchBegin_
+ *  @memberof oyObserver_s
+ *  @brief    Open a signal batch of the calling thread
+ *  @internal
+ *
+ *  @return                            the batch depth
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/28 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+int        oyObserverBatchBegin_     ( void )
+{
+  return ++oy_observer_batch_.depth;
+}
+
+/** Function  oyObserverBatchEnd_
+ *  @memberof oyObserver_s
+ *  @brief    Close a signal batch of the calling thread
+ *  @internal
+ *
+ *  The outermost batch sends the held back signals. The batch stays open
+ *  while sending, so that signals from the observers are coalesced too.
+ *
+ *  @return                            the remaining batch depth
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/28 (Oyranos: 0.3.2)
+ *  @date    2011/11/28
+ */
+int        oyObserverBatchEnd_       ( void )
+{
+  if(oy_observer_batch_.depth <= 0)
+  {
+    WARNc_S( "no observer batch open" );
+    return 0;
+  }
+
+  if(oy_observer_batch_.depth == 1)
+    oyObserverBatchDispatch_();
+
+  return --oy_observer_batch_.depth;
+}
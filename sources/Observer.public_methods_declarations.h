@@ -39,3 +39,9 @@ OYAPI uint32_t OYEXPORT
            oyObserverFlagsGet        ( void );
 OYAPI int  OYEXPORT
            oyObserverFlagsSet        ( uint32_t            flags );
+OYAPI int  OYEXPORT
+           oyObserverBatchBegin      ( void );
+OYAPI int  OYEXPORT
+           oyObserverBatchEnd        ( void );
+OYAPI void OYEXPORT
+           oyObserverCountsGet       ( oyObserverCounts_s* counts );
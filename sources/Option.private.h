@@ -0,0 +1,3 @@
+/** @internal
+ *  counts registration changes of options, which might be listed already */
+extern uint32_t oy_option_registrations_;
@@ -33,11 +33,15 @@ void oyOption_Release__Members( oyOption_s_ * option )
      * E.g.: deallocateFunc( option->member );
      */
 
+    /* a released option is in no list, skip the change count */
+    oyStringInternRelease_( option->registration );
+    option->registration = 0;
     oyOption_Clear( (oyOption_s*) option );
   }
 }
 
 static int oy_option_id_ = 0;
+uint32_t oy_option_registrations_ = 0;
 
 /** Function    oyOption_Init__Members
  *  @memberof   oyOption_s
@@ -102,10 +106,9 @@ int oyOption_Copy__Members( oyOption_s_ * dst, oyOption_s_ * src)
    error = oyOption_Clear( (oyOption_s*)dst );
    oyStruct_EnableSignalSend( (oyStruct_s*)dst );
 
-   dst->registration = oyStringCopy_( src->registration, allocateFunc_ );
+   dst->registration = oyStringInternCopy_( src->registration );
    dst->value_type = src->value_type;
-   dst->value = allocateFunc_(sizeof(oyValue_u));
-   memset(dst->value, 0, sizeof(oyValue_u));
+   oyOption_ValueNew_( dst );
    oyValueCopy( dst->value, src->value, dst->value_type,
                 allocateFunc_, deallocateFunc_ );
    dst->source = src->source;
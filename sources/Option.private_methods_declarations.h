@@ -13,3 +13,5 @@ int            oyOption_SetFromInt_  ( oyOption_s_       * obj,
                                        uint32_t            flags );
 int            oyOption_StructMoveIn_( oyOption_s_       * option,
                                        oyStruct_s       ** s );
+oyValue_u *    oyOption_ValueNew_    ( oyOption_s_       * option );
+void           oyOption_ValueRelease_( oyOption_s_       * option );
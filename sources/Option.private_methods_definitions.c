@@ -108,8 +108,6 @@ int            oyOption_SetFromText_ ( oyOption_s_       * obj,
 
     if(obj->value)
     {
-      oyDeAlloc_f deallocateFunc = obj->oy_->deallocateFunc_;
-
       if( text )
       {
         int j = 0;
@@ -129,11 +127,10 @@ int            oyOption_SetFromText_ ( oyOption_s_       * obj,
         }
 
       }
-      oyValueRelease( &obj->value, obj->value_type, deallocateFunc );
+      oyOption_ValueRelease_( obj );
     }
 
-    obj->value = obj->oy_->allocateFunc_(sizeof(oyValue_u));
-    memset( obj->value, 0, sizeof(oyValue_u) );
+    oyOption_ValueNew_( obj );
 
     if(oyToStringList_m(flags))
     {
@@ -318,8 +315,6 @@ int            oyOption_SetFromInt_  ( oyOption_s_       * obj,
   {
     if(s->value && 0 /*flags & OY_CLEAR*/)
     {
-      oyDeAlloc_f deallocateFunc = s->oy_->deallocateFunc_;
-
       if(s->value_type == oyVAL_INT && obj->value)
         if(s->value->int32 == integer)
           return error;
@@ -329,14 +324,12 @@ int            oyOption_SetFromInt_  ( oyOption_s_       * obj,
            s->value->int32_list[1 + pos] == integer)
           return error;
 
-      oyValueRelease( &s->value, s->value_type, deallocateFunc );
+      oyOption_ValueRelease_( s );
     }
 
     if(!s->value)
     {
-      oyAllocHelper_m_( s->value, oyValue_u, 1,
-                        s->oy_->allocateFunc_,
-                        error = 1 );
+      oyOption_ValueNew_( s );
       if(pos == 0 &&
          s->value_type != oyVAL_INT_LIST)
         s->value_type = oyVAL_INT;
@@ -409,17 +402,10 @@ int            oyOption_StructMoveIn_( oyOption_s_       * option,
 
   if(error <= 0)
   {
-    if(option->value)
-    {
-      oyDeAlloc_f deallocateFunc = option->oy_->deallocateFunc_;
-
-      oyValueRelease( &option->value, option->value_type, deallocateFunc );
-
-      option->value_type = 0;
-    }
+    oyOption_ValueRelease_( option );
+    option->value_type = 0;
 
-    oyAllocHelper_m_( option->value, oyValue_u, 1, option->oy_->allocateFunc_,
-                      error = 1 );
+    oyOption_ValueNew_( option );
   }
 
   if(error <= 0)
@@ -431,3 +417,46 @@ int            oyOption_StructMoveIn_( oyOption_s_       * option,
 
   return error;
 }
+
+/** @internal
+ *  Function oyOption_ValueNew_
+ *  @memberof oyOption_s
+ *  @brief   provide a empty value
+ *
+ *  The value lives inside the option and needs no extra allocation.
+ *
+ *  @param         option              the option
+ *  @return                            the cleared value
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/08 (Oyranos: 0.3.2)
+ *  @date    2011/11/08
+ */
+oyValue_u *    oyOption_ValueNew_    ( oyOption_s_       * option )
+{
+  memset( &option->value_inline_, 0, sizeof(oyValue_u) );
+  option->value = &option->value_inline_;
+
+  return option->value;
+}
+
+/** @internal
+ *  Function oyOption_ValueRelease_
+ *  @memberof oyOption_s
+ *  @brief   release the value content
+ *
+ *  @param         option              the option
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/08 (Oyranos: 0.3.2)
+ *  @date    2011/11/08
+ */
+void           oyOption_ValueRelease_( oyOption_s_       * option )
+{
+  if(!option->value)
+    return;
+
+  oyValueClear( option->value, option->value_type,
+                option->oy_->deallocateFunc_ );
+  option->value = 0;
+}
@@ -0,0 +1 @@
+  oyOptionsIndex_s_  * index_;         /**< @private key index of list_, guarded by the list_ lock */
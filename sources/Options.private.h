@@ -0,0 +1,33 @@
+/** @internal
+ *  a registration token of a listed option */
+typedef struct {
+  const char         * id;             /**< interned token without prefix */
+  int                  level;          /**< registration level or one of -1 for the key level, -2 for a option without registration */
+  int                  pos;            /**< position in oyOptions_s_::list_ */
+  int                  next;           /**< next entry in the bucket or -1 */
+} oyOptionsIndexEntry_s_;
+
+/** @internal
+ *  token index over the options of a oyOptions_s_
+ *
+ *  Each option is hashed with all tokens of its registration levels and
+ *  with the tokens of its last level as key. A empty token matches every
+ *  pattern and is hashed as empty string. Entries are appended in list
+ *  order and dropped, as soon as already listed positions or registrations
+ *  change.
+ */
+typedef struct {
+  uint32_t             order;          /**< oyStructList_s_::order_ at build time */
+  uint32_t             registrations;  /**< oy_option_registrations_ at build time */
+  oyStructList_s     * list;           /**< the indexed list */
+  int                  n;              /**< indexed list positions */
+  int                  levels_min;     /**< least levels of indexed registrations */
+  oyOptionsIndexEntry_s_ * entries;    /**< the entries */
+  int                  entries_n;      /**< used entries */
+  int                  entries_reserved; /**< allocated entries */
+  int                * buckets;        /**< first entry in each bucket or -1 */
+  int                  buckets_n;      /**< a power of two */
+} oyOptionsIndex_s_;
+
+#define OY_OPTIONS_INDEX_KEY_ -1
+#define OY_OPTIONS_INDEX_UNSET_ -2
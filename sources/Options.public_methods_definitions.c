@@ -1,4 +1,7 @@
 #include "oyranos_definitions.h"
+#include "oyStructList_s_.h" /* not nice, but direct access is probably faster */
+#include "oyHash_s.h"
+#include "oyranos_generic_internal.h"
 
 /** Function oyOptions_FromBoolean
  *  @memberof oyOptions_s
@@ -151,23 +154,14 @@ oyOptions_s *  oyOptions_ForFilter   ( const char        * registration,
 }
 #endif /* OY_FILTER_CORE_S_H */
 
-/** Function oyOptions_FromText
- *  @memberof oyOptions_s
- *  @brief   deserialise a text file to oyOptions_s data
- *
- *  This function is based on libxml2.
- *
- *  @param[in]     text                the text to process
- *  @param[in]     flags               for future use
- *  @param         object              the optional object
- *  @return                            the data
- *
- *  @version Oyranos: 0.1.9
- *  @since   2008/11/17 (Oyranos: 0.1.9)
- *  @date    2008/11/17
- */
-oyOptions_s *  oyOptions_FromText    ( const char        * text,
-                                       uint32_t            flags,
+/** @internal
+ *  parsed texts of oyOptions_FromText(), the entries hold templates */
+oyStructList_s * oy_options_text_cache_ = 0;
+/* stop to add texts, as some are generated at runtime */
+#define OY_OPTIONS_TEXT_CACHE_MAX_ 256
+
+/* parse a XML text into a new set of options */
+static oyOptions_s * oyOptions_ParseText_( const char        * text,
                                        oyObject_s          object )
 {
   oyOptions_s * s = 0;
@@ -201,14 +195,110 @@ oyOptions_s *  oyOptions_FromText    ( const char        * text,
 
   if(error <= 0)
   {
-    s = oyOptions_New(0);
+    s = oyOptions_New( object );
 
     oyOptions_ParseXML_( (oyOptions_s_*)s, &texts, &texts_n, doc, cur );
 
     oyStringListRelease_( &texts, texts_n, oyDeAllocateFunc_ );
+  }
+
+  if(doc)
     xmlFreeDoc(doc);
+
+  return s;
+}
+
+/** Function oyOptions_FromText
+ *  @memberof oyOptions_s
+ *  @brief   deserialise a text file to oyOptions_s data
+ *
+ *  This function is based on libxml2.
+ *
+ *  Each text is parsed once. The resulting options are kept as template
+ *  in a cache and later calls obtain copies of the template options. The
+ *  static option descriptions of modules are so not parsed again for each
+ *  new filter node.
+ *
+ *  @param[in]     text                the text to process
+ *  @param[in]     flags               OY_NO_CACHE_READ, OY_NO_CACHE_WRITE
+ *  @param         object              the optional object; the options and
+ *                                     their members use its allocators
+ *  @return                            the data
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2008/11/17 (Oyranos: 0.1.9)
+ *  @date    2011/11/11
+ */
+oyOptions_s *  oyOptions_FromText    ( const char        * text,
+                                       uint32_t            flags,
+                                       oyObject_s          object )
+{
+  oyOptions_s * s = 0, * cached = 0;
+  oyHash_s * entry = 0;
+  oyStructList_s_ * list;
+  oyOption_s * o;
+  int error = !text, i;
+
+  if(error <= 0 && (!oyToNoCacheRead_m(flags) || !oyToNoCacheWrite_m(flags)))
+  {
+    oyCacheListCreate_( &oy_options_text_cache_ );
+
+    entry = oyCacheListGetEntry_( oy_options_text_cache_,
+                oyStructList_Count( oy_options_text_cache_ ) <
+                                     OY_OPTIONS_TEXT_CACHE_MAX_ ? 0 : 0x02,
+                                  text );
+
+    /* long texts are compared by a 32-bit hash; check for a collision */
+    if(entry &&
+       oyStrcmp_( oyObject_GetName( entry->oy_, oyNAME_NAME ), text ) != 0)
+      oyHash_Release( &entry );
+  }
+
+  if(entry && !oyToNoCacheRead_m(flags))
+  {
+    /* reference under the entry lock, a writer might set it */
+    oyObject_Lock( entry->oy_, __FILE__, __LINE__ );
+    cached = (oyOptions_s*) oyHash_GetPointer( entry, oyOBJECT_OPTIONS_S );
+    cached = oyOptions_Copy( cached, 0 );
+    oyObject_UnLock( entry->oy_, __FILE__, __LINE__ );
   }
 
+  if(error <= 0 && !cached && entry && !oyToNoCacheWrite_m(flags))
+  {
+    oyOptions_s * parsed = oyOptions_ParseText_( text, 0 );
+
+    /* the first thread which parsed the text wins */
+    oyObject_Lock( entry->oy_, __FILE__, __LINE__ );
+    cached = (oyOptions_s*) oyHash_GetPointer( entry, oyOBJECT_OPTIONS_S );
+    if(cached)
+      cached = oyOptions_Copy( cached, 0 );
+    else if(parsed)
+    {
+      error = oyHash_SetPointer( entry, (oyStruct_s*)parsed );
+      cached = oyOptions_Copy( parsed, 0 );
+    } else
+      error = 1;
+    oyObject_UnLock( entry->oy_, __FILE__, __LINE__ );
+
+    oyOptions_Release( &parsed );
+  }
+
+  if(cached)
+  {
+    /* the template is never changed; hand out real copies of its options */
+    list = (oyStructList_s_*) oyOptionsPriv_m(cached)->list_;
+    s = oyOptions_New( object );
+    for(i = 0; s && list && i < list->n_; ++i)
+    {
+      o = oyOption_Copy( (oyOption_s*) list->ptr_[i], s->oy_ );
+      oyOptions_MoveIn( s, &o, -1 );
+    }
+    oyOptions_Release( &cached );
+  } else if(error <= 0)
+    s = oyOptions_ParseText_( text, object );
+
+  oyHash_Release( &entry );
+
   return s;
 }
 
@@ -1018,44 +1108,54 @@ int            oyOptions_CountType   ( oyOptions_s       * options,
  *  This function returns the first found option for a given key.
  *  The key is represented by a registrations option level.
  *
+ *  The options are looked up under the list lock through a token index,
+ *  which is kept along the list and extended for appended options. Only
+ *  patterns without a required token are scanned. Only the found option
+ *  is referenced.
+ *
  *  @param         options             set of options
  *  @param         registration        registration or key
  *  @return                            a matching options
  *
- *  @version Oyranos: 0.1.9
+ *  @version Oyranos: 0.3.2
  *  @since   2008/11/05 (Oyranos: 0.1.9)
- *  @date    2009/04/13
+ *  @date    2011/11/10
  */
 oyOption_s *   oyOptions_Find        ( oyOptions_s       * options,
                                        const char        * registration )
 {
   int error = !options || !registration;
-  oyOption_s * o = 0,
-             * option = 0;
-  int found;
+  oyOption_s_ * o = 0;
+  oyOption_s * option = 0;
+  oyStructList_s_ * list = 0;
 
   if(error <= 0 && options && options->type_ == oyOBJECT_OPTIONS_S)
+    list = (oyStructList_s_*) oyOptionsPriv_m(options)->list_;
+
+  if(list)
   {
-    oyOptions_s * set_a = options;
-    int set_an = oyOptions_Count( set_a ), i;
+    int i;
 
-    for(i = 0; i < set_an; ++i)
-    {
-      o = oyOptions_Get( options, i );
-      found = 1;
+    oyObject_Lock( list->oy_, __FILE__, __LINE__ );
 
-      if(found && registration &&
-         !oyFilterRegistrationMatch( oyOptionPriv_m(o)->registration, registration, 0 ))
-          found = 0;
+    i = oyOptions_IndexFind_( oyOptionsPriv_m(options), registration );
 
-      if(found)
+    if(i >= 0)
+      option = oyOption_Copy( (oyOption_s*)list->ptr_[i], 0 );
+    else if(i == -2)
+      for(i = 0; i < list->n_; ++i)
       {
-        option = o;
-        break;
+        o = (oyOption_s_*) list->ptr_[i];
+
+        if(o && o->type_ == oyOBJECT_OPTION_S &&
+           oyFilterRegistrationMatch( o->registration, registration, 0 ))
+        {
+          option = oyOption_Copy( (oyOption_s*)o, 0 );
+          break;
+        }
       }
 
-      oyOption_Release( &o );
-    }
+    oyObject_UnLock( list->oy_, __FILE__, __LINE__ );
   }
 
   return option;
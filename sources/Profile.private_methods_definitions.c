@@ -186,11 +186,12 @@ oyStructList_s_ * oy_profile_s_file_cache_ = 0;
  *
  *  flags supports OY_NO_CACHE_READ and OY_NO_CACHE_WRITE to disable cache
  *  reading and writing. The cache flags are useful for one time profiles or
- *  scanning large numbers of profiles.
+ *  scanning large numbers of profiles. The cache is safe to use from
+ *  several threads.
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2007/11/0 (Oyranos: 0.1.9)
- *  @date    2010/05/18
+ *  @date    2011/11/04
  */
 oyProfile_s_ *  oyProfile_FromFile_  ( const char        * name,
                                        uint32_t            flags,
@@ -209,19 +210,24 @@ oyProfile_s_ *  oyProfile_FromFile_  ( const char        * name,
 
   if(!oyToNoCacheRead_m(flags) || !oyToNoCacheWrite_m(flags))
   {
-    if(!oy_profile_s_file_cache_)
-      oy_profile_s_file_cache_ = oyStructList_New_( 0 );
+    oyCacheListCreate_( (oyStructList_s**)&oy_profile_s_file_cache_ );
 
     if(!object)
     {
       entry = (oyHash_s_*)oyCacheListGetEntry_ ( (oyStructList_s*)oy_profile_s_file_cache_, 0, name );
 
-      if(!oyToNoCacheRead_m(flags))
+      if(entry && !oyToNoCacheRead_m(flags))
       {
+        /* reference under the entry lock, a writer might replace it */
+        oyObject_Lock( entry->oy_, __FILE__, __LINE__ );
         s = (oyProfile_s_*) oyHash_GetPointer_( entry, oyOBJECT_PROFILE_S);
         s = (oyProfile_s_*) oyProfile_Copy( (oyProfile_s*)s, 0 );
+        oyObject_UnLock( entry->oy_, __FILE__, __LINE__ );
         if(s)
+        {
+          oyHash_Release_( &entry );
           return s;
+        }
       }
     }
   }
@@ -295,8 +301,19 @@ oyProfile_s_ *  oyProfile_FromFile_  ( const char        * name,
   {
     if(!oyToNoCacheWrite_m(flags))
     {
-      /* 3b.1. update cache entry */
-      error = oyHash_SetPointer_( entry, (oyStruct_s*)s );
+      oyProfile_s_ * cached = 0;
+
+      /* 3b.1. update cache entry; the first thread which loaded the
+       *       profile wins and all others share its copy */
+      oyObject_Lock( entry->oy_, __FILE__, __LINE__ );
+      cached = (oyProfile_s_*) oyHash_GetPointer_( entry, oyOBJECT_PROFILE_S);
+      if(cached)
+      {
+        oyProfile_Release( (oyProfile_s**)&s );
+        s = (oyProfile_s_*) oyProfile_Copy( (oyProfile_s*)cached, 0 );
+      } else
+        error = oyHash_SetPointer_( entry, (oyStruct_s*)s );
+      oyObject_UnLock( entry->oy_, __FILE__, __LINE__ );
 #if 0
     } else {
       int i = 0, n = 0, pos = -1;
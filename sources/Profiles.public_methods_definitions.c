@@ -7,9 +7,9 @@ extern oyProfiles_s * oy_profile_list_cache_;
  *  @param[in]     patterns            a list properties, e.g. classes
  *  @param         object              the optional object
  *
- *  @version Oyranos: 0.1.8
+ *  @version Oyranos: 0.3.2
  *  @since   2008/06/20 (Oyranos: 0.1.8)
- *  @date    2008/06/20
+ *  @date    2011/11/04
  */
 OYAPI oyProfiles_s * OYEXPORT
                  oyProfiles_Create( oyProfiles_s   * patterns,
@@ -42,6 +42,17 @@ OYAPI oyProfiles_s * OYEXPORT
       oyProfile_Release( &pattern );
     }
 
+    if(!oy_profile_list_cache_)
+    {
+      oyProfiles_s * list = oyProfiles_New( 0 );
+      if(!oyAtomicCasPtr_m( &oy_profile_list_cache_, 0, list ))
+        oyProfiles_Release( &list );
+    }
+
+    /* fill the shared list only once */
+    oyObject_Lock( ((oyStruct_s*)oy_profile_list_cache_)->oy_,
+                   __FILE__, __LINE__ );
+
     if(oyProfiles_Count( oy_profile_list_cache_ ) != names_n)
     {
       for(i = 0; i < names_n; ++i)
@@ -70,6 +81,8 @@ OYAPI oyProfiles_s * OYEXPORT
     n = oyProfiles_Count( oy_profile_list_cache_ );
     if(oyProfiles_Count( oy_profile_list_cache_ ) != names_n)
       WARNc2_S("updated oy_profile_list_cache_ differs: %d %d",n, names_n);
+    oyObject_UnLock( ((oyStruct_s*)oy_profile_list_cache_)->oy_,
+                     __FILE__, __LINE__ );
     oyStringListRelease_( &names, names_n, oyDeAllocateFunc_ ); names_n = 0;
 
     for(i = 0; i < n; ++i)
@@ -3,3 +3,5 @@ int                  n_;             /**< @private the number of visible pointer
 int                  n_reserved_;    /**< @private the number of allocated pointers */
 char               * list_name;      /**< name of list */
 oyOBJECT_e           parent_type_;   /**< @private parents struct type */
+oyStruct_s         * ptr_inline_[OY_STRUCT_LIST_INLINE_N_]; /**< @private storage of short lists */
+uint32_t             order_;         /**< @private stamp of the last change of the listed positions */
@@ -0,0 +1,12 @@
+/** @internal
+ *  number of pointers a oyStructList_s holds without a extra allocation */
+#define OY_STRUCT_LIST_INLINE_N_ 8
+
+/** @internal
+ *  source of oyStructList_s_::order_ stamps, unique over all lists */
+extern uint32_t oy_struct_list_order_;
+/** @internal
+ *  mark the positions of already listed pointers as changed; appending
+ *  keeps the stamp, so dependent indices need only to be extended */
+#define oyStructList_OrderChanged_m_( s ) \
+  (s)->order_ = oyAtomicInc_m( &oy_struct_list_order_ )
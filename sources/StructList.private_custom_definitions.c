@@ -26,7 +26,7 @@ void oyStructList_Release__Members( oyStructList_s_ * structlist )
     /* Deallocate members of basic type here
      * E.g.: deallocateFunc( structlist->member );
      */
-    if(structlist->ptr_)
+    if(structlist->ptr_ && structlist->ptr_ != structlist->ptr_inline_)
       deallocateFunc(structlist->ptr_);
 
     if(structlist->list_name)
@@ -36,6 +36,8 @@ void oyStructList_Release__Members( oyStructList_s_ * structlist )
   }
 }
 
+uint32_t oy_struct_list_order_ = 0;
+
 /** Function    oyStructList_Init__Members
  *  @memberof   oyStructList_s
  *  @brief      Custom StructList constructor 
@@ -49,6 +51,11 @@ void oyStructList_Release__Members( oyStructList_s_ * structlist )
  */
 int oyStructList_Init__Members( oyStructList_s_ * structlist )
 {
+  /* short lists keep their pointers inside the object */
+  structlist->ptr_ = structlist->ptr_inline_;
+  structlist->n_reserved_ = OY_STRUCT_LIST_INLINE_N_;
+  oyStructList_OrderChanged_m_( structlist );
+
   return 0;
 }
 
@@ -83,10 +90,13 @@ int oyStructList_Copy__Members( oyStructList_s_ * dst, oyStructList_s_ * src)
 
   oyObject_Lock( dst->oy_, __FILE__, __LINE__ );
 
-  dst->n_reserved_ = (src->n_ > 10) ? (int)(src->n_ * 1.5) : 10;
   dst->n_ = src->n_;
-  dst->ptr_ = oyAllocateFunc_( sizeof(int*) * dst->n_reserved_ );
-  memset( dst->ptr_, 0, sizeof(int*) * dst->n_reserved_ );
+  if(src->n_ > OY_STRUCT_LIST_INLINE_N_)
+  {
+    dst->n_reserved_ = (src->n_ > 10) ? (int)(src->n_ * 1.5) : 10;
+    dst->ptr_ = oyAllocateFunc_( sizeof(int*) * dst->n_reserved_ );
+    memset( dst->ptr_, 0, sizeof(int*) * dst->n_reserved_ );
+  }
 
   for(i = 0; i < src->n_; ++i)
     if(src->ptr_[i]->copy)
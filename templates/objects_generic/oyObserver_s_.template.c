@@ -7,6 +7,7 @@
 
 #include "oyObject_s.h"
 #include "oyOption_s_.h"
+#include "oyOptions_s.h"
 
 
 /* Include "{{ class.private_methods_definitions_c }}" { */
@@ -1 +1,8 @@
 {% extends "BaseList_s_.c" %}
+
+{% block LocalIncludeFiles %}
+{{ block.super }}
+#include <limits.h>
+#include "oyOption_s_.h"
+#include "oyStructList_s_.h"
+{% endblock %}
@@ -4,3 +4,10 @@
 {{ block.super }}
 #include <libxml/parser.h>
 {% endblock %}
+
+{% block ChildMembers %}
+{{ block.super }}
+/* Include "Options.members.h" { */
+{% include "Options.members.h" %}
+/* } Include "Options.members.h" */
+{% endblock %}
@@ -6,6 +6,7 @@
 #include "oyranos_helper.h"
 #include "oyranos_generic.h"
 #include "oyranos_object.h"
+#include "oyranos_object_internal.h"
 
 #include "oyObject_s.h"
 #include "oyHash_s.h"
@@ -83,14 +84,19 @@ const char *   oyContextCollectData_ ( oyStruct_s        * s,
 /** @internal
  *  @brief get always a Oyranos cache entry from a cache list
  *
+ *  The lookup and the insertion of a new entry happen under the lock of
+ *  cache_list. So concurrent callers asking for the same hash_text obtain
+ *  the same entry. Use the entry's object lock to guard its pointer.
+ *
  *  @param[in]     cache_list          the list to search in
- *  @param[in]     flags               0 - assume text, 1 - assume sized hash
+ *  @param[in]     flags               0 - assume text, 1 - assume sized hash,
+ *                                     2 - search only, add no new entry
  *  @param[in]     hash_text           the text to search for in the cache_list
  *  @return                            the cache entry may not have a entry
  *
- *  @version Oyranos: 0.1.10
+ *  @version Oyranos: 0.3.2
  *  @since   2007/11/24 (Oyranos: 0.1.8)
- *  @date    2009/06/04
+ *  @date    2011/11/11
  */
 oyHash_s *   oyCacheListGetEntry_    ( oyStructList_s    * cache_list,
                                        uint32_t            flags,
@@ -121,8 +127,12 @@ oyHash_s *   oyCacheListGetEntry_    ( oyStructList_s    * cache_list,
       search_int[0] = oyMiscBlobGetL3_( (void*)hash_text, oyStrlen_(hash_text));
   }
 
-  if(error <= 0)
-    n = oyStructList_Count(cache_list);
+  if(error > 0)
+    return 0;
+
+  oyObject_Lock( cache_list->oy_, __FILE__, __LINE__ );
+
+  n = oyStructList_Count(cache_list);
 
   for(i = 0; i < n; ++i)
   {
@@ -132,12 +142,12 @@ oyHash_s *   oyCacheListGetEntry_    ( oyStructList_s    * cache_list,
     if(compare )
     if(memcmp(search_ptr, compare->oy_->hash_ptr_, OY_HASH_SIZE*2) == 0)
     {
-      entry = compare;
-      return oyHash_Copy( entry, 0 );
+      entry = oyHash_Copy( compare, 0 );
+      break;
     }
   }
 
-  if(error <= 0 && !entry)
+  if(!entry && !(flags & 0x02))
   {
     search_key = oyHash_Get(hash_text, 0);
     error = !search_key;
@@ -154,11 +164,37 @@ oyHash_s *   oyCacheListGetEntry_    ( oyStructList_s    * cache_list,
     oyHash_Release( &search_key );
   }
 
+  oyObject_UnLock( cache_list->oy_, __FILE__, __LINE__ );
 
-  if(entry)
-    return oyHash_Copy( entry, 0 );
-  else
+  return entry;
+}
+
+/** @internal
+ *  @brief create a global cache list on first use
+ *
+ *  Concurrent first callers race on the list pointer. Only one list is
+ *  published, the others are released again.
+ *
+ *  @param[in,out] cache_list          the address of the global cache list
+ *  @return                            the cache list
+ *
+ *  @version Oyranos: 0.3.2
+ *  @since   2011/11/04 (Oyranos: 0.3.2)
+ *  @date    2011/11/04
+ */
+oyStructList_s * oyCacheListCreate_  ( oyStructList_s   ** cache_list )
+{
+  if(!cache_list)
     return 0;
+
+  if(!*cache_list)
+  {
+    oyStructList_s * list = oyStructList_New( 0 );
+    if(!oyAtomicCasPtr_m( cache_list, 0, list ))
+      oyStructList_Release( &list );
+  }
+
+  return *cache_list;
 }
 
 /** } Private function definitions */
@@ -9,6 +9,7 @@
 oyHash_s *   oyCacheListGetEntry_    ( oyStructList_s    * cache_list,
                                        uint32_t            flags,
                                        const char        * hash_text );
+oyStructList_s * oyCacheListCreate_   ( oyStructList_s   ** cache_list );
 
 
 #endif /* {{ file_name|cut:".h"|upper }}_H */
@@ -510,8 +510,7 @@ oyStructList_s * oy_cmm_cache_ = 0;
  */
 oyHash_s *   oyCMMCacheListGetEntry_ ( const char        * hash_text)
 {
-  if(!oy_cmm_cache_)
-    oy_cmm_cache_ = oyStructList_New( 0 );
+  oyCacheListCreate_( &oy_cmm_cache_ );
 
   return oyCacheListGetEntry_(oy_cmm_cache_, 0, hash_text);
 }
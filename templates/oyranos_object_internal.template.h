@@ -38,6 +38,59 @@
     action; \
   }
 
+/* lock free counters for reference counting and object ids, a
+ * compare and swap for publishing lazily created pointers, a
+ * acquire load for reading them and a release store for ready flags */
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define OY_HAVE_ATOMIC_INT 1
+#define oyAtomicInc_m( ptr ) __sync_add_and_fetch( ptr, 1 )
+#define oyAtomicDec_m( ptr ) __sync_sub_and_fetch( ptr, 1 )
+#define oyAtomicCasPtr_m( ptr, old, new_ ) \
+  __sync_bool_compare_and_swap( ptr, old, new_ )
+#if defined(__ATOMIC_ACQUIRE)
+#define oyAtomicGet_m( ptr ) __atomic_load_n( ptr, __ATOMIC_ACQUIRE )
+#define oyAtomicSet_m( ptr, v ) __atomic_store_n( ptr, v, __ATOMIC_RELEASE )
+#else
+#define oyAtomicGet_m( ptr ) (__sync_synchronize(), *(ptr))
+#define oyAtomicSet_m( ptr, v ) (__sync_synchronize(), *(ptr) = (v))
+#endif
+#else
+/* without atomics the counters need to be guarded by oyObject_Lock() */
+#define oyAtomicInc_m( ptr ) (++(*(ptr)))
+#define oyAtomicDec_m( ptr ) (--(*(ptr)))
+#define oyAtomicCasPtr_m( ptr, old, new_ ) \
+  (*(ptr) == (old) ? (*(ptr) = (new_), 1) : 0)
+#define oyAtomicGet_m( ptr ) (*(ptr))
+#define oyAtomicSet_m( ptr, v ) (*(ptr) = (v))
+#endif
+
+/** @internal
+ *  a '.' separated part of a registration level */
+typedef struct {
+  char                 api;            /**< '4' ... '9' or zero */
+  char                 type;           /**< '+', '_' or '-' */
+  const char         * id;             /**< text without prefix, interned
+                                            for cached patterns */
+} oyRegistrationToken_s_;
+
+/** @internal
+ *  a registration string or pattern compiled into interned tokens */
+typedef struct oyRegistrationPattern_s_ oyRegistrationPattern_s_;
+struct oyRegistrationPattern_s_ {
+  oyRegistrationPattern_s_ * next;     /**< next in the hash bucket */
+  uint32_t             hash;           /**< oy_hashlittle() of text */
+  const char         * text;           /**< the interned source string */
+  int                  cached;         /**< kept and interned, or released */
+  int                  levels_n;       /**< number of '/' separated levels */
+  int                * levels;         /**< first token of each level + end */
+  oyRegistrationToken_s_ * tokens;     /**< the tokens of all levels */
+};
+
+const oyRegistrationPattern_s_ * oyRegistrationPatternGet_ (
+                                       const char        * text,
+                                       int               * release );
+void   oyRegistrationPatternsReset_  ( void );
+
 #define OY_ERR if(l_error != 0) error = l_error;
 
 int    oyTextIccDictMatch            ( const char        * text,
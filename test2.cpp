@@ -204,6 +204,11 @@ oyTESTRESULT_e testI18N()
 
 #define TEST_DOMAIN "sw/Oyranos/Tests"
 
+#if defined(HAVE_POSIX)
+#include <sys/wait.h>   /* waitpid() */
+#include <unistd.h>     /* fork() sleep() */
+#endif
+
 #include "oyranos_elektra.h"
 oyTESTRESULT_e testElektra()
 {
@@ -284,6 +289,57 @@ oyTESTRESULT_e testElektra()
   } else
     result = oyTESTRESULT_SUCCESS;
 
+  if(value) oyDeAllocateFunc_( value ); value = 0;
+
+  /* the key directory is now cached; a write must be visible at once */
+  error = oyAddKey_valueComment_("sw/Oyranos/Tests/test_key",
+                                 "myTestValue2", "myTestComment" );
+  value = oyGetKeyString_("sw/Oyranos/Tests/test_key", 0);
+  if(!error && value && strcmp(value,"myTestValue2") == 0)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS, 
+    "Elektra cached (value after write): %s", value );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL, 
+    "Elektra cached (value after write) wrong: %s", value?value:"----" );
+  }
+  if(value) oyDeAllocateFunc_( value ); value = 0;
+
+  value = oyGetKeyString_("sw/Oyranos/Tests/test_key_not_existing", 0);
+  if(value && !value[0])
+  { PRINT_SUB( oyTESTRESULT_SUCCESS, 
+    "Elektra cached (missing key)                       " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL, 
+    "Elektra cached (missing key) wrong: %s", value?value:"----" );
+  }
+  if(value) oyDeAllocateFunc_( value ); value = 0;
+
+#if defined(HAVE_POSIX)
+  /* a other process writes; the snapshot expires after a few seconds */
+  {
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+      oyAddKey_valueComment_("sw/Oyranos/Tests/test_key",
+                             "myTestValue3", "myTestComment" );
+      _exit(0);
+    }
+    if(pid > 0)
+      waitpid( pid, 0, 0 );
+    sleep( 3 );
+  }
+  value = oyGetKeyString_("sw/Oyranos/Tests/test_key", 0);
+  if(value && strcmp(value,"myTestValue3") == 0)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS, 
+    "Elektra cached (value from other process): %s", value );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL, 
+    "Elektra cached (value from other process) wrong: %s",
+    value?value:"----" );
+  }
+  if(value) oyDeAllocateFunc_( value ); value = 0;
+#endif
+
   return result;
 }
 
@@ -794,6 +850,462 @@ oyTESTRESULT_e testOptionsCopy ()
   return result;
 }
 
+#include "oyOptions_s_.h"
+#include "oyStructList_s_.h"
+
+oyTESTRESULT_e testOptionsStorage ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int error = 0, i, n = 100000;
+  oyOptions_s * opts = 0;
+  oyOption_s * a = 0, * b = 0;
+  oyStructList_s_ * list = 0;
+  int32_t verbose = 0;
+  const char * dirty = 0;
+  double clck;
+  char reg[64];
+
+  fprintf(stdout, "\n" );
+
+  a = oyOption_FromRegistration( "//" OY_TYPE_STD "/filter/storage", 0 );
+  b = oyOption_FromRegistration( "//" OY_TYPE_STD "/filter/storage", 0 );
+  if(a && b &&
+     oyOption_GetRegistration( a ) == oyOption_GetRegistration( b ))
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOption_s registration interned                " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOption_s registration interned                " );
+  }
+
+  /* a generated key lives as long as a option refers to it */
+  {
+    oyObject_s object = oyObject_New();
+    oyOption_s * c = oyOption_FromRegistration(
+                            "//" OY_TYPE_STD "/filter/storage_generated", 0 ),
+               * d = 0;
+    oyOption_SetFromText( c, "1", 0 );
+    d = oyOption_Copy( c, object );
+    oyOption_Release( &c );
+    oyObject_Release( &object );
+    if(d && oyOption_GetRegistration( d ) &&
+       strcmp( oyOption_GetRegistration( d ),
+               "//" OY_TYPE_STD "/filter/storage_generated" ) == 0)
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "oyOption_s registration referenced by copy      " );
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "oyOption_s registration referenced by copy      " );
+    }
+    oyOption_Release( &d );
+  }
+
+  error = oyOption_SetFromInt( a, 3, 0, 0 );
+  if(!error && ((oyOption_s_*)a)->value == &((oyOption_s_*)a)->value_inline_ &&
+     oyOption_GetValueInt( a, 0 ) == 3)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOption_s value inline                         " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOption_s value inline                         " );
+  }
+  oyOption_Release( &a );
+  oyOption_Release( &b );
+
+  oyOptions_SetFromText( &opts, "//" OY_TYPE_STD "/config/dirty", "true",
+                         OY_CREATE_NEW );
+  oyOptions_SetFromInt( &opts, "//" OY_TYPE_STD "/config/verbose", 1, 0,
+                        OY_CREATE_NEW );
+  list = (oyStructList_s_*) ((oyOptions_s_*)opts)->list_;
+  if(list && list->ptr_ == list->ptr_inline_)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyStructList_s short list inline                " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyStructList_s short list inline                " );
+  }
+
+  for(i = 0; i < 20; ++i)
+  {
+    sprintf( reg, "//" OY_TYPE_STD "/config/key_%d", i );
+    oyOptions_SetFromInt( &opts, reg, i, 0, OY_CREATE_NEW );
+  }
+  error = oyOptions_FindInt( opts, "key_19", 0, &verbose );
+  if(!error && verbose == 19 && oyOptions_Count( opts ) == 22 &&
+     list->ptr_ != list->ptr_inline_)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyStructList_s grown out of inline storage      " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyStructList_s grown out of inline storage      " );
+  }
+
+  /* the per node checks of lcm2 */
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    dirty = oyOptions_FindString( opts, "dirty", "true" );
+    error = oyOptions_FindInt( opts, "verbose", 0, &verbose );
+  }
+  clck = oyClock() - clck;
+
+  if(dirty && !error && verbose == 1)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_FindString/Int() %s",
+                  oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Find"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_FindString/Int() failed               " );
+  }
+
+  oyOptions_Release( &opts );
+
+  return result;
+}
+
+oyTESTRESULT_e testOptionsIndex ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int error = 0, i, n = 100000;
+  oyOptions_s * opts = 0;
+  oyOption_s * o = 0;
+  int32_t value = -1;
+  double clck;
+  char reg[64];
+
+  fprintf(stdout, "\n" );
+
+  for(i = 0; i < 100; ++i)
+  {
+    sprintf( reg, "//" OY_TYPE_STD "/index_test/key_%d", i );
+    oyOptions_SetFromInt( &opts, reg, i, 0, OY_CREATE_NEW );
+  }
+  /* a second option with the same key */
+  oyOptions_SetFromInt( &opts, "//" OY_TYPE_STD "/index_test/key_5", 105, 0,
+                        OY_ADD_ALWAYS );
+
+  error = oyOptions_FindInt( opts, "key_5", 0, &value );
+  if(!error && value == 5 && oyOptions_Count( opts ) == 101)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_Find() first of equal keys            " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_Find() first of equal keys            " );
+  }
+
+  oyOptions_ReleaseAt( opts, 5 );
+  error = oyOptions_FindInt( opts, "key_5", 0, &value );
+  if(!error && value == 105 &&
+     oyOptions_FindInt( opts, "key_6", 0, &value ) == 0 && value == 6)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_Find() after oyOptions_ReleaseAt()    " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_Find() after oyOptions_ReleaseAt()    " );
+  }
+
+  o = oyOption_FromRegistration( "//" OY_TYPE_STD "/index_test/key_7", 0 );
+  oyOption_SetFromInt( o, 107, 0, 0 );
+  oyOptions_MoveIn( opts, &o, 0 );
+  error = oyOptions_FindInt( opts, "key_7", 0, &value );
+  if(!error && value == 107)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_Find() after insertion                " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_Find() after insertion                " );
+  }
+
+  o = oyOptions_Find( opts, "key_99" );
+  oyOption_SetRegistration( o, "//" OY_TYPE_STD "/index_test/renamed" );
+  oyOption_Release( &o );
+  error = oyOptions_FindInt( opts, "renamed", 0, &value );
+  o = oyOptions_Find( opts, "key_99" );
+  if(!error && value == 99 && !o)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_Find() after oyOption_SetRegistration()" );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_Find() after oyOption_SetRegistration()" );
+  }
+  oyOption_Release( &o );
+
+  /* no required token; scanned */
+  o = oyOptions_Find( opts, "_key_3" );
+  if(o && oyOption_GetValueInt( o, 0 ) == 3)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_Find() optional pattern               " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_Find() optional pattern               " );
+  }
+  oyOption_Release( &o );
+
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    sprintf( reg, "key_%d", 50 + i % 49 );
+    error = oyOptions_FindInt( opts, reg, 0, &value );
+    if(error)
+      break;
+  }
+  clck = oyClock() - clck;
+
+  if(!error)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_FindInt() 100 options %s",
+                  oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Find"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_FindInt() 100 options failed          " );
+  }
+
+  oyOptions_Release( &opts );
+
+  return result;
+}
+
+oyTESTRESULT_e testOptionsFromText ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int i, n = 1000, count = 0;
+  int32_t intent = -1;
+  oyOptions_s * a = 0, * b = 0;
+  double clck, clck_parse;
+  const char * text =
+    "<org><freedesktop><openicc><behaviour>"
+    "<rendering_intent>1</rendering_intent>"
+    "<rendering_bpc>1</rendering_bpc>"
+    "<proof_soft>0</proof_soft>"
+    "</behaviour></openicc></freedesktop></org>";
+
+  fprintf(stdout, "\n" );
+
+  a = oyOptions_FromText( text, 0, 0 );
+  b = oyOptions_FromText( text, 0, 0 );
+  oyOptions_SetFromText( &a, "rendering_intent", "3", 0 );
+  count = oyOptions_Count( b );
+  if(a && b && a != b && count == 3 && oyOptions_Count( a ) == 3 &&
+     oyOptions_FindString( b, "rendering_intent", "1" ) &&
+     oyOptions_FindString( a, "rendering_intent", "3" ))
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_FromText() cached copies independent  " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_FromText() cached copies independent %d", count );
+  }
+  oyOptions_Release( &a );
+  oyOptions_Release( &b );
+
+  clck_parse = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    a = oyOptions_FromText( text, OY_NO_CACHE_READ | OY_NO_CACHE_WRITE, 0 );
+    oyOptions_Release( &a );
+  }
+  clck_parse = oyClock() - clck_parse;
+
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    a = oyOptions_FromText( text, 0, 0 );
+    if(i < n - 1)
+      oyOptions_Release( &a );
+  }
+  clck = oyClock() - clck;
+
+  if(a && oyOptions_FindString( a, "proof_soft", "0" ))
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_FromText() parsed %s",
+                  oyProfilingToString(n,clck_parse/(double)CLOCKS_PER_SEC, "Parse"));
+    PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyOptions_FromText() cached %s",
+                  oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Copy"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyOptions_FromText() cached                     " );
+  }
+  oyOptions_Release( &a );
+
+  return result;
+}
+
+static int test_observer_signals_ = 0;
+static int testObserverSignal_       ( oyObserver_s      * observer,
+                                       oySIGNAL_e          signal_type,
+                                       oyStruct_s        * signal_data )
+{
+  if(signal_type == oySIGNAL_DATA_CHANGED)
+    ++test_observer_signals_;
+  return 1;
+}
+
+oyTESTRESULT_e testObserverBatch ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int i, n = 1000, held = 0;
+  uint32_t flags = oyObserverFlagsGet();
+  oyObserverCounts_s c1, c2;
+  oyOption_s * model = oyOption_FromRegistration(
+                       "org/freedesktop/openicc/behaviour/rendering_intent", 0 ),
+             * observer = oyOption_FromRegistration(
+                       "org/freedesktop/openicc/behaviour/rendering_bpc", 0 );
+  double clck, clck_batch;
+
+  fprintf(stdout, "\n" );
+
+  oyStruct_ObserverAdd( (oyStruct_s*)model, (oyStruct_s*)observer, 0,
+                        testObserverSignal_ );
+  oyObserverFlagsSet( flags | OY_SIGNAL_COUNT );
+
+  test_observer_signals_ = 0;
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+    oyOption_SetFromText( model, i%2 ? "1" : "0", 0 );
+  clck = oyClock() - clck;
+
+  if(test_observer_signals_ == n)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyStruct_ObserverSignal() direct %s",
+                  oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Signal"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyStruct_ObserverSignal() direct %d/%d", test_observer_signals_, n );
+  }
+
+  test_observer_signals_ = 0;
+  oyObserverCountsGet( &c1 );
+  clck_batch = oyClock();
+  oyObserverBatchBegin();
+  for(i = 0; i < n; ++i)
+    oyOption_SetFromText( model, i%2 ? "1" : "0", 0 );
+  held = test_observer_signals_;
+  oyObserverBatchEnd();
+  clck_batch = oyClock() - clck_batch;
+  oyObserverCountsGet( &c2 );
+
+  if(held == 0 && test_observer_signals_ == 1 &&
+     c2.sent - c1.sent == 1 && c2.queued - c1.queued == 1 &&
+     c2.coalesced - c1.coalesced == n - 1)
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyObserverBatchEnd() coalesced %s",
+                  oyProfilingToString(n,clck_batch/(double)CLOCKS_PER_SEC, "Signal"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyObserverBatchEnd() coalesced %d %d sent:%ld queued:%ld", held,
+    test_observer_signals_, c2.sent - c1.sent, c2.queued - c1.queued );
+  }
+
+  oyObserverFlagsSet( flags );
+  oyStruct_ObserverRemove( (oyStruct_s*)model, (oyStruct_s*)observer,
+                           testObserverSignal_ );
+  oyOption_Release( &model );
+  oyOption_Release( &observer );
+
+  return result;
+}
+
+oyTESTRESULT_e testArena ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int i, j, n = 1000, debug_memory = oy_debug_memory;
+  long stale;
+  oyAllocCounts_s c0, c1, c2, c3;
+  double clck, clck_arena;
+  const char * text =
+    "<org><freedesktop><openicc><behaviour>"
+    "<rendering_intent>1</rendering_intent>"
+    "<rendering_bpc>1</rendering_bpc>"
+    "<proof_soft>0</proof_soft>"
+    "</behaviour></openicc></freedesktop></org>";
+
+  fprintf(stdout, "\n" );
+
+  oy_debug_memory = 1;
+
+  /* default allocators */
+  oyAllocCountsGet_( &c0 );
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    oyOptions_s * opts = oyOptions_FromText( text, 0, 0 );
+    char reg[64];
+    for(j = 0; j < 20; ++j)
+    {
+      sprintf( reg, "org/freedesktop/openicc/arena_test/key_%d", j );
+      oyOptions_SetFromText( &opts, reg, "value", OY_CREATE_NEW );
+    }
+    oyOptions_Release( &opts );
+  }
+  clck = oyClock() - clck;
+  oyAllocCountsGet_( &c1 );
+
+  /* the same in a arena scope */
+  clck_arena = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    oyArenaBegin_( 0 );
+    {
+      oyObject_s arena = oyObject_NewWithAllocators( oyArenaAllocateFunc_,
+                                                     oyArenaDeAllocateFunc_ );
+      oyOptions_s * opts = oyOptions_FromText( text, 0, arena );
+      char reg[64];
+      for(j = 0; j < 20; ++j)
+      {
+        sprintf( reg, "org/freedesktop/openicc/arena_test/key_%d", j );
+        oyOptions_SetFromText( &opts, reg, "value", OY_CREATE_NEW );
+      }
+      oyOptions_Release( &opts );
+      oyObject_Release( &arena );
+    }
+    oyArenaEnd_();
+  }
+  clck_arena = oyClock() - clck_arena;
+  oyAllocCountsGet_( &c2 );
+
+  /* a late release of arena memory is ignored */
+  {
+    char * late;
+    oyArenaBegin_( 0 );
+    late = (char*) oyArenaAllocateFunc_( 64 );
+    oyArenaEnd_();
+    oyArenaDeAllocateFunc_( late );
+  }
+  oyAllocCountsGet_( &c3 );
+  stale = c3.arena_stale - c2.arena_stale;
+
+  oy_debug_memory = debug_memory;
+
+  if( c2.arena_allocs - c1.arena_allocs > 0 &&
+      c2.allocs - c1.allocs < c1.allocs - c0.allocs )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "malloc: %ld %.03f  arena: %ld+%ld %.03f",
+    (c1.allocs - c0.allocs)/n, (double)clck/(double)CLOCKS_PER_SEC,
+    (c2.allocs - c1.allocs)/n, (c2.arena_allocs - c1.arena_allocs)/n,
+    (double)clck_arena/(double)CLOCKS_PER_SEC );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "malloc: %ld  arena: %ld+%ld                        ",
+    (c1.allocs - c0.allocs)/n,
+    (c2.allocs - c1.allocs)/n, (c2.arena_allocs - c1.arena_allocs)/n );
+  }
+
+  if( stale == 1 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "late release of arena memory ignored              " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "late release of arena memory: %ld                 ", stale );
+  }
+
+  return result;
+}
+
 oyTESTRESULT_e testBlob ()
 {
   oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
@@ -894,39 +1406,218 @@ oyTESTRESULT_e testBlob ()
   return result;
 }
 
-#include <libxml/parser.h>
-#include <libxml/xmlsave.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
-oyTESTRESULT_e testSettings ()
+oyTESTRESULT_e testObjectRefs ()
 {
   oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
 
-  int i;
-  uint32_t size = 0;
-  int count = 0,
-      countB = 0;
-  char * text = 0, * tmp = 0;
-  int error = 0;
-  oyOptions_s * opts = 0;
-  oyOption_s * o;
-  xmlDocPtr doc = 0;
-
-  oyExportReset_(EXPORT_SETTING);
+  int i, n = 1000000, threads = 1, ids_ok = 1;
+  oyObject_s object = oyObject_New();
+  oyBlob_s * blob = oyBlob_New( 0 );
+  int ids[1000];
+  double clck;
 
   fprintf(stdout, "\n" );
 
-  /* we check for out standard CMM */
-  opts = oyOptions_ForFilter( "//" OY_TYPE_STD, "lcms",
-                                            oyOPTIONATTRIBUTE_ADVANCED /* |
-                                            oyOPTIONATTRIBUTE_FRONT |
-                                            OY_SELECT_COMMON */, 0 );
-
-  oyOptions_SetFromText( &opts, "cmyk_cmyk_black_preservation", "1", 0 );
+#if defined(_OPENMP)
+  threads = omp_get_max_threads();
+#endif
 
-  count = oyOptions_Count( opts );
-  if(!count)
+  /* single threaded reference */
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
   {
-    PRINT_SUB( oyTESTRESULT_FAIL, 
+    oyObject_s o = oyObject_Copy( object );
+    oyObject_Release( &o );
+  }
+  clck = oyClock() - clck;
+
+  if( oyObject_GetRefCount( object ) == 1 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyObject_Copy/Release() 1 thread   %d %.03f", n,
+                                       (double)clck/(double)CLOCKS_PER_SEC );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyObject_Copy/Release() refs: %d                   ",
+    oyObject_GetRefCount( object ) );
+  }
+
+  /* many threads hammer on the same counter */
+  clck = oyClock();
+#pragma omp parallel for private(i)
+  for(i = 0; i < n; ++i)
+  {
+    oyObject_s o = oyObject_Copy( object );
+    oyBlob_s * b = oyBlob_Copy( blob, 0 );
+    oyBlob_Release( &b );
+    oyObject_Release( &o );
+  }
+  clck = oyClock() - clck;
+
+  if( oyObject_GetRefCount( object ) == 1 &&
+      oyObject_GetRefCount( ((oyStruct_s*)blob)->oy_ ) == 1 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyObject_Copy/Release() %d threads %d %.03f", threads, n,
+                                       (double)clck/(double)CLOCKS_PER_SEC );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyObject_Copy/Release() %d threads refs: %d/%d       ", threads,
+    oyObject_GetRefCount( object ), oyObject_GetRefCount( ((oyStruct_s*)blob)->oy_ ) );
+  }
+
+  /* object ids must stay unique under concurrent creation */
+#pragma omp parallel for private(i)
+  for(i = 0; i < 1000; ++i)
+  {
+    oyObject_s o = oyObject_New();
+    ids[i] = oyObject_GetId( o );
+    oyObject_Release( &o );
+  }
+  for(i = 1; i < 1000 && ids_ok; ++i)
+  {
+    int j;
+    for(j = 0; j < i; ++j)
+      if(ids[i] == ids[j])
+      { ids_ok = 0; break; }
+  }
+
+  if( ids_ok )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyObject_New() unique ids %d threads                ", threads );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyObject_New() duplicate ids %d threads             ", threads );
+  }
+
+  oyBlob_Release( &blob );
+  oyObject_Release( &object );
+
+  return result;
+}
+
+oyTESTRESULT_e testAllocator ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int i, n = 1000000, debug_memory = oy_debug_memory;
+  oyAllocCounts_s before, after;
+  char * ptr;
+  double clck, clck_malloc;
+
+  fprintf(stdout, "\n" );
+
+  /* blocks are interchangeable with the C library */
+  ptr = (char*) oyAllocateFunc_( 24 );
+  memset( ptr, 1, 24 );
+  free( ptr );
+  ptr = (char*) malloc( 24 );
+  memset( ptr, 1, 24 );
+  oyDeAllocateFunc_( ptr );
+  ptr = (char*) oyAllocateFunc_( 24 );
+  memset( ptr, 1, 24 );
+  oyDeAllocateFunc_( ptr );
+
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyAllocateFunc_()/free() mixed                      " );
+  }
+
+  /* a finished cache holds no blocks for reuse */
+  oy_debug_memory = 1;
+  ptr = (char*) oyAllocateFunc_( 24 );
+  oyDeAllocateFunc_( ptr );
+  oyAllocCacheFinish_();
+  oyAllocCountsGet_( &before );
+  ptr = (char*) oyAllocateFunc_( 24 );
+  oyDeAllocateFunc_( ptr );
+  oyAllocCountsGet_( &after );
+  oyAllocCacheFinish_();
+  oy_debug_memory = debug_memory;
+
+  if( after.cache_hits == before.cache_hits )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyAllocCacheFinish_() empties the cache             " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyAllocCacheFinish_() hits: %ld                     ",
+    after.cache_hits - before.cache_hits );
+  }
+
+  oy_debug_memory = 1;
+  oyAllocCountsGet_( &before );
+  clck = oyClock();
+#pragma omp parallel for private(i,ptr)
+  for(i = 0; i < n; ++i)
+  {
+    ptr = (char*) oyAllocateFunc_( 1 + i%256 );
+    ptr[i%256] = 0;
+    oyDeAllocateFunc_( ptr );
+  }
+  clck = oyClock() - clck;
+  oyAllocCountsGet_( &after );
+  oy_debug_memory = debug_memory;
+
+  clck_malloc = oyClock();
+#pragma omp parallel for private(i,ptr)
+  for(i = 0; i < n; ++i)
+  {
+    ptr = (char*) malloc( 1 + i%256 );
+    ptr[i%256] = 0;
+    free( ptr );
+  }
+  clck_malloc = oyClock() - clck_malloc;
+
+  if( after.allocs - before.allocs == n &&
+      after.deallocs - before.deallocs == n )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyAllocateFunc_() %d hits:%ld %.03f malloc: %.03f", n,
+    after.cache_hits - before.cache_hits,
+    (double)clck/(double)CLOCKS_PER_SEC,
+    (double)clck_malloc/(double)CLOCKS_PER_SEC );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyAllocateFunc_() counts: %ld/%ld                  ",
+    after.allocs - before.allocs, after.deallocs - before.deallocs );
+  }
+
+  return result;
+}
+
+#include <libxml/parser.h>
+#include <libxml/xmlsave.h>
+
+oyTESTRESULT_e testSettings ()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+
+  int i;
+  uint32_t size = 0;
+  int count = 0,
+      countB = 0;
+  char * text = 0, * tmp = 0;
+  int error = 0;
+  oyOptions_s * opts = 0;
+  oyOption_s * o;
+  xmlDocPtr doc = 0;
+
+  oyExportReset_(EXPORT_SETTING);
+
+  fprintf(stdout, "\n" );
+
+  /* we check for out standard CMM */
+  opts = oyOptions_ForFilter( "//" OY_TYPE_STD, "lcms",
+                                            oyOPTIONATTRIBUTE_ADVANCED /* |
+                                            oyOPTIONATTRIBUTE_FRONT |
+                                            OY_SELECT_COMMON */, 0 );
+
+  oyOptions_SetFromText( &opts, "cmyk_cmyk_black_preservation", "1", 0 );
+
+  count = oyOptions_Count( opts );
+  if(!count)
+  {
+    PRINT_SUB( oyTESTRESULT_FAIL, 
     "No options found for lcms" );
   } else
   {
@@ -1472,6 +2163,86 @@ oyTESTRESULT_e testProofingEffect ()
   return result;
 }
 
+extern "C" {
+char   oyCMMapiNumberToChar          ( oyOBJECT_e          api_number );
+void   oyRegistrationPatternsReset_  ( void ); }
+
+/* the former oyStringSplit_() based matcher as timing baseline */
+static int testRegistrationMatchSplit_( const char        * registration,
+                                        const char        * pattern,
+                                        oyOBJECT_e          api_number )
+{
+  char ** reg_texts = 0, ** regc_texts = 0, ** p_texts = 0, ** pc_texts = 0;
+  int     reg_texts_n = 0, regc_texts_n = 0, p_texts_n = 0, pc_texts_n = 0;
+  char  * pc_text = 0, * key_tmp = 0;
+  int     match = 0, match_tmp = 1, i,j,k, pc_api_num,
+          api_num = oyCMMapiNumberToChar(api_number);
+  char    pc_match_type = '+';
+
+  reg_texts = oyStringSplit_( registration, OY_SLASH_C, &reg_texts_n,
+                              oyAllocateFunc_);
+  p_texts = oyStringSplit_( pattern, OY_SLASH_C, &p_texts_n, oyAllocateFunc_);
+
+  for( i = 0; i < reg_texts_n && i < p_texts_n; ++i)
+  {
+    if(p_texts_n == 1)
+    {
+      key_tmp = oyFilterRegistrationToText( registration, oyFILTER_REG_MAX,0);
+      regc_texts = oyStringSplit_( key_tmp,'.',&regc_texts_n, oyAllocateFunc_);
+      oyFree_m_( key_tmp );
+      pc_texts = oyStringSplit_( p_texts[i],'.',&pc_texts_n, oyAllocateFunc_);
+      i = reg_texts_n;
+    } else
+    {
+      regc_texts = oyStringSplit_( reg_texts[i],'.',&regc_texts_n,
+                                   oyAllocateFunc_);
+      pc_texts = oyStringSplit_( p_texts[i],'.',&pc_texts_n, oyAllocateFunc_);
+    }
+
+    if(match_tmp && pc_texts_n && regc_texts_n)
+      for( j = 0; j < pc_texts_n && match_tmp >= 0; ++j)
+      {
+        match_tmp = 0;
+        pc_api_num = 0;
+        pc_match_type = '+';
+        pc_text = pc_texts[j];
+        if('4' <= pc_text[0] && pc_text[0] <= '7')
+        {
+          pc_api_num = pc_text[0];
+          pc_match_type = pc_text[1];
+          pc_text += 2;
+        }
+        for( k = 0; k < regc_texts_n; ++k )
+          if((!pc_api_num || api_num == pc_api_num) &&
+             strcmp( regc_texts[k], pc_text ) == 0)
+          {
+            if(pc_match_type == '-')
+              match_tmp = -1;
+            else
+            {
+              ++ match;
+              match_tmp = 1;
+            }
+          }
+        if(pc_match_type == '+' && !match_tmp)
+          match_tmp = -1;
+      }
+
+    oyStringListRelease_( &pc_texts, pc_texts_n, oyDeAllocateFunc_ );
+    oyStringListRelease_( &regc_texts, regc_texts_n, oyDeAllocateFunc_ );
+    if(match_tmp < 0)
+      break;
+  }
+  oyStringListRelease_( &reg_texts, reg_texts_n, oyDeAllocateFunc_ );
+  oyStringListRelease_( &p_texts, p_texts_n, oyDeAllocateFunc_ );
+
+  if(match_tmp < 0)
+    return 0;
+  if(match_tmp == 1 && !match)
+    match = 1;
+  return match;
+}
+
 oyTESTRESULT_e testRegistrationMatch ()
 {
   oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
@@ -1528,6 +2299,100 @@ oyTESTRESULT_e testRegistrationMatch ()
     "special CMM avoiding, other API       " );
   }
 
+  /* a empty level, as from "//", is skipped and does not add to the rank */
+  if( oyFilterRegistrationMatch("//" OY_TYPE_STD "/icc.lcms",
+                                "//" OY_TYPE_STD "/icc",
+                                oyOBJECT_CMM_API4_S ) == 2 &&
+      oyFilterRegistrationMatch("sw/oyranos.org/" OY_TYPE_STD "/icc.lcms",
+                                "//" OY_TYPE_STD "/icc",
+                                oyOBJECT_CMM_API4_S ) == 2 &&
+      oyFilterRegistrationMatch("//" OY_TYPE_STD "/icc.lcms",
+                                "sw//" OY_TYPE_STD "/icc.lcms",
+                                oyOBJECT_CMM_API4_S ) ==
+      testRegistrationMatchSplit_("//" OY_TYPE_STD "/icc.lcms",
+                                "sw//" OY_TYPE_STD "/icc.lcms",
+                                oyOBJECT_CMM_API4_S ))
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "empty level rank                      " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "empty level rank                      " );
+  }
+
+  if( oyFilterRegistrationMatch("org/freedesktop/openicc/config/verbose",
+                                "verbose", oyOBJECT_NONE ) &&
+     !oyFilterRegistrationMatch("org/freedesktop/openicc/config/verbose",
+                                "dirty", oyOBJECT_NONE ))
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "key only selection                    " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "key only selection                    " );
+  }
+
+  {
+    const char * regs[] = {
+      "org/freedesktop/openicc/icc_color/display.icc_profile.abstract._7_lcm2",
+      "sw/oyranos.org/" OY_TYPE_STD "/icc.lcms._CPU._NOACCEL",
+      "org/freedesktop/openicc/behaviour/rendering_intent",
+      "//" OY_TYPE_STD "/config/verbose" },
+         * pats[] = {
+      "verbose", "rendering_intent", "//" OY_TYPE_STD "/icc._CPU",
+      "icc_profile.7_lcm2" };
+    int i, n = 400000, m = 0, m_split = 0;
+    double clck = oyClock(), clck_split;
+
+    for(i = 0; i < n; ++i)
+      m += oyFilterRegistrationMatch( regs[i%4], pats[(i/4)%4],
+                                      oyOBJECT_CMM_API7_S );
+    clck = oyClock() - clck;
+
+    /* before: split both strings on each call */
+    clck_split = oyClock();
+    for(i = 0; i < n; ++i)
+      m_split += testRegistrationMatchSplit_( regs[i%4], pats[(i/4)%4],
+                                              oyOBJECT_CMM_API7_S );
+    clck_split = oyClock() - clck_split;
+
+    if(m && m_split)
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "match %s before %.03f",
+      oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Match"),
+      (double)clck_split/(double)CLOCKS_PER_SEC );
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "oyFilterRegistrationMatch() speed     " );
+    }
+  }
+
+  {
+    /* generated keys overflow the cache and are compared uncached */
+    char reg[64], pat[64];
+    int i, n = 20000, fails = 0;
+
+    for(i = 0; i < n; ++i)
+    {
+      sprintf( reg, "org/freedesktop/openicc/generated/key_%d", i );
+      sprintf( pat, "key_%d", i );
+      if(!oyFilterRegistrationMatch( reg, pat, oyOBJECT_NONE ))
+        ++fails;
+      sprintf( pat, "key_%d", i + 1 );
+      if(oyFilterRegistrationMatch( reg, pat, oyOBJECT_NONE ))
+        ++fails;
+    }
+
+    /* leave a empty cache to the following tests */
+    oyRegistrationPatternsReset_();
+
+    if(!fails)
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "generated keys past the cache         " );
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "generated keys past the cache %d       ", fails );
+    }
+  }
+
   return result;
 }
 
@@ -3724,50 +4589,1510 @@ oyTESTRESULT_e testImagePixel()
   return result;
 }
 
-typedef struct {
-  oyTESTRESULT_e (*oyTestRun)        ( oyTESTRESULT_e    (*test)(void),
-                                       const char        * test_name );
-  const char * title;
-} oyTestRegistration_s;
+/* Build with -fsanitize=thread to let ThreadSanitizer watch the caches. */
+oyTESTRESULT_e testThreadedPixels()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_lab = oyProfile_FromStd( oyEDITING_LAB, NULL );
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  const char * web_name = oyProfile_GetFileName( p_web, -1 );
+  int i, n = 64, fails = 0, threads = 1;
+  uint16_t buf_in[12] = {
+  20000,20000,20000, 10000,10000,10000,
+  0,0,0,             65535,65535,65535
+  };
+  uint16_t buf_ref[12];
+  oyImage_s * input, * output;
+  oyConversion_s * cc;
+  double clck;
 
-oyTestRegistration_s test_registration[100];
+  fprintf(stdout, "\n" );
 
-#define TEST_RUN( prog, text ) { \
-  if(argc > 1) { \
-    if(strcmp("-l", argv[1]) == 0) \
-    { \
-      printf( "%s\n", text); \
-    } else { \
-      for(i = 1; i < argc; ++i) \
-        if(strstr(text, argv[i]) != 0) \
-          oyTestRun( prog, text ); \
-    } \
-  } else \
-    oyTestRun( prog, text ); \
+#if defined(_OPENMP)
+  threads = omp_get_max_threads();
+#endif
+
+  /* single threaded reference */
+  memset( buf_ref, 0, sizeof(uint16_t)*12 );
+  input = oyImage_Create( 2,2, buf_in,
+                          oyChannels_m(3) | oyDataType_m(oyUINT16), p_web, 0 );
+  output = oyImage_Create( 2,2, buf_ref,
+                           oyChannels_m(3) | oyDataType_m(oyUINT16), p_lab, 0 );
+  cc = oyConversion_CreateBasicPixels( input,output, 0, 0 );
+  oyConversion_RunPixels( cc, 0 );
+  oyConversion_Release( &cc );
+  oyImage_Release( &input );
+  oyImage_Release( &output );
+
+  /* each thread builds its own graph from the shared profiles and
+   * loads the input profile again through the profile file cache */
+  clck = oyClock();
+#pragma omp parallel for private(i) reduction(+:fails)
+  for(i = 0; i < n; ++i)
+  {
+    uint16_t buf_out[12];
+    oyProfile_s * p_in = oyProfile_FromFile( web_name, 0, 0 );
+    oyImage_s * in, * out;
+    oyConversion_s * c;
+    int j, error;
+
+    memset( buf_out, 0, sizeof(uint16_t)*12 );
+    in = oyImage_Create( 2,2, buf_in,
+                         oyChannels_m(3) | oyDataType_m(oyUINT16), p_in, 0 );
+    out = oyImage_Create( 2,2, buf_out,
+                          oyChannels_m(3) | oyDataType_m(oyUINT16), p_lab, 0 );
+    c = oyConversion_CreateBasicPixels( in,out, 0, 0 );
+    error = !c;
+
+    for(j = 0; j < 100 && !error; ++j)
+      error = oyConversion_RunPixels( c, 0 );
+
+    if(error || memcmp( buf_out, buf_ref, sizeof(uint16_t)*12 ) != 0)
+      ++fails;
+
+    oyConversion_Release( &c );
+    oyImage_Release( &in );
+    oyImage_Release( &out );
+    oyProfile_Release( &p_in );
+  }
+  clck = oyClock() - clck;
+
+  if( !fails )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyConversion_RunPixels() %d threads        %s", threads,
+               oyProfilingToString(4*100*n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyConversion_RunPixels() %d threads %d/%d failed   ", threads, fails, n );
+  }
+
+  oyProfile_Release( &p_lab );
+  oyProfile_Release( &p_web );
+
+  return result;
 }
 
-/*  main */
-int main(int argc, char** argv)
+oyTESTRESULT_e testImageAlpha()
 {
-  int i, error;
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  oyProfile_s * p_lab = oyProfile_FromStd( oyEDITING_LAB, NULL );
+  int error = 0,
+      i, j, n = 10,
+      w = 1024, h = 256,
+      pixel_n = w * h;
+  uint8_t * buf_8in = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 4 ),
+          * buf_8out = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 4 );
+  uint16_t * buf_16in = (uint16_t*) calloc( sizeof(uint16_t), pixel_n * 4 ),
+           * buf_16out = (uint16_t*) calloc( sizeof(uint16_t), pixel_n * 4 );
+  double clck;
+  int fail = 0;
 
-  if(getenv("OYRANOS_DEBUG"))
+  fprintf(stdout, "\n" );
+
+  for(i = 0; i < pixel_n; ++i)
   {
-    int value = atoi(getenv("OYRANOS_DEBUG"));
-    if(value > 0)
-      oy_debug += value;
+    buf_8in[i*4+0] = buf_8in[i*4+1] = buf_8in[i*4+2] = i%256;
+    buf_8in[i*4+3] = (i/3)%256;
+    buf_16in[i*4+0] = buf_16in[i*4+1] = buf_16in[i*4+2] = (i*7)%65536;
+    buf_16in[i*4+3] = (i*13)%65536;
   }
 
-  /* init */
-  for(i = 0; i <= oyTESTRESULT_UNKNOWN; ++i)
-    results[i] = 0;
+  /* 8-bit alpha copy */
+  clck = oyClock();
+  for(j = 0; j < n; ++j)
+    for(i = 0; i < h; ++i)
+      error = oyPixelAlphaCopy( &buf_8in[i*w*4], OY_TYPE_123A_8, 3,
+                                &buf_8out[i*w*4], OY_TYPE_123A_8, 3, w );
+  clck = oyClock() - clck;
+  for(i = 0; i < pixel_n; ++i)
+    if(buf_8out[i*4+3] != buf_8in[i*4+3] || buf_8out[i*4+0] != 0)
+      ++fail;
+  if( !error && !fail )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyPixelAlphaCopy() RGBA 8-bit            %s",
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyPixelAlphaCopy() RGBA 8-bit     %d failed", fail );
+  }
 
-  fprintf( stderr, "\nOyranos Tests v" OYRANOS_VERSION_NAME
-           "  developed: " OYRANOS_DATE  "\n   git id:" OYRANOS_GIT_MASTER
-           "  configured: " OYRANOS_CONFIG_DATE "\n\n" );
+  /* 16-bit -> 8-bit alpha copy, the typical display path */
+  fail = 0;
+  clck = oyClock();
+  for(j = 0; j < n; ++j)
+    for(i = 0; i < h; ++i)
+      error = oyPixelAlphaCopy( &buf_16in[i*w*4], OY_TYPE_123A_16, 3,
+                                &buf_8out[i*w*4], OY_TYPE_123A_8, 3, w );
+  clck = oyClock() - clck;
+  for(i = 0; i < pixel_n; ++i)
+    if(buf_8out[i*4+3] != (uint8_t)(buf_16in[i*4+3]/257.0 + 0.5))
+      ++fail;
+  if( !error && !fail )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyPixelAlphaCopy() RGBA 16->8-bit        %s",
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyPixelAlphaCopy() RGBA 16->8-bit %d failed", fail );
+  }
 
+  /* premultiply and back */
+  fail = 0;
+  memcpy( buf_16out, buf_16in, sizeof(uint16_t) * pixel_n * 4 );
+  clck = oyClock();
+  for(i = 0; i < h; ++i)
+  {
+    oyPixelAlphaMultiply( &buf_16out[i*w*4], OY_TYPE_123A_16, 3, w, 0 );
+    error = oyPixelAlphaMultiply( &buf_16out[i*w*4], OY_TYPE_123A_16, 3, w, 1);
+  }
+  clck = oyClock() - clck;
+  for(i = 0; i < pixel_n; ++i)
+    /* premultiplication looses precission with low alpha */
+    if(buf_16in[i*4+3] > 4096 &&
+       abs(buf_16out[i*4+0] - buf_16in[i*4+0]) > 65535/buf_16in[i*4+3] + 1)
+      ++fail;
+  if( !error && !fail )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyPixelAlphaMultiply() RGBA 16-bit       %s",
+                          oyProfilingToString(2*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyPixelAlphaMultiply() RGBA 16-bit %d failed", fail );
+  }
 
-  /* do tests */
+  /* alpha shall pass a colour conversion unchanged */
+  oyImage_s * input = oyImage_Create( w, h, buf_16in, OY_TYPE_123A_16, p_web, 0),
+            * output = oyImage_Create( w, h, buf_16out, OY_TYPE_123A_16, p_lab,0);
+  oyConversion_s * cc = oyConversion_CreateBasicPixels( input, output, 0, 0 );
+  fail = 0;
+  memset( buf_16out, 0, sizeof(uint16_t) * pixel_n * 4 );
+  clck = oyClock();
+  for(j = 0; j < n; ++j)
+    if(cc)
+      error = oyConversion_RunPixels( cc, 0 );
+  clck = oyClock() - clck;
+  for(i = 0; i < pixel_n; ++i)
+    if(buf_16out[i*4+3] != buf_16in[i*4+3])
+      ++fail;
+  if( cc && !error && !fail )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "RGBA 16-bit conversion alpha passthrough %s",
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "RGBA 16-bit conversion alpha passthrough %d failed", fail );
+  }
+  oyConversion_Release( &cc );
+  oyImage_Release( &input );
+  oyImage_Release( &output );
+
+  input = oyImage_Create( w, h, buf_8in, OY_TYPE_123A_8, p_web, 0);
+  output = oyImage_Create( w, h, buf_8out, OY_TYPE_123A_8, p_lab,0);
+  cc = oyConversion_CreateBasicPixels( input, output, 0, 0 );
+  fail = 0;
+  memset( buf_8out, 0, sizeof(uint8_t) * pixel_n * 4 );
+  clck = oyClock();
+  for(j = 0; j < n; ++j)
+    if(cc)
+      error = oyConversion_RunPixels( cc, 0 );
+  clck = oyClock() - clck;
+  for(i = 0; i < pixel_n; ++i)
+    if(buf_8out[i*4+3] != buf_8in[i*4+3])
+      ++fail;
+  if( cc && !error && !fail )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "RGBA 8-bit conversion alpha passthrough  %s",
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "RGBA 8-bit conversion alpha passthrough  %d failed", fail );
+  }
+  oyConversion_Release( &cc );
+  oyImage_Release( &input );
+  oyImage_Release( &output );
+
+  oyProfile_Release( &p_web );
+  oyProfile_Release( &p_lab );
+  free( buf_8in ); free( buf_8out );
+  free( buf_16in ); free( buf_16out );
+
+  return result;
+}
+
+oyTESTRESULT_e testImageDither()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  oyOptions_s * options = 0;
+  int error = 0,
+      i, j, n = 10,
+      w = 1024, h = 256,
+      pixel_n = w * h,
+      levels[2] = {0,0};
+  uint16_t * buf_16in = (uint16_t*) calloc( sizeof(uint16_t), pixel_n * 3 );
+  uint8_t * buf_8out = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 );
+  double clck, mean = 0.0;
+
+  fprintf(stdout, "\n" );
+
+  /* a value between two 8-bit steps */
+  for(i = 0; i < pixel_n * 3; ++i)
+    buf_16in[i] = 257 * 100 + 128;
+
+  clck = oyClock();
+  for(j = 0; j < n; ++j)
+    for(i = 0; i < h; ++i)
+      error = oyPixelDither16To8( &buf_16in[i*w*3], &buf_8out[i*w*3], 3, w,
+                                  0, i );
+  clck = oyClock() - clck;
+
+  for(i = 0; i < pixel_n * 3; ++i)
+  {
+    mean += buf_8out[i];
+    if(buf_8out[i] == 100) ++levels[0];
+    if(buf_8out[i] == 101) ++levels[1];
+  }
+  mean /= pixel_n * 3;
+  if( !error && levels[0] && levels[1] &&
+      levels[0] + levels[1] == pixel_n * 3 && fabs(mean - 100.5) < 0.01 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyPixelDither16To8() RGB                 %s",
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyPixelDither16To8() RGB mean: %g", mean );
+  }
+
+  /* dithering inside the ICC node */
+  oyImage_s * input = oyImage_Create( w, h, buf_16in, OY_TYPE_123_16, p_web, 0),
+            * output = oyImage_Create( w, h, buf_8out, OY_TYPE_123_8, p_web, 0);
+  error = oyOptions_SetFromText( &options, "//" OY_TYPE_STD "/icc/dither",
+                                 "1", OY_CREATE_NEW );
+  oyConversion_s * cc = oyConversion_CreateBasicPixels( input, output,
+                                                        options, 0 );
+  memset( buf_8out, 0, sizeof(uint8_t) * pixel_n * 3 );
+  levels[0] = levels[1] = 0;
+  clck = oyClock();
+  for(j = 0; j < n; ++j)
+    if(cc)
+      error = oyConversion_RunPixels( cc, 0 );
+  clck = oyClock() - clck;
+  for(i = 0; i < pixel_n * 3; ++i)
+  {
+    if(buf_8out[i] == 100) ++levels[0];
+    if(buf_8out[i] == 101) ++levels[1];
+  }
+  if( cc && !error && levels[0] && levels[1] )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "RGB 16->8-bit conversion dithered        %s",
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "RGB 16->8-bit conversion dithered %d/%d", levels[0], levels[1] );
+  }
+
+  oyConversion_Release( &cc );
+  oyImage_Release( &input );
+  oyImage_Release( &output );
+  oyOptions_Release( &options );
+  oyProfile_Release( &p_web );
+  free( buf_16in ); free( buf_8out );
+
+  return result;
+}
+
+oyTESTRESULT_e testImageScale()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, j, k, n = 10,
+      w = 1024, h = 512,
+      pixel_n = w * h,
+      flat = 0;
+  uint8_t * buf_in = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 );
+  uint8_t * buf_out = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 );
+  const char * methods[3] = {"box","bilinear","Lanczos3"};
+  double clck, mean;
+
+  fprintf(stdout, "\n" );
+
+  /* a one pixel wide line pattern averages to a flat grey */
+  for(i = 0; i < h; ++i)
+    for(j = 0; j < w * 3; ++j)
+      buf_in[i*w*3 + j] = (j/3) % 2 ? 200 : 100;
+
+  for(k = 0; k < 3; ++k)
+  {
+    oyConversion_s * s = oyConversion_New( 0 );
+    oyFilterNode_s * in = 0, * out = 0;
+    oyOptions_s * options = 0;
+    oyImage_s * input = oyImage_Create( w, h, buf_in, OY_TYPE_123_8, p_web,0),
+              * output = oyImage_Create( w/2, h/2, buf_out, OY_TYPE_123_8,
+                                         p_web, 0 );
+
+    in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/root", 0, 0 );
+    error = oyConversion_Set( s, in, 0 );
+    error = oyFilterNode_DataSet( in, (oyStruct_s*)input, 0, 0 );
+
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/scale", 0, 0 );
+    options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+    error = oyOptions_SetFromDouble( &options, "//" OY_TYPE_STD "/scale/scale",
+                                     0.5, 0, OY_CREATE_NEW );
+    error = oyOptions_SetFromInt( &options, "//" OY_TYPE_STD "/scale/method",
+                                  k, 0, OY_CREATE_NEW );
+    oyOptions_Release( &options );
+    error = oyFilterNode_DataSet( out, (oyStruct_s*)output, 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    in = out;
+
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/output", 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    error = oyConversion_Set( s, 0, out );
+
+    memset( buf_out, 0, sizeof(uint8_t) * pixel_n * 3 );
+    clck = oyClock();
+    for(j = 0; j < n; ++j)
+      error = oyConversion_RunPixels( s, 0 );
+    clck = oyClock() - clck;
+
+    mean = 0.0;
+    flat = 0;
+    for(i = 0; i < pixel_n * 3 / 4; ++i)
+    {
+      mean += buf_out[i];
+      if(buf_out[i] == 150) ++flat;
+    }
+    mean /= pixel_n * 3 / 4;
+
+    /* box filtering hits the pattern exactly; the others ring at the edges */
+    if( !error && fabs(mean - 150.0) < 1.0 &&
+        (k || flat == pixel_n * 3 / 4) )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "scale 0.5 %-8s RGB 8-bit            %s", methods[k],
+                          oyProfilingToString(n*pixel_n/4,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "scale 0.5 %-8s RGB 8-bit mean: %g", methods[k], mean );
+    }
+
+    oyConversion_Release( &s );
+    oyImage_Release( &input );
+    oyImage_Release( &output );
+  }
+
+  oyProfile_Release( &p_web );
+  free( buf_in ); free( buf_out );
+
+  return result;
+}
+
+oyTESTRESULT_e testImageDisplayDamage()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, j, k, x, y,
+      w = 128, h = 64,
+      wrong = 0, damage_left = 0;
+  uint8_t * buf_in = (uint8_t*) calloc( sizeof(uint8_t), w * h * 3 ),
+          * buf_out = (uint8_t*) calloc( sizeof(uint8_t), w * h * 3 );
+  /* two separate damaged regions in pixels: x, y, width, height */
+  int damage[2][4] = {{8,8,16,16}, {64,32,32,16}};
+  oyImage_s * image_in = 0, * image_out = 0;
+  oyConversion_s * s = oyConversion_New( 0 );
+  oyFilterNode_s * in = 0, * out = 0;
+  oyOptions_s * options = 0;
+
+  fprintf(stdout, "\n" );
+
+  memset( buf_in, 200, w * h * 3 );
+  image_in = oyImage_Create( w, h, buf_in, OY_TYPE_123_8, p_web, 0 );
+  image_out = oyImage_CreateForDisplay( w, h, buf_out, OY_TYPE_123_8, 0,
+                                        0,0, w,h, 0 );
+
+  in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/root", 0, 0 );
+  error = oyConversion_Set( s, in, 0 );
+  error = oyFilterNode_DataSet( in, (oyStruct_s*)image_in, 0, 0 );
+
+  out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/icc", 0, 0 );
+  error = oyFilterNode_DataSet( out, (oyStruct_s*)image_out, 0, 0 );
+  error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                out, "//" OY_TYPE_STD "/data", 0 );
+  in = out;
+
+  out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/display", 0, 0 );
+  options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+  error = oyOptions_SetFromInt( &options,
+                                "//" OY_TYPE_STD "/display/datatype",
+                                oyUINT8, 0, OY_CREATE_NEW );
+  oyOptions_Release( &options );
+  error = oyFilterNode_DataSet( out, (oyStruct_s*)image_out, 0, 0 );
+  error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                out, "//" OY_TYPE_STD "/data", 0 );
+  in = out;
+
+  out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/output", 0, 0 );
+  error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                out, "//" OY_TYPE_STD "/data", 0 );
+  error = oyConversion_Set( s, 0, out );
+
+  /* the first runs set up the monitor profiles */
+  for(i = 0; i < 3; ++i)
+    if((error = oyConversion_RunPixels( s, 0 )) <= 0)
+      break;
+
+  if(error > 0)
+  { PRINT_SUB( oyTESTRESULT_XFAIL,
+    "no display device for the damage test            " );
+  } else
+  {
+    /* forget the full conversion and mark two regions as damaged */
+    memset( buf_out, 0, w * h * 3 );
+    for(k = 0; k < 2; ++k)
+    {
+      oyRectangle_s * r = oyRectangle_NewWith( damage[k][0], damage[k][1],
+                                               damage[k][2], damage[k][3], 0 );
+      error = oyOptions_MoveInStruct( &image_out->tags,
+                                      "//" OY_TYPE_STD "/display/damage",
+                                      (oyStruct_s**)&r, OY_ADD_ALWAYS );
+    }
+
+    error = oyConversion_RunPixels( s, 0 );
+
+    /* converted pixels must appear inside the damage only; leave one pixel
+     * at the borders for rounding of the relative rectangles */
+    for(y = 0; y < h; ++y)
+      for(x = 0; x < w; ++x)
+      {
+        int inside = 0, border = 0;
+        for(k = 0; k < 2; ++k)
+        {
+          int * d = damage[k];
+          if(x >= d[0] && x < d[0] + d[2] && y >= d[1] && y < d[1] + d[3])
+            inside = 1;
+          if(x >= d[0] - 1 && x <= d[0] + d[2] &&
+             y >= d[1] - 1 && y <= d[1] + d[3] &&
+             (x <= d[0] || x >= d[0] + d[2] - 1 ||
+              y <= d[1] || y >= d[1] + d[3] - 1))
+            border = 1;
+        }
+        if(border)
+          continue;
+        for(j = 0; j < 3; ++j)
+          if((buf_out[(y * w + x) * 3 + j] != 0) != inside)
+          {
+            ++wrong;
+            break;
+          }
+      }
+
+    damage_left = oyOptions_CountType( image_out->tags,
+                                       "//" OY_TYPE_STD "/display/damage",
+                                       oyOBJECT_RECTANGLE_S );
+
+    if( !error && !wrong )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "display converts only the 2 damaged regions      " );
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "display converts only the 2 damaged regions: %d px", wrong );
+    }
+
+    if( !damage_left )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "display damage tags cleared                      " );
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "display damage tags cleared: %d left             ", damage_left );
+    }
+  }
+
+  oyConversion_Release( &s );
+  oyImage_Release( &image_in );
+  oyImage_Release( &image_out );
+  oyProfile_Release( &p_web );
+  free( buf_in ); free( buf_out );
+
+  return result;
+}
+
+oyTESTRESULT_e testImagePyramid()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  oyImage_s * image = oyImage_Create( 512, 256, 0, OY_TYPE_123_8, p_web, 0 ),
+            * level1 = oyImage_Create( 256, 128, 0, OY_TYPE_123_8, p_web, 0 ),
+            * level2 = oyImage_Create( 128, 64, 0, OY_TYPE_123_8, p_web, 0 ),
+            * cached = 0;
+  int error = 0, i, n = 10000;
+  double clck;
+
+  fprintf(stdout, "\n" );
+
+  error = oyImage_PyramidLevelSet( image, "link-a", 1, level1 );
+  if(!error)
+    error = oyImage_PyramidLevelSet( image, "link-a", 2, level2 );
+
+  cached = oyImage_PyramidLevelGet( image, "link-a", 2 );
+  if( !error && cached && cached->width == 128 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_PyramidLevelGet() level 2                     " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_PyramidLevelGet() level 2                     " );
+  }
+  oyImage_Release( &cached );
+
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    cached = oyImage_PyramidLevelGet( image, "link-a", 1 );
+    oyImage_Release( &cached );
+  }
+  clck = oyClock() - clck;
+  PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_PyramidLevelGet() hit               %s",
+                          oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Look"));
+
+  /* a other device link invalidates all levels */
+  cached = oyImage_PyramidLevelGet( image, "link-b", 1 );
+  error = oyImage_PyramidLevelSet( image, "link-b", 2, level2 );
+  if( !cached && !error &&
+      !(cached = oyImage_PyramidLevelGet( image, "link-a", 2 )) &&
+      !(cached = oyImage_PyramidLevelGet( image, "link-b", 1 )) )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_PyramidLevelSet() new hash invalidates        " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_PyramidLevelSet() new hash invalidates        " );
+  }
+  oyImage_Release( &cached );
+
+  error = oyImage_PyramidClear( image );
+  cached = oyImage_PyramidLevelGet( image, "link-b", 2 );
+  if( !error && !cached )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_PyramidClear()                                " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_PyramidClear()                                " );
+  }
+  oyImage_Release( &cached );
+
+  oyImage_Release( &level2 );
+  oyImage_Release( &level1 );
+  oyImage_Release( &image );
+  oyProfile_Release( &p_web );
+
+  return result;
+}
+
+static uint8_t * test_tiles_buf = 0;
+static int test_tiles_requested = 0;
+#define TEST_TILES_W 300
+#define TEST_TILES_H 200
+#define TEST_TILE_SIZE 64
+
+/* a allocated tile with the rows behind the row array */
+oyPointer * testTilesGetTile         ( oyImage_s         * image,
+                                       int                 tile_x,
+                                       int                 tile_y,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  int ts = TEST_TILE_SIZE, i,
+      x = tile_x * ts,
+      w = x + ts > TEST_TILES_W ? TEST_TILES_W - x : ts;
+  oyPointer * tile = (oyPointer*) image->oy_->allocateFunc_(
+                                      ts * sizeof(oyPointer) + ts * ts * 3 );
+  uint8_t * rows = (uint8_t*)&tile[ts];
+
+  for(i = 0; i < ts; ++i)
+  {
+    int y = tile_y * ts + i;
+    tile[i] = &rows[i * ts * 3];
+    if(y < TEST_TILES_H)
+      memcpy( tile[i], &test_tiles_buf[(y * TEST_TILES_W + x) * 3], w * 3 );
+  }
+
+  ++test_tiles_requested;
+  *is_allocated = 1;
+  return tile;
+}
+
+oyPointer testTilesGetPoint          ( oyImage_s         * image,
+                                       int                 point_x,
+                                       int                 point_y,
+                                       int                 channel,
+                                       int               * is_allocated )
+{
+  *is_allocated = 0;
+  return &test_tiles_buf[(point_y * TEST_TILES_W + point_x) * 3];
+}
+
+oyTESTRESULT_e testImageTiles()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0, i, j, k, n = 100,
+      w = TEST_TILES_W, h = TEST_TILES_H,
+      matches = 1, requested;
+  oyImage_s * image = 0;
+  oyArray2d_s * a = 0;
+  oyRectangle_s roi = {oyOBJECT_RECTANGLE_S, 0,0,0};
+  double clck;
+
+  fprintf(stdout, "\n" );
+
+  test_tiles_buf = (uint8_t*) calloc( sizeof(uint8_t), w * h * 3 );
+  for(i = 0; i < w * h * 3; ++i)
+    test_tiles_buf[i] = (uint8_t)(i * 7 + i / (w*3));
+
+  image = oyImage_CreateFromData( w, h, OY_TYPE_123_8, p_web, 0,
+                                  0, 0, testTilesGetTile, 0, 0, 0, 0 );
+  if(image)
+  {
+    image->tile_width = TEST_TILE_SIZE;
+    image->tile_height = TEST_TILE_SIZE;
+  }
+
+  /* a area over four tiles */
+  oyRectangle_SetGeo( &roi, 40.0/w, 40.0/w, 60.0/w, 50.0/w );
+  test_tiles_requested = 0;
+  error = oyImage_FillArray( image, &roi, 1, &a, 0, 0 );
+  requested = test_tiles_requested;
+  for(i = 0; !error && a && i < 50; ++i)
+    if(memcmp( a->array2d[i], &test_tiles_buf[((40 + i) * w + 40) * 3],
+               60 * 3 ))
+      matches = 0;
+
+  if( !error && a && matches && requested == 4 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_FillArray() getTile            %d tiles", requested );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_FillArray() getTile            %d tiles", requested );
+  }
+
+  /* the same tiles come from the cache */
+  clck = oyClock();
+  for(k = 0; k < n; ++k)
+    error = oyImage_FillArray( image, &roi, 1, &a, 0, 0 );
+  clck = oyClock() - clck;
+  if( !error && test_tiles_requested == requested )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_FillArray() tile cache %s",
+                        oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Area"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_FillArray() tile cache %d tiles", test_tiles_requested );
+  }
+  oyArray2d_Release( &a );
+  oyImage_Release( &image );
+
+  /* point only source */
+  image = oyImage_CreateFromData( w, h, OY_TYPE_123_8, p_web, 0,
+                                  testTilesGetPoint, 0, 0, 0, 0, 0, 0 );
+  oyRectangle_SetGeo( &roi, 0,0, 1.0, (double)h/w );
+  error = oyImage_FillArray( image, &roi, 1, &a, 0, 0 );
+  for(j = 0; !error && a && j < h; ++j)
+    if(memcmp( a->array2d[j], &test_tiles_buf[j * w * 3], w * 3 ))
+      matches = 0;
+  if( !error && a && matches )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_FillArray() getPoint                   " );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_FillArray() getPoint                   " );
+  }
+  oyArray2d_Release( &a );
+  oyImage_Release( &image );
+
+  oyProfile_Release( &p_web );
+  free( test_tiles_buf ); test_tiles_buf = 0;
+
+  return result;
+}
+
+oyTESTRESULT_e testImageMapped()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, w = 2048, h = 1024,
+      pixel_n = w * h, diff = 0;
+  uint8_t * buf_8 = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 ),
+          * body = 0;
+  const char * file_name = "test_mapped.pam";
+  char * header = 0;
+  oyImage_s * input = 0, * output = 0;
+  oyConversion_s * s = 0;
+  double clck;
+  size_t size = 0, header_size;
+  FILE * fp;
+
+  fprintf(stdout, "\n" );
+
+  for(i = 0; i < pixel_n * 3; ++i)
+    buf_8[i] = i % 251;
+
+  oyStringAddPrintf_( &header, oyAllocateFunc_, oyDeAllocateFunc_,
+                      "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 3\nMAXVAL 255\n"
+                      "TUPLTYPE RGB\nENDHDR\n", w, h );
+  header_size = strlen( header );
+
+  clck = oyClock();
+  input = oyImage_Create( w, h, buf_8, OY_TYPE_123_8, p_web, 0 );
+  output = oyImage_CreateMapped( file_name, w, h, header, OY_TYPE_123_8,
+                                 p_web, 0 );
+  if(!output)
+    error = 1;
+  if(!error)
+    s = oyConversion_CreateBasicPixels( input, output, 0, 0 );
+  if(s)
+    error = oyConversion_RunPixels( s, 0 );
+  else
+    error = 1;
+  oyConversion_Release( &s );
+  oyImage_Release( &input );
+  oyImage_Release( &output );
+  clck = oyClock() - clck;
+
+  /* the file is written by now */
+  fp = fopen( file_name, "rb" );
+  if(fp)
+  {
+    fseek( fp, 0, SEEK_END );
+    size = ftell( fp );
+    rewind( fp );
+    body = (uint8_t*) malloc( size );
+    if(fread( body, 1, size, fp ) != size)
+      error = 1;
+    fclose( fp );
+  }
+
+  if(!error && body && size == header_size + pixel_n * 3)
+    for(i = 0; i < pixel_n * 3; ++i)
+      if(abs(body[header_size + i] - buf_8[i]) > diff)
+        diff = abs(body[header_size + i] - buf_8[i]);
+
+  if( !error && size == header_size + pixel_n * 3 &&
+      memcmp( body, header, header_size ) == 0 && diff <= 1 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "oyImage_CreateMapped() %.01f MB         %s", size / 1000000.0,
+                          oyProfilingToString(pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "oyImage_CreateMapped() %d %d                    ", (int)size, diff );
+  }
+
+  remove( file_name );
+  if(body) free( body );
+  oyDeAllocateFunc_( header );
+  oyProfile_Release( &p_web );
+  free( buf_8 );
+
+  return result;
+}
+
+oyTESTRESULT_e testImagePpmWrite()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, j, n = 3,
+      w = 2048, h = 1024,
+      pixel_n = w * h;
+  uint16_t * buf_16 = (uint16_t*) calloc( sizeof(uint16_t), pixel_n * 3 );
+  uint8_t * buf_8 = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 );
+  const char * file_name = "test_ppm_write.ppm";
+  double clck;
+  size_t size = 0;
+  FILE * fp;
+
+  fprintf(stdout, "\n" );
+
+  for(i = 0; i < pixel_n * 3; ++i)
+  {
+    buf_16[i] = 0x0102;
+    buf_8[i] = i % 256;
+  }
+
+  oyImage_s * image16 = oyImage_Create( w, h, buf_16, OY_TYPE_123_16, p_web,0),
+            * image8 = oyImage_Create( w, h, buf_8, OY_TYPE_123_8, p_web, 0);
+
+  for(j = 0; j < 2; ++j)
+  {
+    oyImage_s * image = j ? image8 : image16;
+    int byteps = j ? 1 : 2;
+    uint8_t tail[2] = {0,0};
+
+    clck = oyClock();
+    for(i = 0; i < n; ++i)
+      error = oyImage_PpmWrite( image, file_name, "benchmark" );
+    clck = oyClock() - clck;
+
+    /* the last samples must appear in big endian order */
+    fp = fopen( file_name, "rb" );
+    if(fp)
+    {
+      fseek( fp, 0, SEEK_END );
+      size = ftell( fp );
+      fseek( fp, -2, SEEK_END );
+      if(fread( tail, 1, 2, fp ) != 2)
+        error = 1;
+      fclose( fp );
+    }
+
+    if( !error && size > (size_t)pixel_n * 3 * byteps &&
+        (j ? tail[1] == (pixel_n * 3 - 1) % 256 :
+             (tail[0] == 0x01 && tail[1] == 0x02)) )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "oyImage_PpmWrite() %2d-bit %.01f MB      %s", byteps * 8,
+                          n * size / 1000000.0,
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "oyImage_PpmWrite() %2d-bit                      ", byteps * 8 );
+    }
+  }
+
+  remove( file_name );
+  oyImage_Release( &image16 );
+  oyImage_Release( &image8 );
+  oyProfile_Release( &p_web );
+  free( buf_16 ); free( buf_8 );
+
+  return result;
+}
+
+oyTESTRESULT_e testImagePpmWriteStrips()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, y, mismatch = 0,
+      /* 100 lines do not divide into strips of 16 */
+      w = 64, h = 100, strip_height = 16;
+  uint8_t * buf_8 = (uint8_t*) calloc( sizeof(uint8_t), w * h * 3 );
+  const char * file_name = "test_ppm_strips.ppm";
+  oyImage_s * image = 0, * image_in = 0;
+  oyArray2d_s * a = 0;
+  oyRectangle_s roi = {oyOBJECT_RECTANGLE_S, 0,0,0};
+  oyConversion_s * s = 0;
+  oyFilterNode_s * in = 0, * out = 0;
+  oyOptions_s * options = 0;
+
+  fprintf(stdout, "\n" );
+
+  /* each line holds its number, each sample its position */
+  for(i = 0; i < w * h * 3; ++i)
+    buf_8[i] = (uint8_t)(i / (w * 3) + i % (w * 3));
+
+  image = oyImage_Create( w, h, buf_8, OY_TYPE_123_8, p_web, 0 );
+
+  s = oyConversion_New( 0 );
+  in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/root", 0, 0 );
+  error = oyConversion_Set( s, in, 0 );
+  error = oyFilterNode_DataSet( in, (oyStruct_s*)image, 0, 0 );
+
+  out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/write_ppm", 0, 0 );
+  options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+  error = oyOptions_SetFromText( &options,
+                                 "//" OY_TYPE_STD "/file_write/filename",
+                                 file_name, OY_CREATE_NEW );
+  error = oyOptions_SetFromInt( &options,
+                                "//" OY_TYPE_STD "/file_write/strip_height",
+                                strip_height, 0, OY_CREATE_NEW );
+  oyOptions_Release( &options );
+  error = oyFilterNode_DataSet( out, (oyStruct_s*)image, 0, 0 );
+  error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                out, "//" OY_TYPE_STD "/data", 0 );
+  in = out;
+
+  out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/output", 0, 0 );
+  error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                out, "//" OY_TYPE_STD "/data", 0 );
+  error = oyConversion_Set( s, 0, out );
+
+  error = oyConversion_RunPixels( s, 0 );
+  oyConversion_Release( &s );
+
+  /* read the file back and compare all lines, the short last strip too */
+  s = oyConversion_New( 0 );
+  in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/input_ppm", 0, 0 );
+  options = oyFilterNode_OptionsGet( in, OY_SELECT_FILTER );
+  error = oyOptions_SetFromText( &options,
+                                 "//" OY_TYPE_STD "/file_read/filename",
+                                 file_name, OY_CREATE_NEW );
+  oyOptions_Release( &options );
+  error = oyConversion_Set( s, in, 0 );
+
+  image_in = oyConversion_GetImage( s, OY_INPUT );
+  oyRectangle_SetGeo( &roi, 0, 0, 1.0, h / (double)w );
+  if(image_in && image_in->width == w && image_in->height == h)
+    error = oyImage_FillArray( image_in, &roi, 1, &a, 0, 0 );
+  else
+    error = 1;
+
+  if(!error && a)
+    for(y = 0; y < h; ++y)
+      if(memcmp( a->array2d[y], &buf_8[y * w * 3], w * 3 ))
+        ++mismatch;
+
+  if( !error && a && !mismatch )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "PPM write %dx%d in %d line strips      ", w, h, strip_height );
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "PPM write %dx%d in %d line strips: %d lines differ", w, h,
+                          strip_height, mismatch );
+  }
+
+  remove( file_name );
+  oyArray2d_Release( &a );
+  oyImage_Release( &image_in );
+  oyConversion_Release( &s );
+  oyImage_Release( &image );
+  oyProfile_Release( &p_web );
+  free( buf_8 );
+
+  return result;
+}
+
+oyTESTRESULT_e testImagePpmRead()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, n = 20,
+      w = 2048, h = 1024,
+      pixel_n = w * h;
+  uint16_t * buf_16 = (uint16_t*) calloc( sizeof(uint16_t), pixel_n * 3 );
+  const char * file_name = "test_ppm_read.ppm";
+  double clck, clck_roi = 0;
+  oyImage_s * image = 0;
+  oyArray2d_s * a = 0;
+  oyRectangle_s roi = {oyOBJECT_RECTANGLE_S, 0,0,0};
+  uint16_t v = 0;
+
+  fprintf(stdout, "\n" );
+
+  /* each line holds its number */
+  for(i = 0; i < pixel_n * 3; ++i)
+    buf_16[i] = i / (w * 3);
+
+  image = oyImage_Create( w, h, buf_16, OY_TYPE_123_16, p_web, 0 );
+  error = oyImage_PpmWrite( image, file_name, "test" );
+  oyImage_Release( &image );
+
+  /* a 64x64 region from the middle of the image */
+  oyRectangle_SetGeo( &roi, 1000.0/w, 700.0/w, 64.0/w, 64.0/w );
+
+  clck = oyClock();
+  for(i = 0; i < n; ++i)
+  {
+    oyConversion_s * s = oyConversion_New( 0 );
+    oyFilterNode_s * in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/input_ppm",
+                                                0, 0 );
+    oyOptions_s * options = oyFilterNode_OptionsGet( in, OY_SELECT_FILTER );
+    double roi_start;
+
+    error = oyOptions_SetFromText( &options,
+                                   "//" OY_TYPE_STD "/file_read/filename",
+                                   file_name, OY_CREATE_NEW );
+    oyOptions_Release( &options );
+    error = oyConversion_Set( s, in, 0 );
+
+    image = oyConversion_GetImage( s, OY_INPUT );
+
+    roi_start = oyClock();
+    if(image)
+      error = oyImage_FillArray( image, &roi, 1, &a, 0, 0 );
+    else
+      error = 1;
+    clck_roi += oyClock() - roi_start;
+
+    if(!error && a)
+      v = ((uint16_t*)a->array2d[0])[0];
+
+    oyArray2d_Release( &a );
+    oyImage_Release( &image );
+    oyConversion_Release( &s );
+  }
+  clck = oyClock() - clck;
+
+  if( !error && v == 700 )
+  { PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "open %dx%d RGB 16-bit PPM        %s", w, h,
+                          oyProfilingToString(n,(clck - clck_roi)/(double)CLOCKS_PER_SEC, "Open"));
+    PRINT_SUB( oyTESTRESULT_SUCCESS,
+    "read 64x64 ROI                    %s",
+                          oyProfilingToString(n*64*64,clck_roi/(double)CLOCKS_PER_SEC, "Pixel"));
+  } else
+  { PRINT_SUB( oyTESTRESULT_FAIL,
+    "PPM ROI read: %d                 ", v );
+  }
+
+  remove( file_name );
+  oyProfile_Release( &p_web );
+  free( buf_16 );
+
+  return result;
+}
+
+oyTESTRESULT_e testImageFileSniff()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, k, n = 50,
+      w = 64, h = 32, found;
+  uint8_t * buf_8 = (uint8_t*) calloc( sizeof(uint8_t), w * h * 3 );
+  /* the same PPM with known, unknown and without extension */
+  const char * file_names[3] = {"test_sniff.ppm", "test_sniff.img",
+                                "test_sniff"};
+  double clck;
+  oyImage_s * image = 0;
+
+  fprintf(stdout, "\n" );
+
+  image = oyImage_Create( w, h, buf_8, OY_TYPE_123_8, p_web, 0 );
+  for(k = 0; k < 3; ++k)
+    error = oyImage_PpmWrite( image, file_names[k], "test" );
+  oyImage_Release( &image );
+
+  for(k = 0; k < 3; ++k)
+  {
+    found = 0;
+    clck = oyClock();
+    for(i = 0; i < n; ++i)
+    {
+      oyConversion_s * s = oyConversion_New( 0 );
+      oyFilterNode_s * in = oyFilterNode_NewWith( "//" OY_TYPE_STD
+                                                  "/file_read.meta", 0, 0 );
+      oyOptions_s * options = oyFilterNode_OptionsGet( in, OY_SELECT_FILTER );
+
+      error = oyOptions_SetFromText( &options,
+                                     "//" OY_TYPE_STD "/file_read/filename",
+                                     file_names[k], OY_CREATE_NEW );
+      oyOptions_Release( &options );
+      error = oyConversion_Set( s, in, 0 );
+
+      image = oyConversion_GetImage( s, OY_INPUT );
+      if(image && image->width == w && image->height == h)
+        ++found;
+
+      oyImage_Release( &image );
+      oyConversion_Release( &s );
+    }
+    clck = oyClock() - clck;
+
+    if( !error && found == n )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "file_read.meta %s             %s", file_names[k],
+                          oyProfilingToString(n,clck/(double)CLOCKS_PER_SEC, "Open"));
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "file_read.meta %s %d/%d                  ", file_names[k], found, n );
+    }
+
+    remove( file_names[k] );
+  }
+
+  oyProfile_Release( &p_web );
+  free( buf_8 );
+
+  return result;
+}
+
+oyTESTRESULT_e testImagePngWrite()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, j, level, n = 2,
+      w = 1024, h = 512,
+      pixel_n = w * h;
+  uint8_t * buf_8 = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 );
+  const char * file_name = "test_png_write.png";
+  double clck;
+  size_t size = 0;
+  FILE * fp;
+
+  fprintf(stdout, "\n" );
+
+  /* a smooth gradient with some noise compresses like a photo */
+  for(i = 0; i < h; ++i)
+    for(j = 0; j < w * 3; ++j)
+      buf_8[i*w*3 + j] = (uint8_t)((i + j/3) / 6 + rand() % 8);
+
+  oyImage_s * image = oyImage_Create( w, h, buf_8, OY_TYPE_123_8, p_web, 0);
+
+  for(level = 0; level <= 9; ++level)
+  {
+    oyConversion_s * s = oyConversion_New( 0 );
+    oyFilterNode_s * in = 0, * out = 0;
+    oyOptions_s * options = 0;
+
+    in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/root", 0, 0 );
+    error = oyConversion_Set( s, in, 0 );
+    error = oyFilterNode_DataSet( in, (oyStruct_s*)image, 0, 0 );
+
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/write_png", 0, 0 );
+    options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+    error = oyOptions_SetFromText( &options,
+                                   "//" OY_TYPE_STD "/file_write/filename",
+                                   file_name, OY_CREATE_NEW );
+    error = oyOptions_SetFromInt( &options,
+                                  "//" OY_TYPE_STD "/file_write/compression",
+                                  level, 0, OY_CREATE_NEW );
+    oyOptions_Release( &options );
+    error = oyFilterNode_DataSet( out, (oyStruct_s*)image, 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    in = out;
+
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/output", 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    error = oyConversion_Set( s, 0, out );
+
+    clck = oyClock();
+    for(i = 0; i < n; ++i)
+      error = oyConversion_RunPixels( s, 0 );
+    clck = oyClock() - clck;
+
+    size = 0;
+    fp = fopen( file_name, "rb" );
+    if(fp)
+    {
+      uint8_t sig[8] = {0,0,0,0,0,0,0,0};
+      if(fread( sig, 1, 8, fp ) != 8 || memcmp( sig, "\211PNG\r\n\032\n", 8 ))
+        error = 1;
+      fseek( fp, 0, SEEK_END );
+      size = ftell( fp );
+      fclose( fp );
+    }
+
+    if( !error && size )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "PNG write level %d %.02f MB   %s", level, size / 1000000.0,
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "PNG write level %d                         ", level );
+    }
+
+    remove( file_name );
+    oyConversion_Release( &s );
+  }
+
+  oyImage_Release( &image );
+  oyProfile_Release( &p_web );
+  free( buf_8 );
+
+  return result;
+}
+
+oyTESTRESULT_e testImagePngRead()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, j, k, n = 5,
+      w = 2048, h = 1024,
+      pixel_n = w * h;
+  uint8_t * buf_8 = (uint8_t*) calloc( sizeof(uint8_t), pixel_n * 3 );
+  const char * file_name = "test_png_read.png";
+  double clck, clck_first;
+  oyImage_s * image = 0;
+  const char * modes[3] = {"sequential ","interlaced ","progressive"};
+
+  fprintf(stdout, "\n" );
+
+  for(i = 0; i < h; ++i)
+    for(j = 0; j < w * 3; ++j)
+      buf_8[i*w*3 + j] = (uint8_t)((i + j/3) / 6);
+
+  for(k = 0; k < 3; ++k)
+  {
+    oyConversion_s * s = oyConversion_New( 0 );
+    oyFilterNode_s * in = 0, * out = 0;
+    oyOptions_s * options = 0;
+    oyArray2d_s * a = 0;
+    oyRectangle_s roi = {oyOBJECT_RECTANGLE_S, 0,0,0};
+    int matches = 0;
+
+    /* write the test file */
+    image = oyImage_Create( w, h, buf_8, OY_TYPE_123_8, p_web, 0 );
+    in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/root", 0, 0 );
+    error = oyConversion_Set( s, in, 0 );
+    error = oyFilterNode_DataSet( in, (oyStruct_s*)image, 0, 0 );
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/write_png", 0, 0 );
+    options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+    error = oyOptions_SetFromText( &options,
+                                   "//" OY_TYPE_STD "/file_write/filename",
+                                   file_name, OY_CREATE_NEW );
+    error = oyOptions_SetFromInt( &options,
+                                  "//" OY_TYPE_STD "/file_write/interlace",
+                                  k > 0, 0, OY_CREATE_NEW );
+    oyOptions_Release( &options );
+    error = oyFilterNode_DataSet( out, (oyStruct_s*)image, 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    in = out;
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/output", 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    error = oyConversion_Set( s, 0, out );
+    error = oyConversion_RunPixels( s, 0 );
+    oyConversion_Release( &s );
+    oyImage_Release( &image );
+
+    clck_first = clck = 0;
+    for(i = 0; i < n; ++i)
+    {
+      double start = oyClock();
+      int height = 0, is_allocated = 0;
+
+      s = oyConversion_New( 0 );
+      in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/input_png", 0, 0 );
+      options = oyFilterNode_OptionsGet( in, OY_SELECT_FILTER );
+      error = oyOptions_SetFromText( &options,
+                                     "//" OY_TYPE_STD "/file_read/filename",
+                                     file_name, OY_CREATE_NEW );
+      error = oyOptions_SetFromInt( &options,
+                                    "//" OY_TYPE_STD "/file_read/progressive",
+                                    k == 2, 0, OY_CREATE_NEW );
+      oyOptions_Release( &options );
+      error = oyConversion_Set( s, in, 0 );
+
+      /* the first displayable line */
+      image = oyConversion_GetImage( s, OY_INPUT );
+      if(image && image->getLine( image, 0, &height, -1, &is_allocated ))
+        clck_first += oyClock() - start;
+      else
+        error = 1;
+
+      /* the remaining image; progressive files need one sweep per pass */
+      oyRectangle_SetGeo( &roi, 0,0, 1.0, (double)h/w );
+      for(j = 0; j < (k == 2 ? 7 : 1) && !error; ++j)
+        error = oyImage_FillArray( image, &roi, 1, &a, 0, 0 );
+      clck += oyClock() - start;
+
+      if(!error && a)
+        matches = memcmp( a->array2d[h-1], &buf_8[(h-1)*w*3], w*3 ) == 0 &&
+                  memcmp( a->array2d[h/2], &buf_8[(h/2)*w*3], w*3 ) == 0;
+
+      oyArray2d_Release( &a );
+      oyImage_Release( &image );
+      oyConversion_Release( &s );
+    }
+
+    if( !error && matches )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "first line %s       %s", modes[k],
+                          oyProfilingToString(n,clck_first/(double)CLOCKS_PER_SEC, "Image"));
+      PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "whole image %s      %s", modes[k],
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "PNG read %s                       ", modes[k] );
+    }
+
+    remove( file_name );
+  }
+
+  oyProfile_Release( &p_web );
+  free( buf_8 );
+
+  return result;
+}
+
+#ifdef HAVE_TIFF
+oyTESTRESULT_e testImageTiff()
+{
+  oyTESTRESULT_e result = oyTESTRESULT_UNKNOWN;
+  oyProfile_s * p_web = oyProfile_FromStd( oyASSUMED_WEB, NULL );
+  int error = 0,
+      i, j, k, n = 5,
+      w = 2000, h = 1000,
+      pixel_n = w * h;
+  uint16_t * buf_16 = (uint16_t*) calloc( sizeof(uint16_t), pixel_n * 3 );
+  const char * file_name = "test_tiff.tif";
+  double clck, clck_tile;
+  oyImage_s * image = 0;
+  const char * modes[3] = {"tiled ","planar","strips"};
+
+  fprintf(stdout, "\n" );
+
+  for(i = 0; i < h; ++i)
+    for(j = 0; j < w * 3; ++j)
+      buf_16[i*w*3 + j] = (uint16_t)((i + j/3) * 31 + j%3);
+
+  for(k = 0; k < 3; ++k)
+  {
+    oyConversion_s * s = oyConversion_New( 0 );
+    oyFilterNode_s * in = 0, * out = 0;
+    oyOptions_s * options = 0;
+    oyArray2d_s * a = 0;
+    oyRectangle_s roi = {oyOBJECT_RECTANGLE_S, 0,0,0};
+    int matches = 0;
+
+    /* write the test file */
+    image = oyImage_Create( w, h, buf_16, OY_TYPE_123_16, p_web, 0 );
+    in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/root", 0, 0 );
+    error = oyConversion_Set( s, in, 0 );
+    error = oyFilterNode_DataSet( in, (oyStruct_s*)image, 0, 0 );
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/write_tiff", 0, 0 );
+    options = oyFilterNode_OptionsGet( out, OY_SELECT_FILTER );
+    error = oyOptions_SetFromText( &options,
+                                   "//" OY_TYPE_STD "/file_write/filename",
+                                   file_name, OY_CREATE_NEW );
+    error = oyOptions_SetFromInt( &options,
+                                  "//" OY_TYPE_STD "/file_write/compression",
+                                  8, 0, OY_CREATE_NEW );
+    error = oyOptions_SetFromInt( &options,
+                                  "//" OY_TYPE_STD "/file_write/planar",
+                                  k == 1, 0, OY_CREATE_NEW );
+    error = oyOptions_SetFromInt( &options,
+                                  "//" OY_TYPE_STD "/file_write/tile_height",
+                                  k == 2 ? 0 : 256, 0, OY_CREATE_NEW );
+    oyOptions_Release( &options );
+    error = oyFilterNode_DataSet( out, (oyStruct_s*)image, 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    in = out;
+    out = oyFilterNode_NewWith( "//" OY_TYPE_STD "/output", 0, 0 );
+    error = oyFilterNode_Connect( in, "//" OY_TYPE_STD "/data",
+                                  out, "//" OY_TYPE_STD "/data", 0 );
+    error = oyConversion_Set( s, 0, out );
+    error = oyConversion_RunPixels( s, 0 );
+    oyConversion_Release( &s );
+    oyImage_Release( &image );
+
+    clck_tile = clck = 0;
+    for(i = 0; i < n; ++i)
+    {
+      double start = oyClock();
+      int is_allocated = 0, tx, ty;
+      uint16_t ** tile = 0;
+
+      s = oyConversion_New( 0 );
+      in = oyFilterNode_NewWith( "//" OY_TYPE_STD "/input_tiff", 0, 0 );
+      options = oyFilterNode_OptionsGet( in, OY_SELECT_FILTER );
+      error = oyOptions_SetFromText( &options,
+                                     "//" OY_TYPE_STD "/file_read/filename",
+                                     file_name, OY_CREATE_NEW );
+      oyOptions_Release( &options );
+      error = oyConversion_Set( s, in, 0 );
+
+      /* a single tile from the image centre */
+      image = oyConversion_GetImage( s, OY_INPUT );
+      if(image && image->getTile && image->tile_width && image->tile_height)
+      {
+        tx = w / 2 / image->tile_width;
+        ty = h / 2 / image->tile_height;
+        tile = (uint16_t**) image->getTile( image, tx, ty, -1, &is_allocated );
+        clck_tile += oyClock() - start;
+        if(!tile ||
+           memcmp( tile[0], &buf_16[(ty * image->tile_height * w +
+                                     tx * image->tile_width) * 3],
+                   (image->tile_width < w ? image->tile_width : w) * 3 *
+                   sizeof(uint16_t) ))
+          error = 1;
+      } else
+        error = 1;
+
+      /* the whole image */
+      oyRectangle_SetGeo( &roi, 0,0, 1.0, (double)h/w );
+      if(!error)
+        error = oyImage_FillArray( image, &roi, 1, &a, 0, 0 );
+      clck += oyClock() - start;
+
+      if(!error && a)
+        matches = memcmp( a->array2d[h-1], &buf_16[(h-1)*w*3],
+                          w*3*sizeof(uint16_t) ) == 0 &&
+                  memcmp( a->array2d[h/2], &buf_16[(h/2)*w*3],
+                          w*3*sizeof(uint16_t) ) == 0;
+
+      oyArray2d_Release( &a );
+      oyImage_Release( &image );
+      oyConversion_Release( &s );
+    }
+
+    if( !error && matches )
+    { PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "TIFF tile %s                %s", modes[k],
+                          oyProfilingToString(n,clck_tile/(double)CLOCKS_PER_SEC, "Tile"));
+      PRINT_SUB( oyTESTRESULT_SUCCESS,
+      "TIFF read %s                %s", modes[k],
+                          oyProfilingToString(n*pixel_n,clck/(double)CLOCKS_PER_SEC, "Pixel"));
+    } else
+    { PRINT_SUB( oyTESTRESULT_FAIL,
+      "TIFF write/read %s                ", modes[k] );
+    }
+
+    remove( file_name );
+  }
+
+  oyProfile_Release( &p_web );
+  free( buf_16 );
+
+  return result;
+}
+#endif /* HAVE_TIFF */
+
+typedef struct {
+  oyTESTRESULT_e (*oyTestRun)        ( oyTESTRESULT_e    (*test)(void),
+                                       const char        * test_name );
+  const char * title;
+} oyTestRegistration_s;
+
+oyTestRegistration_s test_registration[100];
+
+#define TEST_RUN( prog, text ) { \
+  if(argc > 1) { \
+    if(strcmp("-l", argv[1]) == 0) \
+    { \
+      printf( "%s\n", text); \
+    } else { \
+      for(i = 1; i < argc; ++i) \
+        if(strstr(text, argv[i]) != 0) \
+          oyTestRun( prog, text ); \
+    } \
+  } else \
+    oyTestRun( prog, text ); \
+}
+
+/*  main */
+int main(int argc, char** argv)
+{
+  int i, error;
+
+  if(getenv("OYRANOS_DEBUG"))
+  {
+    int value = atoi(getenv("OYRANOS_DEBUG"));
+    if(value > 0)
+      oy_debug += value;
+  }
+
+  /* init */
+  for(i = 0; i <= oyTESTRESULT_UNKNOWN; ++i)
+    results[i] = 0;
+
+  fprintf( stderr, "\nOyranos Tests v" OYRANOS_VERSION_NAME
+           "  developed: " OYRANOS_DATE  "\n   git id:" OYRANOS_GIT_MASTER
+           "  configured: " OYRANOS_CONFIG_DATE "\n\n" );
+
+
+  /* do tests */
 
   TEST_RUN( testVersion, "Version matching" );
   TEST_RUN( testI18N, "Internationalisation" );
@@ -3777,7 +6102,14 @@ int main(int argc, char** argv)
   TEST_RUN( testOptionInt,  "oyOption_s integers" );
   TEST_RUN( testOptionsSet,  "Set oyOptions_s" );
   TEST_RUN( testOptionsCopy,  "Copy oyOptions_s" );
+  TEST_RUN( testOptionsStorage,  "oyOptions_s storage" );
+  TEST_RUN( testOptionsIndex,  "oyOptions_s index" );
+  TEST_RUN( testOptionsFromText,  "oyOptions_FromText() cache" );
+  TEST_RUN( testObserverBatch,  "Observer signal batches" );
+  TEST_RUN( testArena,  "Arena allocation" );
   TEST_RUN( testBlob, "oyBlob_s" );
+  TEST_RUN( testObjectRefs, "Object reference counting" );
+  TEST_RUN( testAllocator, "Memory allocator" );
   TEST_RUN( testSettings, "default oyOptions_s settings" );
   TEST_RUN( testConfDomain, "oyConfDomain_s");
   TEST_RUN( testProfile, "Profile handling" );
@@ -3797,6 +6129,23 @@ int main(int argc, char** argv)
   TEST_RUN( testCMMsShow, "CMMs show" );
   TEST_RUN( testCMMnmRun, "CMM named colour run" );
   TEST_RUN( testImagePixel, "CMM Image Pixel run" );
+  TEST_RUN( testThreadedPixels, "Threaded conversions" );
+  TEST_RUN( testImageAlpha, "CMM Image Alpha run" );
+  TEST_RUN( testImageDither, "CMM Image Dither run" );
+  TEST_RUN( testImageScale, "CMM Image Scale run" );
+  TEST_RUN( testImageDisplayDamage, "Display damage regions" );
+  TEST_RUN( testImagePyramid, "Image Pyramid cache" );
+  TEST_RUN( testImageTiles, "Image tiles" );
+  TEST_RUN( testImageMapped, "Image mapped" );
+  TEST_RUN( testImagePpmWrite, "PPM write" );
+  TEST_RUN( testImagePpmWriteStrips, "PPM write in strips" );
+  TEST_RUN( testImagePpmRead, "PPM read" );
+  TEST_RUN( testImageFileSniff, "File format sniffing" );
+  TEST_RUN( testImagePngWrite, "PNG write" );
+  TEST_RUN( testImagePngRead, "PNG read" );
+#ifdef HAVE_TIFF
+  TEST_RUN( testImageTiff, "TIFF write/read" );
+#endif
 
   /* give a summary */
   if(!(argc > 1 &&  
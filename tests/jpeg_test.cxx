@@ -0,0 +1,16 @@
+#include <stdio.h>
+extern "C" {
+#include <jpeglib.h>
+}
+
+int main(void)
+{
+  struct jpeg_decompress_struct cinfo;
+  struct jpeg_error_mgr jerr;
+
+  cinfo.err = jpeg_std_error( &jerr );
+  jpeg_create_decompress( &cinfo );
+  jpeg_destroy_decompress( &cinfo );
+  printf("JPEG	%d\n", JPEG_LIB_VERSION);
+  return 0;
+}